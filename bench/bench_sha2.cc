@@ -0,0 +1,312 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <sha2/sha256.h>
+#include <sha2/tagged_sha256.h>
+#include "sha256_internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Every benchmark is run once for each backend supported by the host, and once
+ * more through the public entry points using the auto-detected backend. */
+static const size_t AUTO = (size_t)-1;
+
+static const size_t MAX_UPDATE_BYTES = 64 << 20;
+static const size_t MAX_DOUBLE64_BLOCKS = 1 << 20;
+static const size_t MAX_MIDSTATE_BLOCKS = 1 << 16;
+static const size_t MAX_MERKLE_LEAVES = 1 << 16;
+static const size_t MAX_PBKDF2_LANES = 64;
+static const size_t PBKDF2_ITERATIONS = 1000;
+static const size_t MAX_HEADERS = 1 << 12;
+static const size_t GRIND_NONCES = 1 << 16;
+static const size_t BATCH_MESSAGES = 4096;
+
+/** Read a cycle counter: the TSC on x86, or otherwise an estimate from the
+ * wall clock and the nominal frequency measured by the benchmark library. */
+static uint64_t cycles()
+{
+#if defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        static const double hz = benchmark::CPUInfo::Get().cycles_per_second;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        return (uint64_t)(ns * (hz / 1e9));
+#endif
+}
+
+static const unsigned char* test_data(size_t bytes)
+{
+        static std::vector<unsigned char> data;
+        if (data.size() < bytes) {
+                data.resize(bytes);
+                for (size_t i = 0; i < data.size(); ++i) {
+                        data[i] = (unsigned char)(i * 7 + 1);
+                }
+        }
+        return data.data();
+}
+
+/** Report throughput in GB/s ("GB") and hashes/s ("hashes"), and the cost in
+ * cycles/byte. */
+static void set_counters(benchmark::State& state, size_t bytes, size_t hashes, uint64_t elapsed)
+{
+        double total = (double)bytes * state.iterations();
+        state.SetBytesProcessed((int64_t)total);
+        state.counters["GB"] = benchmark::Counter(total / 1e9, benchmark::Counter::kIsRate);
+        state.counters["hashes"] = benchmark::Counter((double)hashes * state.iterations(), benchmark::Counter::kIsRate);
+        state.counters["cycles/byte"] = total ? elapsed / total : 0;
+}
+
+static void bench_update(benchmark::State& state, size_t backend)
+{
+        size_t len = (size_t)state.range(0);
+        const unsigned char* data = test_data(len);
+        struct sha256 hash;
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                struct sha256_ctx ctx = SHA256_INIT;
+                if (backend == AUTO) {
+                        sha256_update(&ctx, data, len);
+                        sha256_done(&hash, &ctx);
+                } else {
+                        sha256_update_backend(backend, &ctx, data, len);
+                        sha256_done_backend(backend, &hash, &ctx);
+                }
+                benchmark::DoNotOptimize(hash);
+        }
+        set_counters(state, len, 1, cycles() - start);
+}
+
+static void bench_double64(benchmark::State& state, size_t backend)
+{
+        size_t blocks = (size_t)state.range(0);
+        const struct sha256* in = (const struct sha256*)test_data(64 * blocks);
+        std::vector<struct sha256> out(blocks);
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        sha256_double64(out.data(), in, blocks);
+                } else {
+                        sha256_double64_backend(backend, out.data(), in, blocks);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 64 * blocks, blocks, cycles() - start);
+}
+
+static void bench_double64_meets_target(benchmark::State& state, size_t backend)
+{
+        size_t blocks = (size_t)state.range(0);
+        const struct sha256* in = (const struct sha256*)test_data(64 * blocks);
+        std::vector<unsigned char> bitmap((blocks + 7) / 8);
+        /* A target which no hash meets, as is almost always the case when
+         * checking proof of work. */
+        struct sha256 target = {};
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        sha256_double64_meets_target(bitmap.data(), in, blocks, &target);
+                } else {
+                        sha256_double64_meets_target_backend(backend, bitmap.data(), in, blocks, &target);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 64 * blocks, blocks, cycles() - start);
+}
+
+static void bench_midstate(benchmark::State& state, size_t backend)
+{
+        size_t blocks = (size_t)state.range(0);
+        const unsigned char* in = test_data(64 * blocks);
+        std::vector<struct sha256> out(blocks);
+        struct sha256_ctx ctx = SHA256_INIT;
+        sha256_update(&ctx, in, 64);
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        sha256_midstate(out.data(), ctx.s, in, blocks);
+                } else {
+                        sha256_midstate_backend(backend, out.data(), ctx.s, in, blocks);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 64 * blocks, blocks, cycles() - start);
+}
+
+static void bench_merkle_root(benchmark::State& state, size_t backend)
+{
+        size_t count = (size_t)state.range(0);
+        const struct sha256* leaves = (const struct sha256*)test_data(32 * count);
+        std::vector<struct sha256> hashes(count);
+        struct sha256 root;
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                std::copy(leaves, leaves + count, hashes.begin());
+                if (backend == AUTO) {
+                        sha256_merkle_root(&root, hashes.data(), count);
+                } else {
+                        sha256_merkle_root_backend(backend, &root, hashes.data(), count);
+                }
+                benchmark::DoNotOptimize(root);
+        }
+        /* A tree of n leaves has n - 1 inner nodes. */
+        set_counters(state, 32 * count, count - 1, cycles() - start);
+}
+
+static void bench_pbkdf2(benchmark::State& state, size_t backend)
+{
+        size_t count = (size_t)state.range(0);
+        const uint32_t* midstates = (const uint32_t*)test_data(64 * count);
+        std::vector<uint32_t> f(8 * count), u(8 * count);
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        sha256_pbkdf2_iterate(f.data(), u.data(), midstates, midstates + 8 * count, count, PBKDF2_ITERATIONS);
+                } else {
+                        sha256_pbkdf2_iterate_backend(backend, f.data(), u.data(), midstates, midstates + 8 * count, count, PBKDF2_ITERATIONS);
+                }
+                benchmark::ClobberMemory();
+        }
+        /* Each iteration is two compressions of one 64-byte block. */
+        set_counters(state, 128 * PBKDF2_ITERATIONS * count, 2 * PBKDF2_ITERATIONS * count, cycles() - start);
+}
+
+static void bench_check_headers(benchmark::State& state, size_t backend)
+{
+        size_t count = (size_t)state.range(0);
+        const unsigned char* headers = test_data(80 * count);
+        std::vector<unsigned char> bitmap((count + 7) / 8);
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        sha256_check_headers(bitmap.data(), NULL, headers, count);
+                } else {
+                        sha256_check_headers_backend(backend, bitmap.data(), NULL, headers, count);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 80 * count, count, cycles() - start);
+}
+
+static void bench_grind(benchmark::State& state, size_t backend)
+{
+        int twice = (int)state.range(0);
+        const unsigned char* tail = test_data(64);
+        const uint32_t midstate[8] = { 0 };
+        struct sha256 target = {};
+        uint32_t nonce;
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                /* A target which no hash meets, so that every nonce is tried. */
+                if (backend == AUTO) {
+                        sha256_grind(&nonce, 1, midstate, tail, 12, 0, GRIND_NONCES, &target, twice);
+                } else {
+                        sha256_grind_backend(backend, &nonce, 1, midstate, tail, 12, 0, GRIND_NONCES, &target, twice);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 64 * GRIND_NONCES, GRIND_NONCES, cycles() - start);
+}
+
+/* Double SHA256 messages of the given length, or if it is zero, of mixed
+ * lengths typical of transactions, from 60 bytes to a few kilobytes. */
+static void bench_double_batch(benchmark::State& state)
+{
+        size_t len = (size_t)state.range(0), bytes = 0;
+        const unsigned char* data = test_data(4096 + 64);
+        std::vector<const void*> ptrs(BATCH_MESSAGES);
+        std::vector<size_t> lens(BATCH_MESSAGES);
+        std::vector<struct sha256> out(BATCH_MESSAGES);
+        for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+                ptrs[i] = data + i % 64;
+                lens[i] = len ? len : i % 16 ? 60 + (i * 53) % 500 : 1000 + (i * 211) % 3000;
+                bytes += lens[i];
+        }
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                sha256_double_batch(out.data(), ptrs.data(), lens.data(), BATCH_MESSAGES);
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, bytes, BATCH_MESSAGES, cycles() - start);
+}
+
+static void bench_tagged64(benchmark::State& state, size_t backend)
+{
+        size_t count = (size_t)state.range(0);
+        const unsigned char* in = test_data(64 * count);
+        std::vector<struct sha256> out(count);
+        uint64_t start = cycles();
+        for (auto _ : state) {
+                if (backend == AUTO) {
+                        tagged_sha256_batch64(out.data(), &tagged_sha256_tapbranch, in, count);
+                } else {
+                        sha256_midstate_final64_backend(backend, out.data(), tagged_sha256_tapbranch.s, in, count);
+                }
+                benchmark::ClobberMemory();
+        }
+        set_counters(state, 64 * count, count, cycles() - start);
+}
+
+static void register_backend(size_t backend, const std::string& id)
+{
+        benchmark::RegisterBenchmark(("update/" + id).c_str(), bench_update, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_UPDATE_BYTES);
+        benchmark::RegisterBenchmark(("double64/" + id).c_str(), bench_double64, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_DOUBLE64_BLOCKS);
+        benchmark::RegisterBenchmark(("double64_meets_target/" + id).c_str(), bench_double64_meets_target, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_DOUBLE64_BLOCKS);
+        benchmark::RegisterBenchmark(("midstate/" + id).c_str(), bench_midstate, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_MIDSTATE_BLOCKS);
+        benchmark::RegisterBenchmark(("merkle_root/" + id).c_str(), bench_merkle_root, backend)
+                ->RangeMultiplier(8)->Range(8, MAX_MERKLE_LEAVES)->Arg(2000)->Arg(2001);
+        benchmark::RegisterBenchmark(("pbkdf2/" + id).c_str(), bench_pbkdf2, backend)
+                ->RangeMultiplier(2)->Range(1, MAX_PBKDF2_LANES);
+        benchmark::RegisterBenchmark(("check_headers/" + id).c_str(), bench_check_headers, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_HEADERS);
+        benchmark::RegisterBenchmark(("grind/" + id).c_str(), bench_grind, backend)
+                ->Arg(0)->Arg(1);
+        benchmark::RegisterBenchmark(("tagged64/" + id).c_str(), bench_tagged64, backend)
+                ->RangeMultiplier(8)->Range(1, MAX_MIDSTATE_BLOCKS);
+        /* The multi-buffer manager always uses the auto-detected backend. */
+        if (backend == AUTO) {
+                benchmark::RegisterBenchmark("double_batch/auto", bench_double_batch)
+                        ->Arg(0)->Arg(64)->Arg(250)->Arg(1000);
+        }
+}
+
+int main(int argc, char **argv)
+{
+        benchmark::AddCustomContext("sha256_auto_detect", sha256_auto_detect());
+        register_backend(AUTO, "auto");
+        for (size_t i = 0; i < sha256_backend_count(); ++i) {
+                if (sha256_backend_supported(i)) {
+                        register_backend(i, sha256_backend_id(i));
+                }
+        }
+
+        benchmark::Initialize(&argc, argv);
+        if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+                return 1;
+        }
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+
+        return 0;
+}
+
+/* End of File
+ */
@@ -0,0 +1,149 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SHA2__HMAC_SHA256_H
+#define SHA2__HMAC_SHA256_H
+
+#include <sha2/sha256.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h> /* for uint32_t */
+#include <stdlib.h> /* for size_t */
+
+/**
+ * @brief A precomputed HMAC-SHA256 key.
+ *
+ * @inner: the SHA256 state after hashing the key XOR ipad
+ * @outer: the SHA256 state after hashing the key XOR opad
+ *
+ * Every HMAC begins by hashing one block derived from the key for the inner
+ * hash, and another for the outer hash.  Both are hashed once, when the key is
+ * initialized, and only the resulting midstates are kept, so that each MAC
+ * costs just the compressions of the message plus one for the outer hash.
+ * The key itself is not retained, but the midstates are as sensitive as the
+ * key and should be handled with the same care.
+ */
+struct hmac_sha256_key {
+        uint32_t inner[8];
+        uint32_t outer[8];
+};
+
+/**
+ * @brief A structure for storing the running context of an HMAC-SHA256.
+ *
+ * @inner: the running context of the inner hash
+ * @outer: the outer midstate of the key
+ */
+struct hmac_sha256_ctx {
+        struct sha256_ctx inner;
+        uint32_t outer[8];
+};
+
+/**
+ * @brief Precompute an HMAC-SHA256 key.
+ *
+ * @param key the key object to initialize
+ * @param secret the secret key bytes
+ * @param len the number of bytes pointed to by \p secret
+ *
+ * Keys longer than 64 bytes are first hashed, as specified by RFC 2104.  The
+ * key object may be reused for any number of MACs, from any number of threads.
+ *
+ * Example:
+ * static void sign(const struct hmac_sha256_key* key, const char* msg, size_t len, struct sha256* mac)
+ * {
+ *         hmac_sha256(mac, key, msg, len);
+ * }
+ */
+void hmac_sha256_key_init(struct hmac_sha256_key* key, const void* secret, size_t len);
+
+/**
+ * @brief Begin computing an HMAC-SHA256 under a precomputed key.
+ *
+ * @param ctx the context to initialize
+ * @param key the precomputed key
+ *
+ * Message data is added with hmac_sha256_update() and the MAC is returned by
+ * hmac_sha256_done().  No compressions are performed by this call.
+ */
+void hmac_sha256_init(struct hmac_sha256_ctx* ctx, const struct hmac_sha256_key* key);
+
+/**
+ * @brief Add some data from memory to the MAC.
+ *
+ * @param ctx the hmac_sha256_ctx to use
+ * @param data a pointer to data in memory
+ * @param len the number of bytes pointed to by \p data
+ */
+void hmac_sha256_update(struct hmac_sha256_ctx* ctx, const void* data, size_t len);
+
+/**
+ * @brief Finalize an HMAC-SHA256 and return the resulting MAC.
+ *
+ * @param mac the MAC to return
+ * @param ctx the hmac_sha256_ctx to finalize
+ *
+ * The outer hash takes exactly one compression.  As with sha256_done(), the
+ * context is used up by this call.
+ */
+void hmac_sha256_done(struct sha256* mac, struct hmac_sha256_ctx* ctx);
+
+/**
+ * @brief Compute the HMAC-SHA256 of a message in one call.
+ *
+ * @param mac the MAC to return
+ * @param key the precomputed key
+ * @param data a pointer to the message
+ * @param len the number of bytes pointed to by \p data
+ *
+ * Messages of up to 55 bytes fit in a single block with their padding, and
+ * are MACed with exactly two compressions, one each for the inner and outer
+ * hashes.  Longer messages take the same path as hmac_sha256_init(),
+ * hmac_sha256_update() and hmac_sha256_done().
+ */
+void hmac_sha256(struct sha256* mac, const struct hmac_sha256_key* key, const void* data, size_t len);
+
+/**
+ * @brief Compute the HMAC-SHA256 of many messages at once.
+ *
+ * @param macs an array of count MACs to return
+ * @param keys an array of count pointers to precomputed keys
+ * @param data an array of count pointers to messages
+ * @param lens an array of count message lengths
+ * @param count the number of messages
+ *
+ * Message i is MACed under the key keys[i], and any number of the entries of
+ * \p keys may point to the same key.  The messages are hashed in the lanes of
+ * a multi-buffer manager (see sha256_mb_init()), starting each lane from the
+ * midstate of its key, and each inner hash is fed back into a lane for the
+ * outer hash as soon as it is finished, so the lanes are kept full until the
+ * last few messages.  Where the selected backend has no multi-lane kernels
+ * the messages are processed one at a time.
+ *
+ * Example:
+ * static void verify_tokens(const struct hmac_sha256_key* key, const char* const tokens[], const size_t lens[], struct sha256 macs[], size_t n)
+ * {
+ *         const struct hmac_sha256_key* keys[64];
+ *         size_t i;
+ *         for (i = 0; i < n; ++i)
+ *                 keys[i] = key;
+ *         hmac_sha256_batch(macs, keys, (const void* const*)tokens, lens, n);
+ * }
+ */
+void hmac_sha256_batch(struct sha256 macs[], const struct hmac_sha256_key* const keys[], const void* const data[], const size_t lens[], size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2__HMAC_SHA256_H */
+
+/* End of File
+ */
@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SHA2__PBKDF2_SHA256_H
+#define SHA2__PBKDF2_SHA256_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h> /* for size_t */
+
+/**
+ * @brief Derive a key from a password with PBKDF2-HMAC-SHA256.
+ *
+ * @param out the derived key to return
+ * @param outlen the number of bytes of key to derive
+ * @param password a pointer to the password
+ * @param passlen the number of bytes pointed to by \p password
+ * @param salt a pointer to the salt
+ * @param saltlen the number of bytes pointed to by \p salt
+ * @param iterations the iteration count, which must be at least 1
+ *
+ * This is PBKDF2 as specified by RFC 8018, with HMAC-SHA256 as the
+ * pseudorandom function.  Each iteration is two compressions of a block of
+ * fixed format from the midstates of the password, which are run by dedicated
+ * kernels.  A key longer than 32 bytes is derived in several independent
+ * 32-byte blocks, which are computed in parallel lanes where the selected
+ * backend has multi-lane kernels.
+ *
+ * Example:
+ * static void derive(unsigned char key[32], const char* password, const unsigned char salt[16])
+ * {
+ *         pbkdf2_hmac_sha256(key, 32, password, strlen(password), salt, 16, 600000);
+ * }
+ */
+void pbkdf2_hmac_sha256(unsigned char* out, size_t outlen, const void* password, size_t passlen, const void* salt, size_t saltlen, size_t iterations);
+
+/**
+ * @brief Derive keys from many passwords at once with PBKDF2-HMAC-SHA256.
+ *
+ * @param out an array of count pointers to the derived keys to return
+ * @param outlen the number of bytes of each key to derive
+ * @param passwords an array of count pointers to passwords
+ * @param passlens an array of count password lengths
+ * @param salts an array of count pointers to salts
+ * @param saltlens an array of count salt lengths
+ * @param count the number of keys to derive
+ * @param iterations the iteration count, which must be at least 1
+ *
+ * The same as calling pbkdf2_hmac_sha256() for each password in turn, except
+ * that the derivations run side by side in the lanes of the multi-lane
+ * kernels, so a batch of as many passwords as the selected backend has lanes
+ * takes little longer than a single one.
+ */
+void pbkdf2_hmac_sha256_batch(unsigned char* const out[], size_t outlen, const void* const passwords[], const size_t passlens[], const void* const salts[], const size_t saltlens[], size_t count, size_t iterations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2__PBKDF2_SHA256_H */
+
+/* End of File
+ */
@@ -28,10 +28,17 @@ extern "C" {
  * implementation to use.  A pointer to an internal buffer is returned to the
  * caller, containing a string naming the algorithms selected.
  *
- * This API is automatically called the first time a hash update is performed,
- * however it is not thread safe.  To query capabilities in a thread-safe way,
- * and to report the selected algorithm to the user, please call this function
- * during program initialization.
+ * Detection is performed only once, either by this function or automatically
+ * by the first hashing call, and is thread safe.  This function may be called
+ * any number of times and always returns the same string.
+ *
+ * On ELF platforms using the GNU C library, sha256_update(), sha256_done(),
+ * sha256_double64() and sha256_midstate() are instead bound directly to an
+ * implementation specialised for the selected backend by the dynamic loader,
+ * so that calling them carries no dispatch overhead at all.
+ *
+ * Other backends supported by the host remain available through
+ * sha256_backend_functions().
  */
 const char* sha256_auto_detect(void);
 
@@ -164,7 +171,7 @@ void sha256_done(struct sha256* hash, struct sha256_ctx* ctx);
  * because of various optimizations that are available due to the fixed format
  * of the input, this only requires about 2.32x more computation compared with a
  * single round of SHA256. In addition, various multi-lane optimizations are
- * available allowing for up to 8 hashes to be performed simultaneously on some
+ * available allowing for up to 16 hashes to be performed simultaneously on some
  * architectures.
  *
  * The origin of this primitive is in how Bitcoin and related projects construct
@@ -175,6 +182,125 @@ void sha256_done(struct sha256* hash, struct sha256_ctx* ctx);
  */
 void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t blocks);
 
+/**
+ * @brief Check many double-SHA256 hashes of 64-byte blocks against a target
+ *
+ * @param bitmap an array of (blocks + 7) / 8 bytes in which to return the result
+ * @param in an array of 2*blocks sha256 hash values
+ * @param blocks the number of double-SHA256 hash operations to perform
+ * @param target the target, as a 256-bit little-endian number
+ *
+ * @return size_t the number of hashes which meet the target
+ *
+ * Bit i % 8 of bitmap[i / 8] is set if the hash sha256_double64() would
+ * compute from in[2*i] and in[2*i+1], read as a 256-bit little-endian number
+ * as Bitcoin does, is no greater than target, and cleared otherwise.
+ *
+ * Where the selected backend has early-exit kernels, the hashes are not
+ * computed in full: the last three rounds of the final compression do not
+ * change the last word of the state, which holds the most significant bits of
+ * the hash, so the kernels stop before them and compare that word alone.  Only
+ * the rare blocks which pass are hashed again in full and compared with the
+ * whole target.
+ */
+size_t sha256_double64_meets_target(unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target);
+
+/**
+ * @brief Double-SHA256 many messages of any length
+ *
+ * @param out an array of count sha256 hash values to return
+ * @param data an array of count pointers to messages
+ * @param lens an array of count message lengths, in bytes
+ * @param count the number of messages
+ *
+ * out[i] is set to SHA256(SHA256(data[i])), which is how Bitcoin computes the
+ * txid and wtxid of a serialized transaction.  The first hashes run side by
+ * side in the lanes of the multi-buffer kernels (see sha256_mb_submit()), with
+ * each lane taking the next message as soon as its last one is finished, so
+ * messages of very different lengths are hashed about as fast as messages of
+ * the same length.  The second hashes are all of 32-byte messages, and are
+ * computed afterwards by fixed-format kernels like those of sha256_double64().
+ *
+ * Example:
+ * static void txids(struct sha256 out[], const unsigned char* const txs[], const size_t lens[], size_t count)
+ * {
+ *         sha256_double_batch(out, (const void* const*)txs, lens, count);
+ * }
+ */
+void sha256_double_batch(struct sha256 out[], const void* const data[], const size_t lens[], size_t count);
+
+/**
+ * @brief Compute the root of a Bitcoin-style Merkle tree
+ *
+ * @param root the resulting Merkle root
+ * @param hashes an array of count leaf hashes, which is overwritten
+ * @param count the number of leaves
+ *
+ * Each level of the tree is formed by hashing adjacent pairs of the level
+ * below with sha256_double64(), pairing the last hash of a level with itself if
+ * the level has an odd number of hashes, until a single hash remains.  The
+ * root of a tree with no leaves is all zeros, and that of a tree with one leaf
+ * is the leaf itself.
+ *
+ * The tree is reduced within the caller's array, so no memory is allocated,
+ * but the leaf hashes are destroyed.  Hashing of each level begins as soon as
+ * its inputs are available, so the multi-lane kernels are kept full even as
+ * the levels become small.
+ */
+void sha256_merkle_root(struct sha256* root, struct sha256 hashes[], size_t count);
+
+/**
+ * @brief Compute the root of a Bitcoin-style Merkle tree, detecting mutation
+ *
+ * @param root the resulting Merkle root
+ * @param hashes an array of count leaf hashes, which is overwritten
+ * @param count the number of leaves
+ *
+ * @return int non-zero if the tree may have been mutated, zero otherwise
+ *
+ * As sha256_merkle_root(), but also checks whether any pair of hashes which are
+ * hashed together at any level of the tree are identical.  Because the last
+ * hash of an odd-length level is paired with itself, a list of leaves can be
+ * extended by duplicating a trailing subtree without changing the root
+ * (CVE-2012-2459).  A non-zero result means that this list of leaves either
+ * was so extended or has a root which collides with one that was.
+ */
+int sha256_merkle_root_mutated(struct sha256* root, struct sha256 hashes[], size_t count);
+
+/**
+ * @brief Check the proof of work of many Bitcoin block headers
+ *
+ * @param bitmap an array of (count + 7) / 8 bytes in which to return the result
+ * @param hashes an array of count block hashes to return, or NULL
+ * @param headers an array of count serialized 80-byte block headers
+ * @param count the number of headers
+ *
+ * @return size_t the number of headers which meet their target
+ *
+ * Each header is hashed with double SHA256, and the hash, read as a 256-bit
+ * little-endian number, is compared with the target encoded in the header's
+ * own nBits field.  Bit i % 8 of bitmap[i / 8] is set if header i meets its
+ * target, and cleared otherwise.  A header whose nBits encodes a negative,
+ * zero, or overflowing target never does.  Whether nBits itself is acceptable
+ * under the network's rules, such as its proof-of-work limit and difficulty
+ * adjustment, is left to the caller.
+ *
+ * The headers are read in place and hashed in the lanes of dedicated kernels,
+ * in which the padding of the last 16 bytes of each header and of the 32-byte
+ * intermediate hash are folded into the message schedule.  If hashes is NULL,
+ * the early-exit kernels of sha256_double64_meets_target() are used where
+ * available, so that only the headers which may meet their target are hashed
+ * in full.
+ *
+ * Example:
+ * static int all_valid(const unsigned char headers[][80], size_t count)
+ * {
+ *         unsigned char bitmap[256];
+ *         return count <= 2048 && sha256_check_headers(bitmap, NULL, headers[0], count) == count;
+ * }
+ */
+size_t sha256_check_headers(unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count);
+
 /**
  * @brief Performs multiple SHA256 compression rounds in parallel using the same
  * initial state vector but differing data blocks
@@ -191,13 +317,17 @@ void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t block
  * midstate vector and then attempting multiple final compression rounds in
  * parallel.
  *
- * For maximum performance blocks should be a multiple of 8, as that is the
- * highest degree of parallelism on any presently supported architecture.
+ * For maximum performance blocks should be a multiple of 16, as that is the
+ * highest degree of parallelism on any presently supported architecture
+ * (AVX-512).
  *
  * Note that the midstate is delivered as host-ordered unsigned integers, the
  * same as sha256_ctx.s, but the output is a standard SHA256 network-ordered
  * hash.
  *
+ * To search a range of nonces for a hash which meets a target, use
+ * sha256_grind() instead, which generates the blocks itself.
+ *
  * Example:
  * void sha256_write_and_finalize8(struct sha256_ctx* ctx, const unsigned char nonce1[4], const unsigned char nonce2[4], const unsigned char final[4], struct sha256 hashes[8])
  * {
@@ -215,6 +345,381 @@ void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t block
  */
 void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks);
 
+/**
+ * @brief Search a range of nonces for hashes which meet a target
+ *
+ * @param nonces an array in which to return the nonces found
+ * @param max_nonces the number of entries of \p nonces
+ * @param midstate the state after all but the last block of the message
+ * @param tail the last block of the message, including its padding
+ * @param nonce_offset the offset within \p tail of a 4-byte little-endian nonce, which must be a multiple of 4
+ * @param start the first nonce to try
+ * @param count the number of nonces to try, which wrap around after 0xffffffff
+ * @param target the target, read as a little-endian number
+ * @param twice non-zero to hash the result again as a 32-byte message, as Bitcoin does
+ *
+ * @return size_t the number of nonces found, which stops at \p max_nonces
+ *
+ * Each nonce in turn is written into the tail block, which is hashed from the
+ * midstate, and if twice is set the result is hashed again with
+ * sha256_double64()-style padding.  The nonces for which the final hash, read
+ * as a 256-bit little-endian number as Bitcoin does, is no greater than the
+ * target are returned in order.  The contents of \p tail at the nonce offset
+ * are ignored.
+ *
+ * This is much faster than preparing blocks for sha256_midstate().  The nonces
+ * are generated within the vector registers of the multi-lane kernels, the
+ * rounds before the nonce is first read are computed once for the whole
+ * search, as are the message schedule words which do not depend on it, and
+ * the hash of each lane is only completed if the most significant word of the
+ * result, which is known three rounds before the end, passes the target.
+ *
+ * Example:
+ * static int mine(unsigned char header[80], const struct sha256* target)
+ * {
+ *         struct sha256_ctx ctx = SHA256_INIT;
+ *         unsigned char tail[64] = { 0 };
+ *         uint32_t nonce;
+ *         sha256_update(&ctx, header, 64);
+ *         memcpy(tail, header + 64, 16);
+ *         tail[16] = 0x80;
+ *         tail[62] = 0x02;
+ *         tail[63] = 0x80;
+ *         if (!sha256_grind(&nonce, 1, ctx.s, tail, 12, 0, 1ull << 32, target, 1))
+ *                 return 0;
+ *         WriteLE32(header + 76, nonce);
+ *         return 1;
+ * }
+ */
+size_t sha256_grind(uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice);
+
+/**
+ * @brief The maximum number of lanes used by any multi-buffer backend.
+ */
+#define SHA256_MB_MAX_LANES 16
+
+/**
+ * @brief A hashing job submitted to a multi-buffer manager.
+ *
+ * @data: the message to be hashed
+ * @len: the length of the message, in bytes
+ * @hash: the completed hash, written when the job is returned
+ * @user_data: an opaque pointer for the caller's use, which is not touched
+ *
+ * The job structure and the data it points to are owned by the manager from
+ * the time the job is submitted until it is returned by either
+ * sha256_mb_submit() or sha256_mb_flush(), and must remain valid and unchanged
+ * for that period.
+ */
+struct sha256_mb_job {
+        const void* data;
+        size_t len;
+        struct sha256 hash;
+        void* user_data;
+};
+
+/**
+ * @brief A multi-buffer hashing manager.
+ *
+ * @s: the per-lane hash states, transposed such that word i of lane j is
+ *     stored at s[i*lanes + j]
+ * @ptr: the next block to be hashed in each lane
+ * @blocks: the number of blocks remaining at ptr in each lane
+ * @job: the job occupying each lane, or NULL if the lane is idle
+ * @tail: the final, padded one or two blocks of each lane's message
+ * @tail_blocks: the number of blocks in tail still to be hashed, or zero if
+ *     the lane has already moved on to its tail
+ * @lanes: the number of lanes used by the selected backend
+ * @busy: the number of lanes with a job in flight
+ *
+ * The manager holds one independent message per lane and hashes all lanes
+ * together using the widest multi-buffer kernel available, such that many
+ * short- to medium-length messages may be hashed at close to the throughput
+ * of the vector units.  The structure contains no dynamically allocated
+ * data, and its fields should be considered private.
+ */
+struct sha256_mb_mgr {
+        uint32_t s[8 * SHA256_MB_MAX_LANES];
+        const unsigned char* ptr[SHA256_MB_MAX_LANES];
+        size_t blocks[SHA256_MB_MAX_LANES];
+        struct sha256_mb_job* job[SHA256_MB_MAX_LANES];
+        unsigned char tail[SHA256_MB_MAX_LANES][128];
+        unsigned char tail_blocks[SHA256_MB_MAX_LANES];
+        unsigned lanes;
+        unsigned busy;
+};
+
+/**
+ * @brief Initializes a multi-buffer manager.
+ *
+ * @param mgr the manager to initialize
+ *
+ * The number of lanes is fixed at initialization time from the backend chosen
+ * by sha256_auto_detect(), which should therefore be called first.  Any jobs
+ * which were in flight in a previously used manager are forgotten.
+ */
+void sha256_mb_init(struct sha256_mb_mgr* mgr);
+
+/**
+ * @brief Submit a job to a multi-buffer manager.
+ *
+ * @param mgr the multi-buffer manager
+ * @param job the job to submit
+ *
+ * @return struct sha256_mb_job* a completed job, or NULL
+ *
+ * The job is assigned to an idle lane.  If that leaves no lanes idle, the
+ * manager hashes all lanes until at least one job is finished, and returns it
+ * with its hash field set.  Otherwise NULL is returned, and the hashing is
+ * deferred until more jobs are submitted or the manager is flushed.  Jobs are
+ * not necessarily returned in the order they were submitted.
+ */
+struct sha256_mb_job* sha256_mb_submit(struct sha256_mb_mgr* mgr, struct sha256_mb_job* job);
+
+/**
+ * @brief Submit a job which continues a hash from a midstate.
+ *
+ * @param mgr the multi-buffer manager
+ * @param job the job to submit
+ * @param midstate the state to start from (e.g. sha256_ctx.s)
+ * @param offset the number of bytes already hashed into \p midstate, which
+ * must be a multiple of 64
+ *
+ * @return struct sha256_mb_job* a completed job, or NULL
+ *
+ * This is the same as sha256_mb_submit(), except that the job's data is
+ * treated as following \p offset bytes of some prefix whose hash state is
+ * \p midstate, for example the key block of an HMAC.
+ */
+struct sha256_mb_job* sha256_mb_submit_midstate(struct sha256_mb_mgr* mgr, struct sha256_mb_job* job, const uint32_t midstate[8], uint64_t offset);
+
+/**
+ * @brief Finish the next job in a multi-buffer manager.
+ *
+ * @param mgr the multi-buffer manager
+ *
+ * @return struct sha256_mb_job* a completed job, or NULL if none are in flight
+ *
+ * Hashes the jobs in flight until one of them is finished, and returns it with
+ * its hash field set.  Call repeatedly until NULL is returned to drain the
+ * manager.
+ *
+ * Example:
+ * static void hash_many(struct sha256_mb_job jobs[], size_t n)
+ * {
+ *         struct sha256_mb_mgr mgr;
+ *         size_t i;
+ *         sha256_mb_init(&mgr);
+ *         for (i = 0; i < n; ++i)
+ *                 sha256_mb_submit(&mgr, &jobs[i]);
+ *         while (sha256_mb_flush(&mgr))
+ *                 ;
+ * }
+ */
+struct sha256_mb_job* sha256_mb_flush(struct sha256_mb_mgr* mgr);
+
+/**
+ * @brief The number of backends compiled into the library.
+ *
+ * @return size_t the number of backends
+ *
+ * Backends are numbered from zero to sha256_backend_count() - 1, in increasing
+ * order of the preference of sha256_auto_detect().  Each one is a fixed set of
+ * kernels, and not every backend is supported by every host.  The numbering
+ * depends on how the library was built, so backends should be named by their
+ * identifiers (see sha256_backend_find()) in configuration.
+ *
+ * The "vec" backend has 4- and 8-way kernels written with the generic vector
+ * extension of GCC and Clang, for targets without kernels of their own.  On
+ * x86-64 it ranks below "sse4", and when the library is built for AVX2 it is
+ * supported only where AVX2 is, so sha256_auto_detect() selects it only on
+ * CPUs without SSE4.1, and never in an AVX2 build.  It can still be used
+ * through sha256_backend_functions().
+ */
+size_t sha256_backend_count(void);
+
+/**
+ * @brief The short identifier of a backend, such as "avx2".
+ *
+ * @param backend the number of a backend
+ *
+ * @return const char* the identifier, which is a static string
+ */
+const char* sha256_backend_id(size_t backend);
+
+/**
+ * @brief Whether the host supports a backend.
+ *
+ * @param backend the number of a backend
+ *
+ * @return int nonzero if the host supports every instruction the backend uses
+ */
+int sha256_backend_supported(size_t backend);
+
+/**
+ * @brief Find a backend by its identifier.
+ *
+ * @param id the identifier, as returned by sha256_backend_id()
+ *
+ * @return size_t the number of the backend, or sha256_backend_count() if no
+ * backend compiled into the library has that identifier
+ */
+size_t sha256_backend_find(const char* id);
+
+/**
+ * @brief The backend chosen by sha256_auto_detect().
+ *
+ * @return size_t the number of the backend used by the global entry points
+ */
+size_t sha256_backend_selected(void);
+
+/**
+ * @brief A description of a backend.
+ *
+ * @id: the short identifier, as returned by sha256_backend_id()
+ * @name: the string sha256_auto_detect() returns when it selects the backend
+ * @supported: whether the host supports the backend
+ * @double64_lanes: the lane counts of the sha256_double64() kernels
+ * @midstate_lanes: the lane counts of the sha256_midstate() kernels
+ * @mb_lanes: the lane count of the multi-buffer manager
+ *
+ * The lane counts of a kind of kernel are a bit mask in which bit n is set if
+ * there is an n-way kernel, so 0x116 means 1-, 2-, 4- and 8-way kernels.
+ * Every backend has 1-way kernels, and runs the lanes of the multi-buffer
+ * manager (see sha256_mb_init()) in a single kernel.
+ */
+struct sha256_backend_info {
+        const char* id;
+        const char* name;
+        int supported;
+        unsigned double64_lanes;
+        unsigned midstate_lanes;
+        unsigned mb_lanes;
+};
+
+/**
+ * @brief Describe a backend.
+ *
+ * @param backend the number of a backend
+ * @param info the description to return
+ *
+ * Example:
+ * static void list_backends(FILE* f)
+ * {
+ *         struct sha256_backend_info info;
+ *         size_t i;
+ *         for (i = 0; i < sha256_backend_count(); ++i) {
+ *                 sha256_backend_describe(i, &info);
+ *                 fprintf(f, "%s: %s%s\n", info.id, info.name, info.supported ? "" : " (unsupported)");
+ *         }
+ * }
+ */
+void sha256_backend_describe(size_t backend, struct sha256_backend_info* info);
+
+/**
+ * @brief The entry points of the library, bound to a single backend.
+ *
+ * Each member has the same interface and results as the global function of
+ * the same name, but always runs the kernels of one backend rather than those
+ * chosen by sha256_auto_detect().  Contexts are interchangeable between
+ * backends, since they hold only the standard SHA256 state.
+ */
+struct sha256_functions {
+        void (*update)(struct sha256_ctx* ctx, const void* data, size_t len);
+        void (*done)(struct sha256* hash, struct sha256_ctx* ctx);
+        void (*double64)(struct sha256 out[], const struct sha256 in[], size_t blocks);
+        size_t (*double64_meets_target)(unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target);
+        void (*midstate)(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks);
+        void (*merkle_root)(struct sha256* root, struct sha256 hashes[], size_t count);
+        int (*merkle_root_mutated)(struct sha256* root, struct sha256 hashes[], size_t count);
+        size_t (*check_headers)(unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count);
+        size_t (*grind)(uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice);
+};
+
+/**
+ * @brief The entry points bound to a backend.
+ *
+ * @param backend the number of a backend
+ *
+ * @return const struct sha256_functions* a static table of the backend's entry
+ * points, or NULL if the host does not support the backend
+ *
+ * The table may be used from any thread, alongside the global entry points,
+ * so a process can compare backends or pin one without restarting.  The
+ * backend is self-tested the first time its table is returned.
+ *
+ * Example:
+ * static void hash_with(const char* id, struct sha256* hash, const void* data, size_t len)
+ * {
+ *         const struct sha256_functions* fns = sha256_backend_functions(sha256_backend_find(id));
+ *         struct sha256_ctx ctx = SHA256_INIT;
+ *         if (!fns)
+ *                 fns = sha256_backend_functions(sha256_backend_selected());
+ *         fns->update(&ctx, data, len);
+ *         fns->done(hash, &ctx);
+ * }
+ */
+const struct sha256_functions* sha256_backend_functions(size_t backend);
+
+/**
+ * @brief The backends chosen by sha256_autotune() for each class of operation.
+ *
+ * @update: the backend for streaming hashes, used for update and done
+ * @double64: the backend for double64, double64_meets_target, the merkle root
+ * functions and check_headers, which hash many short messages in parallel
+ * @midstate: the backend for midstate and grind, which hash many messages
+ * with a shared prefix in parallel
+ *
+ * The members are backend numbers, as for sha256_backend_count().
+ */
+struct sha256_tuning {
+        size_t update;
+        size_t double64;
+        size_t midstate;
+};
+
+/**
+ * @brief Choose the fastest supported backend for each class of operation.
+ *
+ * sha256_auto_detect() chooses a single backend from a fixed order of
+ * preference, which is not the fastest for every operation on every CPU: an
+ * 8-way AVX2 kernel may beat the 2-way SHA-NI kernel for sha256_double64(),
+ * for example.  This measures each supported backend on each class of
+ * operation for a few milliseconds, and keeps the selected backend unless
+ * another is measurably faster.  The global entry points are not affected;
+ * the choice is applied with sha256_tuned_functions().
+ *
+ * The choice may be cached in a file, keyed by the CPUID signature of the
+ * host and the backends of the library, so that later processes on the same
+ * machine read it back rather than measure again.  A missing, stale or
+ * damaged cache is replaced, and a cache which cannot be written is ignored.
+ *
+ * @param tuning the choice to return
+ * @param cache the path of the cache file, or NULL to always measure
+ *
+ * @return int nonzero if the choice was read from the cache
+ */
+int sha256_autotune(struct sha256_tuning* tuning, const char* cache);
+
+/**
+ * @brief Compose a table of entry points from a choice of backends.
+ *
+ * @param fns the table to return, each member of which is taken from the
+ * backend which tuning chose for its class of operation
+ * @param tuning a choice of supported backends, as from sha256_autotune()
+ *
+ * Example:
+ * static struct sha256_functions sha256_fns;
+ *
+ * static void init_hashing(void)
+ * {
+ *         struct sha256_tuning tuning;
+ *         sha256_autotune(&tuning, "/var/cache/myapp/sha256-tuning");
+ *         sha256_tuned_functions(&sha256_fns, &tuning);
+ * }
+ */
+void sha256_tuned_functions(struct sha256_functions* fns, const struct sha256_tuning* tuning);
+
 #ifdef __cplusplus
 }
 #endif
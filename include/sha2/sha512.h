@@ -0,0 +1,214 @@
+/* Copyright (c) 2014-2018 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SHA2__SHA512_H
+#define SHA2__SHA512_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h> /* for uint64_t */
+#include <stdlib.h> /* for size_t */
+
+/**
+ * @brief Autodetect the best available SHA512 implementation.
+ *
+ * @return const char* an ASCII-encoded string describing the selected
+ * algorithm
+ *
+ * This is the SHA512 counterpart to sha256_auto_detect(), and follows the same
+ * rules: detection is performed only once, either by this function or
+ * automatically by the first hashing call, and is thread safe.  The selected
+ * implementation is shared by SHA512, SHA384 and SHA512/256, which differ only
+ * in their initial state and the length of their output.
+ */
+const char* sha512_auto_detect(void);
+
+/**
+ * @brief A structure representing a completed SHA512 hash digest value.
+ *
+ * @u.u8: an unsigned char array
+ *
+ * As with struct sha256, the digest is stored in big-endian byte order,
+ * regardless of the endianness of the host machine.
+ */
+struct sha512 {
+        unsigned char u8[64];
+};
+
+/**
+ * @brief A structure representing a completed SHA384 hash digest value.
+ *
+ * @u.u8: an unsigned char array
+ */
+struct sha384 {
+        unsigned char u8[48];
+};
+
+/**
+ * @brief A structure representing a completed SHA512/256 hash digest value.
+ *
+ * @u.u8: an unsigned char array
+ *
+ * SHA512/256 is a distinct hash function from SHA256, despite having the same
+ * output length, so it is given its own type.
+ */
+struct sha512_256 {
+        unsigned char u8[32];
+};
+
+/**
+ * @brief A structure for storing the running context of a sha512 hash.
+ *
+ * @s: the intermediate state in host-native byte order
+ * @buf: a buffer of up to 127 bytes of unhashed data
+ * @len: the total number of bytes hashed, including any buffered data
+ *
+ * This mirrors struct sha256_ctx, except that the SHA512 state update function
+ * operates on 64-bit words in blocks of 128 bytes at a time.  The same context
+ * is used for SHA384 and SHA512/256.
+ */
+struct sha512_ctx {
+        uint64_t s[8];
+        union {
+                uint64_t u64[16];
+                unsigned char u8[128];
+        } buf;
+        size_t bytes;
+};
+
+/**
+ * @brief Initializes a SHA512 context.
+ *
+ * @param ctx the context to initialize
+ *
+ * This must be called before any of the other sha512 functions which take a
+ * context parameter.  Alternatively you may use the SHA512_INIT initialization
+ * constant instead.
+ *
+ * Example:
+ * static void hash_data(const char* data, size_t len, struct sha512* hash)
+ * {
+ *         struct sha512_ctx ctx;
+ *         sha512_init(&ctx);
+ *         sha512_update(&ctx, data, len);
+ *         sha512_done(hash, &ctx);
+ * }
+ */
+void sha512_init(struct sha512_ctx* ctx);
+
+/**
+ * @brief Initialization constant for a SHA512 context.
+ *
+ * This can be used to statically initialize a SHA512 context, equivalent to
+ * calling sha512_init().
+ */
+#define SHA512_INIT                                                                   \
+        { { 0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull,      \
+            0xa54ff53a5f1d36f1ull, 0x510e527fade682d1ull, 0x9b05688c2b3e6c1full,      \
+            0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull },                           \
+          { { 0 } }, 0 }
+
+/**
+ * @brief Add some data from memory to the hash.
+ *
+ * @param ctx the sha512_ctx to use
+ * @param data a pointer to data in memory
+ * @param len the number of bytes pointed to by \p data
+ *
+ * Adds data to the hash context, performing hash compressions if a full block
+ * of 128 bytes is formed, or storing the bytes in the buffer otherwise.  This
+ * is used for SHA384 and SHA512/256 contexts as well.
+ */
+void sha512_update(struct sha512_ctx* ctx, const void *data, size_t len);
+
+/**
+ * @brief Finalize a SHA512 and return the resulting hash.
+ *
+ * @param hash the hash to return
+ * @param ctx the sha512_ctx to finalize
+ *
+ * Note that the context is used up by this call and must be re-initialized
+ * before being used again.
+ */
+void sha512_done(struct sha512* hash, struct sha512_ctx* ctx);
+
+/**
+ * @brief Initializes a context for computing a SHA384 hash.
+ *
+ * @param ctx the context to initialize
+ *
+ * SHA384 is SHA512 with a different initial state, truncated to 48 bytes.
+ * Data is added with sha512_update() and the hash is finalized with
+ * sha384_done().
+ *
+ * Example:
+ * static void hash_data(const char* data, size_t len, struct sha384* hash)
+ * {
+ *         struct sha512_ctx ctx = SHA384_INIT;
+ *         sha512_update(&ctx, data, len);
+ *         sha384_done(hash, &ctx);
+ * }
+ */
+void sha384_init(struct sha512_ctx* ctx);
+
+/**
+ * @brief Initialization constant for a SHA384 context.
+ */
+#define SHA384_INIT                                                                   \
+        { { 0xcbbb9d5dc1059ed8ull, 0x629a292a367cd507ull, 0x9159015a3070dd17ull,      \
+            0x152fecd8f70e5939ull, 0x67332667ffc00b31ull, 0x8eb44a8768581511ull,      \
+            0xdb0c2e0d64f98fa7ull, 0x47b5481dbefa4fa4ull },                           \
+          { { 0 } }, 0 }
+
+/**
+ * @brief Finalize a SHA384 and return the resulting hash.
+ *
+ * @param hash the hash to return
+ * @param ctx the sha512_ctx to finalize, initialized by sha384_init()
+ */
+void sha384_done(struct sha384* hash, struct sha512_ctx* ctx);
+
+/**
+ * @brief Initializes a context for computing a SHA512/256 hash.
+ *
+ * @param ctx the context to initialize
+ *
+ * SHA512/256 is SHA512 with a different initial state, truncated to 32 bytes.
+ * Data is added with sha512_update() and the hash is finalized with
+ * sha512_256_done().  On 64-bit hosts without SHA256 acceleration it is
+ * typically faster than SHA256 for long messages.
+ */
+void sha512_256_init(struct sha512_ctx* ctx);
+
+/**
+ * @brief Initialization constant for a SHA512/256 context.
+ */
+#define SHA512_256_INIT                                                               \
+        { { 0x22312194fc2bf72cull, 0x9f555fa3c84c64c2ull, 0x2393b86b6f53b151ull,      \
+            0x963877195940eabdull, 0x96283ee2a88effe3ull, 0xbe5e1e2553863992ull,      \
+            0x2b0199fc2c85b8aaull, 0x0eb72ddc81c52ca2ull },                           \
+          { { 0 } }, 0 }
+
+/**
+ * @brief Finalize a SHA512/256 and return the resulting hash.
+ *
+ * @param hash the hash to return
+ * @param ctx the sha512_ctx to finalize, initialized by sha512_256_init()
+ */
+void sha512_256_done(struct sha512_256* hash, struct sha512_ctx* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2__SHA512_H */
+
+/* End of File
+ */
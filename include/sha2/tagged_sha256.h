@@ -0,0 +1,109 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SHA2__TAGGED_SHA256_H
+#define SHA2__TAGGED_SHA256_H
+
+#include <sha2/sha256.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h> /* for size_t */
+
+/**
+ * @brief The contexts of the tagged hashes of BIP340 and BIP341.
+ *
+ * A tagged hash, as specified by BIP340, is SHA256(SHA256(tag) ||
+ * SHA256(tag) || msg).  The first 64 bytes fill exactly one block, so the
+ * state after them is the same for every message under a tag.  These are
+ * contexts which have already hashed that block for the tags used by Schnorr
+ * signatures and Taproot, so that hashing a message costs only the
+ * compressions of the message itself.
+ *
+ * A context is used by copying it and continuing with sha256_update() and
+ * sha256_done(), or by passing it to tagged_sha256() or
+ * tagged_sha256_batch64().
+ *
+ * Example:
+ * static void challenge(struct sha256* e, const unsigned char r[32], const unsigned char p[32], const unsigned char m[32])
+ * {
+ *         struct sha256_ctx ctx = tagged_sha256_bip340_challenge;
+ *         sha256_update(&ctx, r, 32);
+ *         sha256_update(&ctx, p, 32);
+ *         sha256_update(&ctx, m, 32);
+ *         sha256_done(e, &ctx);
+ * }
+ */
+extern const struct sha256_ctx tagged_sha256_bip340_aux;       /* "BIP0340/aux" */
+extern const struct sha256_ctx tagged_sha256_bip340_nonce;     /* "BIP0340/nonce" */
+extern const struct sha256_ctx tagged_sha256_bip340_challenge; /* "BIP0340/challenge" */
+extern const struct sha256_ctx tagged_sha256_tapleaf;          /* "TapLeaf" */
+extern const struct sha256_ctx tagged_sha256_tapbranch;        /* "TapBranch" */
+extern const struct sha256_ctx tagged_sha256_taptweak;         /* "TapTweak" */
+extern const struct sha256_ctx tagged_sha256_tapsighash;       /* "TapSighash" */
+
+/**
+ * @brief Precompute the context of a tagged hash for any tag.
+ *
+ * @param tag the context to initialize
+ * @param name the tag
+ * @param len the number of bytes pointed to by \p name
+ *
+ * The result is the same as the predefined contexts above for their tags, and
+ * may be used in the same ways.  It takes two or more compressions, and
+ * should be done once for each tag rather than once for each message.
+ *
+ * Example:
+ * static struct sha256_ctx my_tag;
+ *
+ * static void init(void)
+ * {
+ *         tagged_sha256_init(&my_tag, "MyProtocol/commitment", 21);
+ * }
+ */
+void tagged_sha256_init(struct sha256_ctx* tag, const void* name, size_t len);
+
+/**
+ * @brief Compute a tagged hash in one call.
+ *
+ * @param hash the hash to return
+ * @param tag the context of the tag
+ * @param data a pointer to the message
+ * @param len the number of bytes pointed to by \p data
+ *
+ * Messages of up to 55 bytes fit in a single block with their padding, and
+ * are hashed with exactly one compression.
+ */
+void tagged_sha256(struct sha256* hash, const struct sha256_ctx* tag, const void* data, size_t len);
+
+/**
+ * @brief Compute the tagged hashes of many 64-byte messages at once.
+ *
+ * @param out an array of count hashes to return
+ * @param tag the context of the tag
+ * @param in an array of 64*count bytes of messages
+ * @param count the number of messages
+ *
+ * Message i is the 64 bytes at in + 64*i, such as the two child hashes of a
+ * TapBranch.  Each hash is two compressions, of the message and of its
+ * padding, from the midstate of the tag.  The messages are hashed side by
+ * side in the lanes of the multi-buffer kernels, which are all seeded with that
+ * midstate, and since the padding block is the same in every lane, it needs no
+ * per-message buffer.
+ */
+void tagged_sha256_batch64(struct sha256 out[], const struct sha256_ctx* tag, const unsigned char in[], size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2__TAGGED_SHA256_H */
+
+/* End of File
+ */
@@ -115,5 +115,13 @@ uint64_t CountBits(uint64_t x)
         return ret;
 }
 
+void Wipe(void* ptr, size_t len)
+{
+        volatile unsigned char* v = (volatile unsigned char*)ptr;
+        while (len--) {
+                *v++ = 0;
+        }
+}
+
 /* End of File
  */
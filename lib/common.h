@@ -13,6 +13,7 @@
 #include <libsha2-config.h>
 #endif
 
+#include <stddef.h> /* for size_t */
 #include <stdint.h> /* for uint16_t, uint32_t, uint64_t */
 
 uint16_t ReadLE16(const unsigned char* ptr);
@@ -41,6 +42,14 @@ void WriteBE64(unsigned char* ptr, uint64_t x);
  */
 uint64_t CountBits(uint64_t x);
 
+/**
+ * @brief Clear sensitive data in a way the compiler will not optimize away.
+ *
+ * @param ptr the memory to clear
+ * @param len the number of bytes pointed to by \p ptr
+ */
+void Wipe(void* ptr, size_t len);
+
 #endif /* SHA2__COMMON_H */
 
 /* End of File
@@ -0,0 +1,156 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sha2/hmac_sha256.h>
+#include "common.h"
+
+#include <assert.h>
+#include <string.h>
+
+void hmac_sha256_key_init(struct hmac_sha256_key* key, const void* secret, size_t len)
+{
+        unsigned char block[64];
+        struct sha256_ctx ctx;
+        int i;
+
+        assert(key);
+        memset(block, 0, sizeof(block));
+        if (len > 64) {
+                sha256_init(&ctx);
+                sha256_update(&ctx, secret, len);
+                sha256_done((struct sha256*)block, &ctx);
+        } else if (len) {
+                memcpy(block, secret, len);
+        }
+
+        for (i = 0; i < 64; ++i) {
+                block[i] ^= 0x36;
+        }
+        sha256_init(&ctx);
+        sha256_update(&ctx, block, 64);
+        memcpy(key->inner, ctx.s, sizeof(key->inner));
+
+        for (i = 0; i < 64; ++i) {
+                block[i] ^= 0x36 ^ 0x5c;
+        }
+        sha256_init(&ctx);
+        sha256_update(&ctx, block, 64);
+        memcpy(key->outer, ctx.s, sizeof(key->outer));
+
+        Wipe(block, sizeof(block));
+        Wipe(&ctx, sizeof(ctx));
+}
+
+void hmac_sha256_init(struct hmac_sha256_ctx* ctx, const struct hmac_sha256_key* key)
+{
+        assert(ctx && key);
+        memcpy(ctx->inner.s, key->inner, sizeof(ctx->inner.s));
+        ctx->inner.bytes = 64;
+        memcpy(ctx->outer, key->outer, sizeof(ctx->outer));
+}
+
+void hmac_sha256_update(struct hmac_sha256_ctx* ctx, const void* data, size_t len)
+{
+        sha256_update(&ctx->inner, data, len);
+}
+
+/** Compute the outer hash of an inner hash, in a single compression. */
+static void hmac_sha256_outer(struct sha256* mac, const uint32_t outer[8], const struct sha256* inner)
+{
+        unsigned char block[64];
+        memcpy(block, inner->u8, 32);
+        block[32] = 0x80;
+        memset(block + 33, 0, 64 - 33 - 8);
+        WriteBE64(block + 56, (64 + 32) << 3);
+        sha256_midstate(mac, outer, block, 1);
+}
+
+void hmac_sha256_done(struct sha256* mac, struct hmac_sha256_ctx* ctx)
+{
+        struct sha256 inner;
+        sha256_done(&inner, &ctx->inner);
+        hmac_sha256_outer(mac, ctx->outer, &inner);
+}
+
+void hmac_sha256(struct sha256* mac, const struct hmac_sha256_key* key, const void* data, size_t len)
+{
+        struct hmac_sha256_ctx ctx;
+        struct sha256 inner;
+        unsigned char block[64];
+
+        if (len > 55) {
+                hmac_sha256_init(&ctx, key);
+                hmac_sha256_update(&ctx, data, len);
+                hmac_sha256_done(mac, &ctx);
+                return;
+        }
+
+        /* The message and its padding fit in a single block after the key's
+         * inner block. */
+        if (len) {
+                memcpy(block, data, len);
+        }
+        block[len] = 0x80;
+        memset(block + len + 1, 0, 64 - len - 1 - 8);
+        WriteBE64(block + 56, (uint64_t)(64 + len) << 3);
+        sha256_midstate(&inner, key->inner, block, 1);
+        hmac_sha256_outer(mac, key->outer, &inner);
+}
+
+void hmac_sha256_batch(struct sha256 macs[], const struct hmac_sha256_key* const keys[], const void* const data[], const size_t lens[], size_t count)
+{
+        struct sha256_mb_mgr mgr;
+        struct sha256_mb_job job[SHA256_MB_MAX_LANES];
+        size_t index[SHA256_MB_MAX_LANES];
+        int outer[SHA256_MB_MAX_LANES];
+        unsigned free_slot[SHA256_MB_MAX_LANES];
+        unsigned num_free, slot;
+        struct sha256_mb_job* done;
+        size_t next = 0, i;
+
+        assert(macs && keys && data && lens);
+        sha256_mb_init(&mgr);
+        for (slot = 0; slot < mgr.lanes; ++slot) {
+                free_slot[slot] = slot;
+        }
+        num_free = mgr.lanes;
+
+        while (1) {
+                /* Every job in flight occupies a lane, so there is a free slot
+                 * unless the manager is draining. */
+                if (num_free && next < count) {
+                        slot = free_slot[--num_free];
+                        index[slot] = next;
+                        outer[slot] = 0;
+                        job[slot].data = data[next];
+                        job[slot].len = lens[next];
+                        done = sha256_mb_submit_midstate(&mgr, &job[slot], keys[next]->inner, 64);
+                        ++next;
+                } else if (!(done = sha256_mb_flush(&mgr))) {
+                        break;
+                }
+                while (done) {
+                        slot = (unsigned)(done - job);
+                        i = index[slot];
+                        macs[i] = done->hash;
+                        if (outer[slot]) {
+                                free_slot[num_free++] = slot;
+                                break;
+                        }
+                        /* The inner hash is copied into the lane's tail
+                         * buffer on submission, so the MAC may overwrite it
+                         * in place. */
+                        outer[slot] = !0;
+                        job[slot].data = macs[i].u8;
+                        job[slot].len = 32;
+                        done = sha256_mb_submit_midstate(&mgr, &job[slot], keys[i]->outer, 64);
+                }
+        }
+}
+
+/* End of File
+ */
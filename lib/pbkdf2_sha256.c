@@ -0,0 +1,101 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sha2/pbkdf2_sha256.h>
+#include <sha2/hmac_sha256.h>
+#include "sha256_internal.h"
+#include "common.h"
+
+#include <assert.h>
+#include <string.h>
+
+/* The number of 32-byte output blocks derived together, which is the lane
+ * count of the widest kernel. */
+#define PBKDF2_LANES 16
+
+/* The state of up to PBKDF2_LANES output blocks, in the lane-major layout of
+ * sha256_pbkdf2_iterate(). */
+struct pbkdf2_lanes {
+        uint32_t f[PBKDF2_LANES * 8];
+        uint32_t u[PBKDF2_LANES * 8];
+        uint32_t inner[PBKDF2_LANES * 8];
+        uint32_t outer[PBKDF2_LANES * 8];
+        unsigned char* out[PBKDF2_LANES];
+        size_t len[PBKDF2_LANES];
+        size_t count;
+};
+
+/** Run the remaining iterations of every lane, and write out the results. */
+static void pbkdf2_flush(struct pbkdf2_lanes* l, size_t iterations)
+{
+        unsigned char block[32];
+        size_t i;
+        int j;
+
+        sha256_pbkdf2_iterate(l->f, l->u, l->inner, l->outer, l->count, iterations - 1);
+        for (i = 0; i < l->count; ++i) {
+                for (j = 0; j < 8; ++j) {
+                        WriteBE32(block + 4 * j, l->f[8 * i + j]);
+                }
+                memcpy(l->out[i], block, l->len[i]);
+        }
+        l->count = 0;
+        Wipe(block, sizeof(block));
+}
+
+void pbkdf2_hmac_sha256_batch(unsigned char* const out[], size_t outlen, const void* const passwords[], const size_t passlens[], const void* const salts[], const size_t saltlens[], size_t count, size_t iterations)
+{
+        struct pbkdf2_lanes l;
+        struct hmac_sha256_key key;
+        struct hmac_sha256_ctx ctx;
+        struct sha256 u1;
+        unsigned char index[4];
+        size_t i, offset;
+        uint32_t block;
+        int j;
+
+        assert(iterations >= 1);
+        l.count = 0;
+        for (i = 0; i < count; ++i) {
+                hmac_sha256_key_init(&key, passwords[i], passlens[i]);
+                for (offset = 0, block = 1; offset < outlen; offset += 32, ++block) {
+                        /* U_1 = HMAC(P, S || INT(i)) is computed directly,
+                         * and the remaining iterations in the lanes. */
+                        WriteBE32(index, block);
+                        hmac_sha256_init(&ctx, &key);
+                        hmac_sha256_update(&ctx, salts[i], saltlens[i]);
+                        hmac_sha256_update(&ctx, index, sizeof(index));
+                        hmac_sha256_done(&u1, &ctx);
+                        for (j = 0; j < 8; ++j) {
+                                l.u[8 * l.count + j] = l.f[8 * l.count + j] = ReadBE32(u1.u8 + 4 * j);
+                        }
+                        memcpy(l.inner + 8 * l.count, key.inner, sizeof(key.inner));
+                        memcpy(l.outer + 8 * l.count, key.outer, sizeof(key.outer));
+                        l.out[l.count] = out[i] + offset;
+                        l.len[l.count] = outlen - offset < 32 ? outlen - offset : 32;
+                        if (++l.count == PBKDF2_LANES) {
+                                pbkdf2_flush(&l, iterations);
+                        }
+                }
+        }
+        if (l.count) {
+                pbkdf2_flush(&l, iterations);
+        }
+
+        Wipe(&l, sizeof(l));
+        Wipe(&key, sizeof(key));
+        Wipe(&ctx, sizeof(ctx));
+        Wipe(&u1, sizeof(u1));
+}
+
+void pbkdf2_hmac_sha256(unsigned char* out, size_t outlen, const void* password, size_t passlen, const void* salt, size_t saltlen, size_t iterations)
+{
+        pbkdf2_hmac_sha256_batch(&out, outlen, &password, &passlen, &salt, &saltlen, 1, iterations);
+}
+
+/* End of File
+ */
@@ -26,6 +26,13 @@
 
 #include "sha256_internal.h"
 
+/* GNU indirect functions need support from both the toolchain and the
+ * dynamic loader, which configure and the C library headers tell us about. */
+#if defined(HAVE_IFUNC) && defined(__ELF__) && defined(__GLIBC__) && \
+    (defined(__x86_64__) || defined(__amd64__) || (defined(__aarch64__) && defined(__linux__)))
+#define SHA256_USE_IFUNC
+#endif
+
 static inline __attribute__((always_inline)) uint32_t Ch_noasm(uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); }
 static inline __attribute__((always_inline)) uint32_t Maj_noasm(uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); }
 static inline __attribute__((always_inline)) uint32_t Sigma0_noasm(uint32_t x) { return (x >> 2 | x << 30) ^ (x >> 13 | x << 19) ^ (x >> 22 | x << 10); }
@@ -142,7 +149,108 @@ static void transform_noasm(uint32_t* s, const unsigned char* chunk, size_t bloc
         }
 }
 
-static void transform_d64_noasm(struct sha256 out[1], const struct sha256 in[2])
+/** The second hash of a double SHA256, of the 32-byte state s left by the
+ * first.  If top is set, only the last word of the hash is computed, and it is
+ * returned instead of being written to out. */
+static inline __attribute__((always_inline)) uint32_t transform_d32_noasm(struct sha256 out[1], const uint32_t s[8], int top)
+{
+        uint32_t a, b, c, d, e, f, g, h;
+
+        uint32_t w0 = s[0], w1 = s[1], w2 = s[2], w3 = s[3], w4 = s[4], w5 = s[5], w6 = s[6], w7 = s[7];
+        uint32_t w8, w9, w10, w11, w12, w13, w14, w15;
+
+        /* Transform 3 */
+        a = 0x6a09e667ul;
+        b = 0xbb67ae85ul;
+        c = 0x3c6ef372ul;
+        d = 0xa54ff53aul;
+        e = 0x510e527ful;
+        f = 0x9b05688cul;
+        g = 0x1f83d9abul;
+        h = 0x5be0cd19ul;
+
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x428a2f98ul + w0);
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0x71374491ul + w1);
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0xb5c0fbcful + w2);
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0xe9b5dba5ul + w3);
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x3956c25bul + w4);
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0x59f111f1ul + w5);
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x923f82a4ul + w6);
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0xab1c5ed5ul + w7);
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x5807aa98ul);
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0x12835b01ul);
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0x243185beul);
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0x550c7dc3ul);
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x72be5d74ul);
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0x80deb1feul);
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x9bdc06a7ul);
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0xc19bf274ul);
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0xe49b69c1ul + (w0 += sigma0_noasm(w1)));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0xefbe4786ul + (w1 += 0xa00000ul + sigma0_noasm(w2)));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0x0fc19dc6ul + (w2 += sigma1_noasm(w0) + sigma0_noasm(w3)));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0x240ca1ccul + (w3 += sigma1_noasm(w1) + sigma0_noasm(w4)));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x2de92c6ful + (w4 += sigma1_noasm(w2) + sigma0_noasm(w5)));
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0x4a7484aaul + (w5 += sigma1_noasm(w3) + sigma0_noasm(w6)));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x5cb0a9dcul + (w6 += sigma1_noasm(w4) + 0x100ul + sigma0_noasm(w7)));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0x76f988daul + (w7 += sigma1_noasm(w5) + w0 + 0x11002000ul));
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x983e5152ul + (w8 = 0x80000000ul + sigma1_noasm(w6) + w1));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0xa831c66dul + (w9 = sigma1_noasm(w7) + w2));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0xb00327c8ul + (w10 = sigma1_noasm(w8) + w3));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0xbf597fc7ul + (w11 = sigma1_noasm(w9) + w4));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0xc6e00bf3ul + (w12 = sigma1_noasm(w10) + w5));
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0xd5a79147ul + (w13 = sigma1_noasm(w11) + w6));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x06ca6351ul + (w14 = sigma1_noasm(w12) + w7 + 0x400022ul));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0x14292967ul + (w15 = 0x100ul + sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x27b70a85ul + (w0 += sigma1_noasm(w14) + w9 + sigma0_noasm(w1)));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0x2e1b2138ul + (w1 += sigma1_noasm(w15) + w10 + sigma0_noasm(w2)));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0x4d2c6dfcul + (w2 += sigma1_noasm(w0) + w11 + sigma0_noasm(w3)));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0x53380d13ul + (w3 += sigma1_noasm(w1) + w12 + sigma0_noasm(w4)));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x650a7354ul + (w4 += sigma1_noasm(w2) + w13 + sigma0_noasm(w5)));
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0x766a0abbul + (w5 += sigma1_noasm(w3) + w14 + sigma0_noasm(w6)));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x81c2c92eul + (w6 += sigma1_noasm(w4) + w15 + sigma0_noasm(w7)));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0x92722c85ul + (w7 += sigma1_noasm(w5) + w0 + sigma0_noasm(w8)));
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0xa2bfe8a1ul + (w8 += sigma1_noasm(w6) + w1 + sigma0_noasm(w9)));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0xa81a664bul + (w9 += sigma1_noasm(w7) + w2 + sigma0_noasm(w10)));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0xc24b8b70ul + (w10 += sigma1_noasm(w8) + w3 + sigma0_noasm(w11)));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0xc76c51a3ul + (w11 += sigma1_noasm(w9) + w4 + sigma0_noasm(w12)));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0xd192e819ul + (w12 += sigma1_noasm(w10) + w5 + sigma0_noasm(w13)));
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0xd6990624ul + (w13 += sigma1_noasm(w11) + w6 + sigma0_noasm(w14)));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0xf40e3585ul + (w14 += sigma1_noasm(w12) + w7 + sigma0_noasm(w15)));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0x106aa070ul + (w15 += sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x19a4c116ul + (w0 += sigma1_noasm(w14) + w9 + sigma0_noasm(w1)));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0x1e376c08ul + (w1 += sigma1_noasm(w15) + w10 + sigma0_noasm(w2)));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0x2748774cul + (w2 += sigma1_noasm(w0) + w11 + sigma0_noasm(w3)));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0x34b0bcb5ul + (w3 += sigma1_noasm(w1) + w12 + sigma0_noasm(w4)));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x391c0cb3ul + (w4 += sigma1_noasm(w2) + w13 + sigma0_noasm(w5)));
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0x4ed8aa4aul + (w5 += sigma1_noasm(w3) + w14 + sigma0_noasm(w6)));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0x5b9cca4ful + (w6 += sigma1_noasm(w4) + w15 + sigma0_noasm(w7)));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0x682e6ff3ul + (w7 += sigma1_noasm(w5) + w0 + sigma0_noasm(w8)));
+        Round_noasm(a, b, c, &d, e, f, g, &h, 0x748f82eeul + (w8 += sigma1_noasm(w6) + w1 + sigma0_noasm(w9)));
+        Round_noasm(h, a, b, &c, d, e, f, &g, 0x78a5636ful + (w9 += sigma1_noasm(w7) + w2 + sigma0_noasm(w10)));
+        Round_noasm(g, h, a, &b, c, d, e, &f, 0x84c87814ul + (w10 += sigma1_noasm(w8) + w3 + sigma0_noasm(w11)));
+        Round_noasm(f, g, h, &a, b, c, d, &e, 0x8cc70208ul + (w11 += sigma1_noasm(w9) + w4 + sigma0_noasm(w12)));
+        Round_noasm(e, f, g, &h, a, b, c, &d, 0x90befffaul + (w12 += sigma1_noasm(w10) + w5 + sigma0_noasm(w13)));
+        /* h now holds the last word of the hash, which the remaining rounds
+         * only pass along. */
+        if (top) return h + 0x5be0cd19ul;
+        Round_noasm(d, e, f, &g, h, a, b, &c, 0xa4506cebul + (w13 += sigma1_noasm(w11) + w6 + sigma0_noasm(w14)));
+        Round_noasm(c, d, e, &f, g, h, a, &b, 0xbef9a3f7ul + (w14 + sigma1_noasm(w12) + w7 + sigma0_noasm(w15)));
+        Round_noasm(b, c, d, &e, f, g, h, &a, 0xc67178f2ul + (w15 + sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
+
+        /* Output */
+        WriteBE32(&out->u8[0], a + 0x6a09e667ul);
+        WriteBE32(&out->u8[4], b + 0xbb67ae85ul);
+        WriteBE32(&out->u8[8], c + 0x3c6ef372ul);
+        WriteBE32(&out->u8[12], d + 0xa54ff53aul);
+        WriteBE32(&out->u8[16], e + 0x510e527ful);
+        WriteBE32(&out->u8[20], f + 0x9b05688cul);
+        WriteBE32(&out->u8[24], g + 0x1f83d9abul);
+        WriteBE32(&out->u8[28], h + 0x5be0cd19ul);
+        return h;
+}
+
+/** Double SHA256 a 64-byte block, with top as for transform_d32_noasm(). */
+static inline __attribute__((always_inline)) uint32_t sha256d64_noasm(struct sha256 out[1], const struct sha256 in[2], int top)
 {
         /* Transform 1 */
         uint32_t a = 0x6a09e667ul;
@@ -158,6 +266,8 @@ static void transform_d64_noasm(struct sha256 out[1], const struct sha256 in[2])
 
         uint32_t t0, t1, t2, t3, t4, t5, t6, t7;
 
+        uint32_t s[8];
+
         Round_noasm(a, b, c, &d, e, f, g, &h, 0x428a2f98ul + (w0 = ReadBE32(&in[0].u8[0])));
         Round_noasm(h, a, b, &c, d, e, f, &g, 0x71374491ul + (w1 = ReadBE32(&in[0].u8[4])));
         Round_noasm(g, h, a, &b, c, d, e, &f, 0xb5c0fbcful + (w2 = ReadBE32(&in[0].u8[8])));
@@ -298,104 +408,39 @@ static void transform_d64_noasm(struct sha256 out[1], const struct sha256 in[2])
         Round_noasm(c, d, e, &f, g, h, a, &b, 0xa4954b68ul);
         Round_noasm(b, c, d, &e, f, g, h, &a, 0x4c191d76ul);
 
-        w0 = t0 + a;
-        w1 = t1 + b;
-        w2 = t2 + c;
-        w3 = t3 + d;
-        w4 = t4 + e;
-        w5 = t5 + f;
-        w6 = t6 + g;
-        w7 = t7 + h;
+        s[0] = t0 + a;
+        s[1] = t1 + b;
+        s[2] = t2 + c;
+        s[3] = t3 + d;
+        s[4] = t4 + e;
+        s[5] = t5 + f;
+        s[6] = t6 + g;
+        s[7] = t7 + h;
 
-        /* Transform 3 */
-        a = 0x6a09e667ul;
-        b = 0xbb67ae85ul;
-        c = 0x3c6ef372ul;
-        d = 0xa54ff53aul;
-        e = 0x510e527ful;
-        f = 0x9b05688cul;
-        g = 0x1f83d9abul;
-        h = 0x5be0cd19ul;
+        return transform_d32_noasm(out, s, top);
+}
 
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x428a2f98ul + w0);
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0x71374491ul + w1);
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0xb5c0fbcful + w2);
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0xe9b5dba5ul + w3);
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x3956c25bul + w4);
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0x59f111f1ul + w5);
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x923f82a4ul + w6);
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0xab1c5ed5ul + w7);
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x5807aa98ul);
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0x12835b01ul);
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0x243185beul);
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0x550c7dc3ul);
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x72be5d74ul);
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0x80deb1feul);
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x9bdc06a7ul);
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0xc19bf274ul);
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0xe49b69c1ul + (w0 += sigma0_noasm(w1)));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0xefbe4786ul + (w1 += 0xa00000ul + sigma0_noasm(w2)));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0x0fc19dc6ul + (w2 += sigma1_noasm(w0) + sigma0_noasm(w3)));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0x240ca1ccul + (w3 += sigma1_noasm(w1) + sigma0_noasm(w4)));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x2de92c6ful + (w4 += sigma1_noasm(w2) + sigma0_noasm(w5)));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0x4a7484aaul + (w5 += sigma1_noasm(w3) + sigma0_noasm(w6)));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x5cb0a9dcul + (w6 += sigma1_noasm(w4) + 0x100ul + sigma0_noasm(w7)));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0x76f988daul + (w7 += sigma1_noasm(w5) + w0 + 0x11002000ul));
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x983e5152ul + (w8 = 0x80000000ul + sigma1_noasm(w6) + w1));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0xa831c66dul + (w9 = sigma1_noasm(w7) + w2));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0xb00327c8ul + (w10 = sigma1_noasm(w8) + w3));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0xbf597fc7ul + (w11 = sigma1_noasm(w9) + w4));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0xc6e00bf3ul + (w12 = sigma1_noasm(w10) + w5));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0xd5a79147ul + (w13 = sigma1_noasm(w11) + w6));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x06ca6351ul + (w14 = sigma1_noasm(w12) + w7 + 0x400022ul));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0x14292967ul + (w15 = 0x100ul + sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x27b70a85ul + (w0 += sigma1_noasm(w14) + w9 + sigma0_noasm(w1)));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0x2e1b2138ul + (w1 += sigma1_noasm(w15) + w10 + sigma0_noasm(w2)));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0x4d2c6dfcul + (w2 += sigma1_noasm(w0) + w11 + sigma0_noasm(w3)));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0x53380d13ul + (w3 += sigma1_noasm(w1) + w12 + sigma0_noasm(w4)));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x650a7354ul + (w4 += sigma1_noasm(w2) + w13 + sigma0_noasm(w5)));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0x766a0abbul + (w5 += sigma1_noasm(w3) + w14 + sigma0_noasm(w6)));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x81c2c92eul + (w6 += sigma1_noasm(w4) + w15 + sigma0_noasm(w7)));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0x92722c85ul + (w7 += sigma1_noasm(w5) + w0 + sigma0_noasm(w8)));
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0xa2bfe8a1ul + (w8 += sigma1_noasm(w6) + w1 + sigma0_noasm(w9)));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0xa81a664bul + (w9 += sigma1_noasm(w7) + w2 + sigma0_noasm(w10)));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0xc24b8b70ul + (w10 += sigma1_noasm(w8) + w3 + sigma0_noasm(w11)));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0xc76c51a3ul + (w11 += sigma1_noasm(w9) + w4 + sigma0_noasm(w12)));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0xd192e819ul + (w12 += sigma1_noasm(w10) + w5 + sigma0_noasm(w13)));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0xd6990624ul + (w13 += sigma1_noasm(w11) + w6 + sigma0_noasm(w14)));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0xf40e3585ul + (w14 += sigma1_noasm(w12) + w7 + sigma0_noasm(w15)));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0x106aa070ul + (w15 += sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x19a4c116ul + (w0 += sigma1_noasm(w14) + w9 + sigma0_noasm(w1)));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0x1e376c08ul + (w1 += sigma1_noasm(w15) + w10 + sigma0_noasm(w2)));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0x2748774cul + (w2 += sigma1_noasm(w0) + w11 + sigma0_noasm(w3)));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0x34b0bcb5ul + (w3 += sigma1_noasm(w1) + w12 + sigma0_noasm(w4)));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x391c0cb3ul + (w4 += sigma1_noasm(w2) + w13 + sigma0_noasm(w5)));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0x4ed8aa4aul + (w5 += sigma1_noasm(w3) + w14 + sigma0_noasm(w6)));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0x5b9cca4ful + (w6 += sigma1_noasm(w4) + w15 + sigma0_noasm(w7)));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0x682e6ff3ul + (w7 += sigma1_noasm(w5) + w0 + sigma0_noasm(w8)));
-        Round_noasm(a, b, c, &d, e, f, g, &h, 0x748f82eeul + (w8 += sigma1_noasm(w6) + w1 + sigma0_noasm(w9)));
-        Round_noasm(h, a, b, &c, d, e, f, &g, 0x78a5636ful + (w9 += sigma1_noasm(w7) + w2 + sigma0_noasm(w10)));
-        Round_noasm(g, h, a, &b, c, d, e, &f, 0x84c87814ul + (w10 += sigma1_noasm(w8) + w3 + sigma0_noasm(w11)));
-        Round_noasm(f, g, h, &a, b, c, d, &e, 0x8cc70208ul + (w11 += sigma1_noasm(w9) + w4 + sigma0_noasm(w12)));
-        Round_noasm(e, f, g, &h, a, b, c, &d, 0x90befffaul + (w12 += sigma1_noasm(w10) + w5 + sigma0_noasm(w13)));
-        Round_noasm(d, e, f, &g, h, a, b, &c, 0xa4506cebul + (w13 += sigma1_noasm(w11) + w6 + sigma0_noasm(w14)));
-        Round_noasm(c, d, e, &f, g, h, a, &b, 0xbef9a3f7ul + (w14 + sigma1_noasm(w12) + w7 + sigma0_noasm(w15)));
-        Round_noasm(b, c, d, &e, f, g, h, &a, 0xc67178f2ul + (w15 + sigma1_noasm(w13) + w8 + sigma0_noasm(w0)));
+static void transform_d64_noasm(struct sha256 out[1], const struct sha256 in[2])
+{
+        sha256d64_noasm(out, in, 0);
+}
 
-        /* Output */
-        WriteBE32(&out->u8[0], a + 0x6a09e667ul);
-        WriteBE32(&out->u8[4], b + 0xbb67ae85ul);
-        WriteBE32(&out->u8[8], c + 0x3c6ef372ul);
-        WriteBE32(&out->u8[12], d + 0xa54ff53aul);
-        WriteBE32(&out->u8[16], e + 0x510e527ful);
-        WriteBE32(&out->u8[20], f + 0x9b05688cul);
-        WriteBE32(&out->u8[24], g + 0x1f83d9abul);
-        WriteBE32(&out->u8[28], h + 0x5be0cd19ul);
+/** Whether the double SHA256 of a 64-byte block, read as a little-endian
+ * number, has a most significant word no greater than target[0]. */
+static uint32_t transform_sha256d64below_noasm(const struct sha256 in[2], const uint32_t target[1])
+{
+        return __builtin_bswap32(sha256d64_noasm(NULL, in, !0)) <= target[0];
 }
 
 typedef void (*transform_t)(uint32_t*, const unsigned char*, size_t);
 typedef void (*transform_multi_t)(struct sha256*, const uint32_t*, const unsigned char*);
 typedef void (*transform_d64_t)(struct sha256[], const struct sha256[]);
+typedef void (*transform_pbkdf2_t)(uint32_t*, uint32_t*, const uint32_t*, const uint32_t*, size_t);
+typedef void (*transform_d80_t)(struct sha256[], const unsigned char[]);
+typedef uint32_t (*transform_grind_t)(const struct sha256_grind*, uint32_t);
+typedef uint32_t (*transform_d64_below_t)(const struct sha256[], const uint32_t[]);
+typedef uint32_t (*transform_d80_below_t)(const unsigned char[], const uint32_t[]);
+typedef void (*transform_d32_t)(struct sha256[], const struct sha256[]);
 
 void transform_d64_wrapper(struct sha256 out[1], const struct sha256 in[2], transform_t tr)
 {
@@ -451,328 +496,1302 @@ void transform_sha256d64_armv8(struct sha256 out[1], const struct sha256 in[2])
 }
 #endif /* defined(__arm__) || defined(__aarch32__) || defined(__arm64__) || defined(__aarch64__) || defined(_M_ARM) */
 
-transform_t transform = transform_noasm;
-transform_multi_t transform_2way = NULL;
-transform_multi_t transform_4way = NULL;
-transform_multi_t transform_8way = NULL;
-transform_d64_t transform_d64 = transform_d64_noasm;
-transform_d64_t transform_d64_2way = NULL;
-transform_d64_t transform_d64_4way = NULL;
-transform_d64_t transform_d64_8way = NULL;
-
-#ifndef NDEBUG
-static int self_test(void) {
-        /* Input state (equal to the initial SHA256 state) */
-        static const uint32_t init[8] = {
-                0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul
-        };
-        /* Some random input data to test with */
-        static const unsigned char data[641] = "-" /* Intentionally not aligned */
-                "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
-                "eiusmod tempor incididunt ut labore et dolore magna aliqua. Et m"
-                "olestie ac feugiat sed lectus vestibulum mattis ullamcorper. Mor"
-                "bi blandit cursus risus at ultrices mi tempus imperdiet nulla. N"
-                "unc congue nisi vita suscipit tellus mauris. Imperdiet proin fer"
-                "mentum leo vel orci. Massa tempor nec feugiat nisl pretium fusce"
-                " id velit. Telus in metus vulputate eu scelerisque felis. Mi tem"
-                "pus imperdiet nulla malesuada pellentesque. Tristique magna sit.";
-        static const struct sha256* data_d64 = (const struct sha256*)&data[1];
-        /* Expected output state for hashing the i*64 first input bytes above (excluding SHA256 padding). */
-        static const uint32_t result[9][8] = {
-                {0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul},
-                {0x91f8ec6bul, 0x4da10fe3ul, 0x1c9c292cul, 0x45e18185ul, 0x435cc111ul, 0x3ca26f09ul, 0xeb954caeul, 0x402a7069ul},
-                {0xcabea5acul, 0x374fb97cul, 0x182ad996ul, 0x7bd69cbful, 0x450ff900ul, 0xc1d2be8aul, 0x6a41d505ul, 0xe6212dc3ul},
-                {0xbcff09d6ul, 0x3e76f36eul, 0x3ecb2501ul, 0x78866e97ul, 0xe1c1e2fdul, 0x32f4eafful, 0x8aa6c4e5ul, 0xdfc024bcul},
-                {0xa08c5d94ul, 0x0a862f93ul, 0x6b7f2f40ul, 0x8f9fae76ul, 0x6d40439ful, 0x79dcee0cul, 0x3e39ff3aul, 0xdc3bdbb1ul},
-                {0x216a0895ul, 0x9f1a3662ul, 0xe99946f9ul, 0x87ba4364ul, 0x0fb5db2cul, 0x12bed3d3ul, 0x6689c0c7ul, 0x292f1b04ul},
-                {0xca3067f8ul, 0xbc8c2656ul, 0x37cb7e0dul, 0x9b6b8b0ful, 0x46dc380bul, 0xf1287f57ul, 0xc42e4b23ul, 0x3fefe94dul},
-                {0x3e4c4039ul, 0xbb6fca8cul, 0x6f27d2f7ul, 0x301e44a4ul, 0x8352ba14ul, 0x5769ce37ul, 0x48a1155ful, 0xc0e1c4c6ul},
-                {0xfe2fa9ddul, 0x69d0862bul, 0x1ae0db23ul, 0x471f9244ul, 0xf55c0145ul, 0xc30f9c3bul, 0x40a84ea0ul, 0x5b8a266cul},
-        };
-        /* Expected output for each of the individual 8 64-byte messages under full double SHA256 (including padding). */
-        static const unsigned char result_d64[256] = {
-                0x09, 0x3a, 0xc4, 0xd0, 0x0f, 0xf7, 0x57, 0xe1, 0x72, 0x85, 0x79, 0x42, 0xfe, 0xe7, 0xe0, 0xa0,
-                0xfc, 0x52, 0xd7, 0xdb, 0x07, 0x63, 0x45, 0xfb, 0x53, 0x14, 0x7d, 0x17, 0x22, 0x86, 0xf0, 0x52,
-                0x48, 0xb6, 0x11, 0x9e, 0x6e, 0x48, 0x81, 0x6d, 0xcc, 0x57, 0x1f, 0xb2, 0x97, 0xa8, 0xd5, 0x25,
-                0x9b, 0x82, 0xaa, 0x89, 0xe2, 0xfd, 0x2d, 0x56, 0xe8, 0x28, 0x83, 0x0b, 0xe2, 0xfa, 0x53, 0xb7,
-                0xd6, 0x6b, 0x07, 0x85, 0x83, 0xb0, 0x10, 0xa2, 0xf5, 0x51, 0x3c, 0xf9, 0x60, 0x03, 0xab, 0x45,
-                0x6c, 0x15, 0x6e, 0xef, 0xb5, 0xac, 0x3e, 0x6c, 0xdf, 0xb4, 0x92, 0x22, 0x2d, 0xce, 0xbf, 0x3e,
-                0xe9, 0xe5, 0xf6, 0x29, 0x0e, 0x01, 0x4f, 0xd2, 0xd4, 0x45, 0x65, 0xb3, 0xbb, 0xf2, 0x4c, 0x16,
-                0x37, 0x50, 0x3c, 0x6e, 0x49, 0x8c, 0x5a, 0x89, 0x2b, 0x1b, 0xab, 0xc4, 0x37, 0xd1, 0x46, 0xe9,
-                0x3d, 0x0e, 0x85, 0xa2, 0x50, 0x73, 0xa1, 0x5e, 0x54, 0x37, 0xd7, 0x94, 0x17, 0x56, 0xc2, 0xd8,
-                0xe5, 0x9f, 0xed, 0x4e, 0xae, 0x15, 0x42, 0x06, 0x0d, 0x74, 0x74, 0x5e, 0x24, 0x30, 0xce, 0xd1,
-                0x9e, 0x50, 0xa3, 0x9a, 0xb8, 0xf0, 0x4a, 0x57, 0x69, 0x78, 0x67, 0x12, 0x84, 0x58, 0xbe, 0xc7,
-                0x36, 0xaa, 0xee, 0x7c, 0x64, 0xa3, 0x76, 0xec, 0xff, 0x55, 0x41, 0x00, 0x2a, 0x44, 0x68, 0x4d,
-                0xb6, 0x53, 0x9e, 0x1c, 0x95, 0xb7, 0xca, 0xdc, 0x7f, 0x7d, 0x74, 0x27, 0x5c, 0x8e, 0xa6, 0x84,
-                0xb5, 0xac, 0x87, 0xa9, 0xf3, 0xff, 0x75, 0xf2, 0x34, 0xcd, 0x1a, 0x3b, 0x82, 0x2c, 0x2b, 0x4e,
-                0x6a, 0x46, 0x30, 0xa6, 0x89, 0x86, 0x23, 0xac, 0xf8, 0xa5, 0x15, 0xe9, 0x0a, 0xaa, 0x1e, 0x9a,
-                0xd7, 0x93, 0x6b, 0x28, 0xe4, 0x3b, 0xfd, 0x59, 0xc6, 0xed, 0x7c, 0x5f, 0xa5, 0x41, 0xcb, 0x51
+/** The state after the first SHA256 of an 80-byte message. */
+static void transform_d80_first(uint32_t s[8], const unsigned char in[80], transform_t tr)
+{
+        /* The last 16 bytes of the message, padded. */
+        unsigned char buffer1[64] = {
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0x80
         };
+        memcpy(buffer1, in + 64, 16);
+        Initialize(s);
+        tr(s, in, 1);
+        tr(s, buffer1, 1);
+}
 
+/** Double SHA256 a single 80-byte message, such as a block header, with a
+ * generic transform. */
+static void transform_d80_wrapper(struct sha256 out[1], const unsigned char in[80], transform_t tr)
+{
+        unsigned char buffer2[64] = {
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+        };
+        uint32_t s[8];
         int i;
-
-        /* Test transform() for 0 through 8 transformations. */
-        for (i = 0; i <= 8; ++i) {
-                uint32_t state[8];
-                memcpy(state, init, 8 * sizeof(uint32_t));
-                transform(state, data + 1, i);
-                if (memcmp(state, result[i], 8 * sizeof(uint32_t))) return 0;
+        transform_d80_first(s, in, tr);
+        for (i = 0; i < 8; ++i) {
+                WriteBE32(buffer2 + 4 * i, s[i]);
         }
-
-        /* Test transform_d64 */
-        {
-            struct sha256 out[1];
-            transform_d64(out, data_d64);
-            if (memcmp(out, result_d64, 32)) return 0;
-        }
-
-        /* Test transform_d64_2way, if available. */
-        if (transform_d64_2way) {
-                struct sha256 out[2];
-                transform_d64_2way(out, data_d64);
-                if (memcmp(out, result_d64, 64)) return 0;
+        Initialize(s);
+        tr(s, buffer2, 1);
+        for (i = 0; i < 8; ++i) {
+                WriteBE32(&out->u8[4 * i], s[i]);
         }
+}
+static void transform_sha256d80_noasm(struct sha256 out[1], const unsigned char in[80])
+{
+        transform_d80_wrapper(out, in, transform_noasm);
+}
+static uint32_t transform_sha256d80below_noasm(const unsigned char in[80], const uint32_t target[1])
+{
+        uint32_t s[8];
+        transform_d80_first(s, in, transform_noasm);
+        return __builtin_bswap32(transform_d32_noasm(NULL, s, !0)) <= target[0];
+}
+#if defined(__x86_64__) || defined(__amd64__)
+static void transform_sha256d80_shani(struct sha256 out[1], const unsigned char in[80])
+{
+        transform_d80_wrapper(out, in, transform_sha256_shani);
+}
+static void transform_sha256d80_sse4(struct sha256 out[1], const unsigned char in[80])
+{
+        transform_d80_wrapper(out, in, transform_sha256_sse4);
+}
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+static void transform_sha256d80_armv8(struct sha256 out[1], const unsigned char in[80])
+{
+        transform_d80_wrapper(out, in, transform_sha256_armv8);
+}
+#endif /* defined(__aarch64__) */
 
-        /* Test transform_d64_4way, if available. */
-        if (transform_d64_4way) {
-                struct sha256 out[4];
-                transform_d64_4way(out, data_d64);
-                if (memcmp(out, result_d64, 128)) return 0;
+/** SHA256 a single 32-byte message, such as the first hash of a double SHA256,
+ * with a generic transform. */
+static void transform_d32_wrapper(struct sha256 out[1], const struct sha256 in[1], transform_t tr)
+{
+        unsigned char buffer[64] = {
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+        };
+        uint32_t s[8];
+        int i;
+        memcpy(buffer, in->u8, 32);
+        Initialize(s);
+        tr(s, buffer, 1);
+        for (i = 0; i < 8; ++i) {
+                WriteBE32(&out->u8[4 * i], s[i]);
         }
-
-        /* Test transform_d64_8way, if available. */
-        if (transform_d64_8way) {
-                struct sha256 out[8];
-                transform_d64_8way(out, data_d64);
-                if (memcmp(out, result_d64, 256)) return 0;
+}
+static void transform_sha256d32_noasm(struct sha256 out[1], const struct sha256 in[1])
+{
+        uint32_t s[8];
+        int i;
+        for (i = 0; i < 8; ++i) {
+                s[i] = ReadBE32(in->u8 + 4 * i);
         }
-
-        return !0;
+        transform_d32_noasm(out, s, 0);
 }
-#endif /* NDEBUG */
-
-#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
-/** Check whether the OS has enabled AVX registers. */
-static int AVXEnabled(void)
+#if defined(__x86_64__) || defined(__amd64__)
+static void transform_sha256d32_shani(struct sha256 out[1], const struct sha256 in[1])
 {
-        uint32_t a, d;
-        __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
-        return (a & 6) == 6;
+        transform_d32_wrapper(out, in, transform_sha256_shani);
 }
-#endif
+static void transform_sha256d32_sse4(struct sha256 out[1], const struct sha256 in[1])
+{
+        transform_d32_wrapper(out, in, transform_sha256_sse4);
+}
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+static void transform_sha256d32_armv8(struct sha256 out[1], const struct sha256 in[1])
+{
+        transform_d32_wrapper(out, in, transform_sha256_armv8);
+}
+#endif /* defined(__aarch64__) */
 
-const char* sha256_auto_detect(void)
+/** Whether a hash, read as a 256-bit little-endian number as Bitcoin does, is
+ * no greater than the target read the same way. */
+static int sha256_meets_target(const struct sha256* hash, const struct sha256* target)
 {
-        static char ret[255] = "standard";
-#if defined(HAVE_GETCPUID)
-        int have_sse4 = 0;
-        int have_xsave = 0;
-        int have_avx = 0;
-        int have_avx2 = 0;
-        int have_shani = 0;
-        int enabled_avx = 0;
+        int i;
+        for (i = 31; i >= 0; --i) {
+                if (hash->u8[i] != target->u8[i]) return hash->u8[i] < target->u8[i];
+        }
+        return !0;
+}
 
-        uint32_t eax=0, ebx=0, ecx=0, edx=0;
+/** The SHA-256 round constants. */
+static const uint32_t sha256_k[64] = {
+        0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul, 0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
+        0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul, 0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
+        0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul, 0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
+        0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul, 0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
+        0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul, 0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+        0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul, 0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
+        0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul, 0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
+        0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul, 0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul
+};
 
-        (void)AVXEnabled;
-        (void)have_sse4;
-        (void)have_avx;
-        (void)have_xsave;
-        (void)have_avx2;
-        (void)have_shani;
-        (void)enabled_avx;
+/** Precompute everything about a nonce search which does not depend on the
+ * nonce, as described at struct sha256_grind. */
+static void sha256_grind_init(struct sha256_grind* ctx, const uint32_t midstate[8], const unsigned char tail[64], size_t offset, const struct sha256* target, int twice)
+{
+        uint32_t s[8], t1, t2;
+        unsigned t;
 
-        GetCPUID(1, 0, &eax, &ebx, &ecx, &edx);
-        have_sse4 = (ecx >> 19) & 1;
-        have_xsave = (ecx >> 27) & 1;
-        have_avx = (ecx >> 28) & 1;
-        if (have_xsave && have_avx) {
-                enabled_avx = AVXEnabled();
+        assert(offset % 4 == 0 && offset <= 60);
+        memcpy(ctx->midstate, midstate, sizeof(ctx->midstate));
+        ctx->word = (unsigned)(offset / 4);
+        ctx->dep = (uint64_t)1 << ctx->word;
+        for (t = 0; t < 16; ++t) {
+                ctx->w[t] = t == ctx->word ? 0 : ReadBE32(tail + 4 * t);
         }
-        if (have_sse4) {
-                GetCPUID(7, 0, &eax, &ebx, &ecx, &edx);
-                have_avx2 = (ebx >> 5) & 1;
-                have_shani = (ebx >> 29) & 1;
+        for (t = 16; t < 64; ++t) {
+                ctx->w[t] = sigma1_noasm(ctx->w[t - 2]) + ctx->w[t - 7] + sigma0_noasm(ctx->w[t - 15]) + ctx->w[t - 16];
+                if (((ctx->dep >> (t - 2)) | (ctx->dep >> (t - 7)) | (ctx->dep >> (t - 15)) | (ctx->dep >> (t - 16))) & 1) {
+                        ctx->dep |= (uint64_t)1 << t;
+                }
+        }
+        for (t = 0; t < 64; ++t) {
+                ctx->kw[t] = sha256_k[t] + ctx->w[t];
         }
 
-#if !defined(BUILD_BITCOIN_INTERNAL)
-        if (have_shani) {
-                transform = transform_sha256_shani;
-                transform_d64 = transform_sha256d64_shani;
-                transform_d64_2way = transform_sha256d64_shani_2way;
-                strcpy(ret, "shani(1way,2way)");
-                have_sse4 = 0; /* Disable SSE4/AVX2; */
-                have_avx2 = 0;
+        memcpy(s, midstate, sizeof(s));
+        for (t = 0; t < ctx->word; ++t) {
+                t1 = s[7] + Sigma1_noasm(s[4]) + Ch_noasm(s[4], s[5], s[6]) + ctx->kw[t];
+                t2 = Sigma0_noasm(s[0]) + Maj_noasm(s[0], s[1], s[2]);
+                memmove(s + 1, s, 7 * sizeof(uint32_t));
+                s[4] += t1;
+                s[0] = t1 + t2;
+        }
+        for (t = 0; t < 8; ++t) {
+                ctx->state[t] = s[(t + ctx->word) % 8];
         }
-#endif
 
-        if (have_sse4) {
+        ctx->target = ReadLE32(target->u8 + 28);
+        ctx->twice = twice;
+}
+
+/** Compute the final state for one nonce of a search in full, with a generic
+ * transform.  The nonce is written into block, which holds the tail. */
+static void sha256_grind_hash(uint32_t s[8], const struct sha256_grind* ctx, unsigned char block[64], uint32_t nonce, transform_t tr)
+{
+        unsigned char buffer2[64] = {
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+        };
+        int i;
+        WriteLE32(block + 4 * ctx->word, nonce);
+        memcpy(s, ctx->midstate, 8 * sizeof(uint32_t));
+        tr(s, block, 1);
+        if (ctx->twice) {
+                for (i = 0; i < 8; ++i) {
+                        WriteBE32(buffer2 + 4 * i, s[i]);
+                }
+                Initialize(s);
+                tr(s, buffer2, 1);
+        }
+}
+
+/** Run the PBKDF2-HMAC-SHA256 loop in a single lane with a generic transform.
+ * Each iteration hashes u, as a 32-byte message, from the inner midstate and
+ * then the result from the outer midstate, and XORs the new u into f. */
+static void transform_pbkdf2_wrapper(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations, transform_t tr)
+{
+        /* A 32-byte message after the 64-byte key block, padded. */
+        unsigned char block[64] = {
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0
+        };
+        uint32_t s[8];
+        int i;
+        for (; iterations; --iterations) {
+                for (i = 0; i < 8; ++i) {
+                        WriteBE32(block + 4 * i, u[i]);
+                }
+                memcpy(s, inner, sizeof(s));
+                tr(s, block, 1);
+                for (i = 0; i < 8; ++i) {
+                        WriteBE32(block + 4 * i, s[i]);
+                }
+                memcpy(s, outer, sizeof(s));
+                tr(s, block, 1);
+                for (i = 0; i < 8; ++i) {
+                        u[i] = s[i];
+                        f[i] ^= s[i];
+                }
+        }
+}
+static void transform_sha256pbkdf2_noasm(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        transform_pbkdf2_wrapper(f, u, inner, outer, iterations, transform_noasm);
+}
 #if defined(__x86_64__) || defined(__amd64__)
-                transform = transform_sha256_sse4;
-                transform_d64 = transform_sha256d64_sse4;
-                strcpy(ret, "sse4(1way)");
+static void transform_sha256pbkdf2_shani(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        transform_pbkdf2_wrapper(f, u, inner, outer, iterations, transform_sha256_shani);
+}
+static void transform_sha256pbkdf2_sse4(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        transform_pbkdf2_wrapper(f, u, inner, outer, iterations, transform_sha256_sse4);
+}
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+static void transform_sha256pbkdf2_armv8(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        transform_pbkdf2_wrapper(f, u, inner, outer, iterations, transform_sha256_armv8);
+}
+#endif /* defined(__aarch64__) */
+
+/** A complete selection of backend implementations. */
+struct sha256_dispatch {
+        transform_t transform;
+        transform_multi_t transform_2way;
+        transform_multi_t transform_4way;
+        transform_multi_t transform_8way;
+        transform_multi_t transform_16way;
+        transform_d64_t transform_d64;
+        transform_d64_t transform_d64_2way;
+        transform_d64_t transform_d64_4way;
+        transform_d64_t transform_d64_8way;
+        transform_d64_t transform_d64_16way;
+        /* Lanes of the PBKDF2-HMAC-SHA256 inner loop, each with its own
+         * key, in the layout described at sha256_pbkdf2_iterate(). */
+        transform_pbkdf2_t transform_pbkdf2;
+        transform_pbkdf2_t transform_pbkdf2_2way;
+        transform_pbkdf2_t transform_pbkdf2_4way;
+        transform_pbkdf2_t transform_pbkdf2_8way;
+        transform_pbkdf2_t transform_pbkdf2_16way;
+        /* Double SHA256 of 80-byte messages, such as block headers. */
+        transform_d80_t transform_d80;
+        transform_d80_t transform_d80_2way;
+        transform_d80_t transform_d80_4way;
+        transform_d80_t transform_d80_8way;
+        transform_d80_t transform_d80_16way;
+        /* Nonce searches, returning the mask of lanes whose hash may meet
+         * the target.  Without them, each nonce is hashed with transform. */
+        transform_grind_t transform_grind_4way;
+        transform_grind_t transform_grind_8way;
+        transform_grind_t transform_grind_16way;
+        /* Double SHA256 of 64-byte blocks and of headers which stops at the
+         * last word of each hash, returning the mask of lanes where it is no
+         * greater than the lane's target word.  Where they are missing, the
+         * hashes are computed in full. */
+        transform_d64_below_t transform_d64below;
+        transform_d64_below_t transform_d64below_4way;
+        transform_d64_below_t transform_d64below_8way;
+        transform_d64_below_t transform_d64below_16way;
+        transform_d80_below_t transform_d80below;
+        transform_d80_below_t transform_d80below_4way;
+        transform_d80_below_t transform_d80below_8way;
+        transform_d80_below_t transform_d80below_16way;
+        /* SHA256 of 32-byte messages, which is the second hash of a double
+         * SHA256 of a message of any length.  The 1-way kernel is required. */
+        transform_d32_t transform_d32;
+        transform_d32_t transform_d32_4way;
+        transform_d32_t transform_d32_8way;
+        transform_d32_t transform_d32_16way;
+        /* The lane count of the multi-buffer kernel.  A single lane uses
+         * transform directly. */
+        unsigned mb_lanes;
+        /* The string returned by sha256_auto_detect(). */
+        const char* name;
+        /* A short identifier for the backend. */
+        const char* id;
+};
+
+/* The backend combinations which may be selected at runtime.  Each one is a
+ * fixed set of kernels, so that the public entry points can be specialised
+ * for it.  They are listed in increasing order of preference. */
+enum sha256_backend {
+        SHA256_BACKEND_NOASM,
+#if defined(SHA256_VEC)
+        SHA256_BACKEND_VEC,
 #endif
+#if defined(__x86_64__) || defined(__amd64__)
+        SHA256_BACKEND_SSE4,
 #if !defined(BUILD_BITCOIN_INTERNAL)
-                transform_4way = transform_sha256multi_sse41_4way;
-                transform_d64_4way = transform_sha256d64_sse41_4way;
-                strcat(ret, ",sse41(4way)");
+        SHA256_BACKEND_AVX2,
+#if defined(ENABLE_AVX2_BMI2)
+        SHA256_BACKEND_AVX2_RORX,
 #endif
-    }
-
-#if !defined(BUILD_BITCOIN_INTERNAL)
-        if (have_avx2 && have_avx && enabled_avx) {
-                transform_8way = transform_sha256multi_avx2_8way;
-                transform_d64_8way = transform_sha256d64_avx2_8way;
-                strcat(ret, ",avx2(8way)");
-        }
+#if defined(ENABLE_AVX512)
+        SHA256_BACKEND_AVX512,
+#if defined(ENABLE_AVX2_BMI2)
+        SHA256_BACKEND_AVX512_RORX,
 #endif
-
-#elif defined(__aarch64__)
-        int have_arm_shani = 0;
-
-#if defined(__linux__)
-#if defined(__arm__) /* 32-bit */
-        if (getauxval(AT_HWCAP2) & HWCAP2_SHA2) {
-                have_arm_shani = !0;
-        }
 #endif
-#if defined(__aarch64__) /* 64-bit */
-        if (getauxval(AT_HWCAP) & HWCAP_SHA2) {
-                have_arm_shani = !0;
-        }
+        SHA256_BACKEND_SHANI,
+#if defined(ENABLE_AVX512)
+        SHA256_BACKEND_SHANI_AVX512,
 #endif
+#endif /* !defined(BUILD_BITCOIN_INTERNAL) */
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+        SHA256_BACKEND_NEON,
+        SHA256_BACKEND_ARMV8,
 #endif
+        SHA256_BACKEND_COUNT
+};
 
-#if defined(__APPLE__)
-        int val = 0;
-        size_t len = sizeof(val);
-        if (sysctlbyname("hw.optional.arm.FEAT_SHA256", &val, &len, NULL, 0) == 0) {
-                have_arm_shani = !0;
-        }
+/* Indexed by enum sha256_backend. */
+static const struct sha256_dispatch dispatch_tables[SHA256_BACKEND_COUNT] = {
+        {
+                transform_noasm, NULL, NULL, NULL, NULL,
+                transform_d64_noasm, NULL, NULL, NULL, NULL,
+                transform_sha256pbkdf2_noasm, NULL, NULL, NULL, NULL,
+                transform_sha256d80_noasm, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL,
+                transform_sha256d64below_noasm, NULL, NULL, NULL,
+                transform_sha256d80below_noasm, NULL, NULL, NULL,
+                transform_sha256d32_noasm, NULL, NULL, NULL,
+                1, "standard", "noasm"
+        },
+#if defined(SHA256_VEC)
+        {
+                transform_noasm, NULL, transform_sha256multi_vec_4way, transform_sha256multi_vec_8way, NULL,
+                transform_d64_noasm, NULL, transform_sha256d64_vec_4way, transform_sha256d64_vec_8way, NULL,
+                transform_sha256pbkdf2_noasm, NULL, NULL, NULL, NULL,
+                transform_sha256d80_noasm, NULL, transform_sha256d80_vec_4way, transform_sha256d80_vec_8way, NULL,
+                NULL, NULL, NULL,
+                transform_sha256d64below_noasm, transform_sha256d64below_vec_4way, transform_sha256d64below_vec_8way, NULL,
+                transform_sha256d80below_noasm, transform_sha256d80below_vec_4way, transform_sha256d80below_vec_8way, NULL,
+                transform_sha256d32_noasm, transform_sha256d32_vec_4way, transform_sha256d32_vec_8way, NULL,
+                1, "standard(1way),vec(4way,8way)", "vec"
+        },
 #endif
-
-        if (have_arm_shani) {
-                transform = transform_sha256_armv8;
-                transform_d64 = transform_sha256d64_armv8;
-                transform_d64_2way = transform_sha256d64_armv8_2way;
-                strcpy(ret, "armv8(1way,2way)");
-        }
+#if defined(__x86_64__) || defined(__amd64__)
+#if defined(BUILD_BITCOIN_INTERNAL)
+        {
+                transform_sha256_sse4, NULL, NULL, NULL, NULL,
+                transform_sha256d64_sse4, NULL, NULL, NULL, NULL,
+                transform_sha256pbkdf2_sse4, NULL, NULL, NULL, NULL,
+                transform_sha256d80_sse4, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                transform_sha256d32_sse4, NULL, NULL, NULL,
+                1, "sse4(1way)", "sse4"
+        },
+#else
+        {
+                transform_sha256_sse4, NULL, transform_sha256multi_sse41_4way, NULL, NULL,
+                transform_sha256d64_sse4, NULL, transform_sha256d64_sse41_4way, NULL, NULL,
+                transform_sha256pbkdf2_sse4, NULL, transform_sha256pbkdf2_sse41_4way, NULL, NULL,
+                transform_sha256d80_sse4, NULL, transform_sha256d80_sse41_4way, NULL, NULL,
+                transform_sha256grind_sse41_4way, NULL, NULL,
+                NULL, transform_sha256d64below_sse41_4way, NULL, NULL,
+                NULL, transform_sha256d80below_sse41_4way, NULL, NULL,
+                transform_sha256d32_sse4, transform_sha256d32_sse41_4way, NULL, NULL,
+                4, "sse4(1way),sse41(4way)", "sse4"
+        },
+        {
+                transform_sha256_sse4, NULL, transform_sha256multi_sse41_4way, transform_sha256multi_avx2_8way, NULL,
+                transform_sha256d64_sse4, NULL, transform_sha256d64_sse41_4way, transform_sha256d64_avx2_8way, NULL,
+                transform_sha256pbkdf2_sse4, NULL, transform_sha256pbkdf2_sse41_4way, transform_sha256pbkdf2_avx2_8way, NULL,
+                transform_sha256d80_sse4, NULL, transform_sha256d80_sse41_4way, transform_sha256d80_avx2_8way, NULL,
+                transform_sha256grind_sse41_4way, transform_sha256grind_avx2_8way, NULL,
+                NULL, transform_sha256d64below_sse41_4way, transform_sha256d64below_avx2_8way, NULL,
+                NULL, transform_sha256d80below_sse41_4way, transform_sha256d80below_avx2_8way, NULL,
+                transform_sha256d32_sse4, transform_sha256d32_sse41_4way, transform_sha256d32_avx2_8way, NULL,
+                8, "sse4(1way),sse41(4way),avx2(8way)", "avx2"
+        },
+#if defined(ENABLE_AVX2_BMI2)
+        {
+                transform_sha256_avx2_rorx, NULL, transform_sha256multi_sse41_4way, transform_sha256multi_avx2_8way, NULL,
+                transform_sha256d64_sse4, NULL, transform_sha256d64_sse41_4way, transform_sha256d64_avx2_8way, NULL,
+                transform_sha256pbkdf2_sse4, NULL, transform_sha256pbkdf2_sse41_4way, transform_sha256pbkdf2_avx2_8way, NULL,
+                transform_sha256d80_sse4, NULL, transform_sha256d80_sse41_4way, transform_sha256d80_avx2_8way, NULL,
+                transform_sha256grind_sse41_4way, transform_sha256grind_avx2_8way, NULL,
+                NULL, transform_sha256d64below_sse41_4way, transform_sha256d64below_avx2_8way, NULL,
+                NULL, transform_sha256d80below_sse41_4way, transform_sha256d80below_avx2_8way, NULL,
+                transform_sha256d32_sse4, transform_sha256d32_sse41_4way, transform_sha256d32_avx2_8way, NULL,
+                8, "avx2+bmi2(1way),sse41(4way),avx2(8way)", "avx2_rorx"
+        },
+#endif
+#if defined(ENABLE_AVX512)
+        {
+                transform_sha256_sse4, NULL, transform_sha256multi_sse41_4way, transform_sha256multi_avx2_8way, transform_sha256multi_avx512_16way,
+                transform_sha256d64_sse4, NULL, transform_sha256d64_sse41_4way, transform_sha256d64_avx2_8way, transform_sha256d64_avx512_16way,
+                transform_sha256pbkdf2_sse4, NULL, transform_sha256pbkdf2_sse41_4way, transform_sha256pbkdf2_avx2_8way, transform_sha256pbkdf2_avx512_16way,
+                transform_sha256d80_sse4, NULL, transform_sha256d80_sse41_4way, transform_sha256d80_avx2_8way, transform_sha256d80_avx512_16way,
+                transform_sha256grind_sse41_4way, transform_sha256grind_avx2_8way, transform_sha256grind_avx512_16way,
+                NULL, transform_sha256d64below_sse41_4way, transform_sha256d64below_avx2_8way, transform_sha256d64below_avx512_16way,
+                NULL, transform_sha256d80below_sse41_4way, transform_sha256d80below_avx2_8way, transform_sha256d80below_avx512_16way,
+                transform_sha256d32_sse4, transform_sha256d32_sse41_4way, transform_sha256d32_avx2_8way, transform_sha256d32_avx512_16way,
+                16, "sse4(1way),sse41(4way),avx2(8way),avx512(16way)", "avx512"
+        },
+#if defined(ENABLE_AVX2_BMI2)
+        /* As above, with the BMI2 1-way transform.  Every CPU with AVX-512
+         * has BMI2, but a hypervisor may hide it, so both are kept. */
+        {
+                transform_sha256_avx2_rorx, NULL, transform_sha256multi_sse41_4way, transform_sha256multi_avx2_8way, transform_sha256multi_avx512_16way,
+                transform_sha256d64_sse4, NULL, transform_sha256d64_sse41_4way, transform_sha256d64_avx2_8way, transform_sha256d64_avx512_16way,
+                transform_sha256pbkdf2_sse4, NULL, transform_sha256pbkdf2_sse41_4way, transform_sha256pbkdf2_avx2_8way, transform_sha256pbkdf2_avx512_16way,
+                transform_sha256d80_sse4, NULL, transform_sha256d80_sse41_4way, transform_sha256d80_avx2_8way, transform_sha256d80_avx512_16way,
+                transform_sha256grind_sse41_4way, transform_sha256grind_avx2_8way, transform_sha256grind_avx512_16way,
+                NULL, transform_sha256d64below_sse41_4way, transform_sha256d64below_avx2_8way, transform_sha256d64below_avx512_16way,
+                NULL, transform_sha256d80below_sse41_4way, transform_sha256d80below_avx2_8way, transform_sha256d80below_avx512_16way,
+                transform_sha256d32_sse4, transform_sha256d32_sse41_4way, transform_sha256d32_avx2_8way, transform_sha256d32_avx512_16way,
+                16, "avx2+bmi2(1way),sse41(4way),avx2(8way),avx512(16way)", "avx512_rorx"
+        },
+#endif
+#endif
+        {
+                transform_sha256_shani, transform_sha256multi_shani_2way, transform_sha256multi_shani_4way, NULL, NULL,
+                transform_sha256d64_shani, transform_sha256d64_shani_2way, NULL, NULL, NULL,
+                transform_sha256pbkdf2_shani, transform_sha256pbkdf2_shani_2way, NULL, NULL, NULL,
+                transform_sha256d80_shani, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                transform_sha256d32_shani, NULL, NULL, NULL,
+                1, "shani(1way,2way,4way)", "shani"
+        },
+#if defined(ENABLE_AVX512)
+        /* Unlike AVX2, the 16-way kernels are used even when SHA-NI is
+         * available, as they process multiple hashes at a much higher rate
+         * than the 2-way SHA-NI kernel on every CPU which supports both. */
+        {
+                transform_sha256_shani, transform_sha256multi_shani_2way, transform_sha256multi_shani_4way, NULL, transform_sha256multi_avx512_16way,
+                transform_sha256d64_shani, transform_sha256d64_shani_2way, NULL, NULL, transform_sha256d64_avx512_16way,
+                transform_sha256pbkdf2_shani, transform_sha256pbkdf2_shani_2way, NULL, NULL, transform_sha256pbkdf2_avx512_16way,
+                transform_sha256d80_shani, NULL, NULL, NULL, transform_sha256d80_avx512_16way,
+                NULL, NULL, transform_sha256grind_avx512_16way,
+                NULL, NULL, NULL, transform_sha256d64below_avx512_16way,
+                NULL, NULL, NULL, transform_sha256d80below_avx512_16way,
+                transform_sha256d32_shani, NULL, NULL, transform_sha256d32_avx512_16way,
+                16, "shani(1way,2way,4way),avx512(16way)", "shani_avx512"
+        },
 #endif
+#endif /* !defined(BUILD_BITCOIN_INTERNAL) */
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+        {
+                transform_noasm, NULL, transform_sha256multi_neon_4way, NULL, NULL,
+                transform_d64_noasm, NULL, transform_sha256d64_neon_4way, NULL, NULL,
+                transform_sha256pbkdf2_noasm, NULL, NULL, NULL, NULL,
+                transform_sha256d80_noasm, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL,
+                transform_sha256d64below_noasm, transform_sha256d64below_neon_4way, NULL, NULL,
+                transform_sha256d80below_noasm, NULL, NULL, NULL,
+                transform_sha256d32_noasm, NULL, NULL, NULL,
+                1, "standard(1way),neon(4way)", "neon"
+        },
+        {
+                transform_sha256_armv8, transform_sha256multi_armv8_2way, transform_sha256multi_armv8_4way, NULL, NULL,
+                transform_sha256d64_armv8, transform_sha256d64_armv8_2way, transform_sha256d64_armv8_4way, NULL, NULL,
+                transform_sha256pbkdf2_armv8, NULL, NULL, NULL, NULL,
+                transform_sha256d80_armv8, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL,
+                transform_sha256d32_armv8, NULL, NULL, NULL,
+                1, "armv8(1way,2way,4way)", "armv8"
+        },
+#endif
+};
 
-        assert(self_test());
-        return ret;
-}
+/* The backend is selected on the first call into the library which needs it,
+ * and after the self-test the chosen table is published by a release store to
+ * dispatch, exactly once.  Thereafter every call costs a single acquire load,
+ * which is an ordinary load on x86 and needs no fence elsewhere. */
+#define DISPATCH_NONE 0
+#define DISPATCH_BUSY 1
+#define DISPATCH_DONE 2
+static int dispatch_state = DISPATCH_NONE;
+static const struct sha256_dispatch* dispatch = NULL;
 
-/* SHA-256 */
+static const struct sha256_dispatch* sha256_dispatch_init(void);
 
-void sha256_init(struct sha256_ctx* ctx)
+/** Return the published dispatch table, running detection on first use. */
+static inline __attribute__((always_inline)) const struct sha256_dispatch* get_dispatch(void)
 {
-        assert(ctx);
-        ctx->bytes = 0;
-        Initialize(ctx->s);
+        const struct sha256_dispatch* d = __atomic_load_n(&dispatch, __ATOMIC_ACQUIRE);
+        if (__builtin_expect(d == NULL, 0)) {
+                d = sha256_dispatch_init();
+        }
+        return d;
 }
 
-void sha256_update(struct sha256_ctx* ctx, const void *_data, size_t len)
+/** Hash the given number of blocks in every lane of the manager. */
+static void sha256_mb_transform(const struct sha256_dispatch* d, struct sha256_mb_mgr* mgr, size_t blocks)
 {
-        const unsigned char* data = (const unsigned char*)_data;
-        const unsigned char* end = data + len;
-        size_t bufsize = ctx->bytes % 64;
-        if (bufsize && bufsize + len >= 64) {
-                /* Fill the buffer, and process it. */
-                memcpy(ctx->buf.u8 + bufsize, data, 64 - bufsize);
-                ctx->bytes += 64 - bufsize;
-                data += 64 - bufsize;
-                transform(ctx->s, ctx->buf.u8, 1);
-                bufsize = 0;
-        }
-        if (end - data >= 64) {
-                size_t blocks = (end - data) / 64;
-                transform(ctx->s, data, blocks);
-                data += 64 * blocks;
-                ctx->bytes += 64 * blocks;
-        }
-        if (end > data) {
-                /* Fill the buffer with what remains. */
-                memcpy(ctx->buf.u8 + bufsize, data, end - data);
-                ctx->bytes += end - data;
+        switch (mgr->lanes) {
+#if defined(ENABLE_AVX512) && !defined(BUILD_BITCOIN_INTERNAL)
+        case 16:
+                transform_sha256mb_avx512_16way(mgr->s, mgr->ptr, blocks);
+                break;
+#endif
+#if (defined(__x86_64__) || defined(__amd64__)) && !defined(BUILD_BITCOIN_INTERNAL)
+        case 8:
+                transform_sha256mb_avx2_8way(mgr->s, mgr->ptr, blocks);
+                break;
+        case 4:
+                transform_sha256mb_sse41_4way(mgr->s, mgr->ptr, blocks);
+                break;
+#endif
+        default:
+                d->transform(mgr->s, mgr->ptr[0], blocks);
+                break;
         }
 }
 
-void sha256_done(struct sha256* hash, struct sha256_ctx* ctx)
+#ifndef NDEBUG
+static int self_test_multi(transform_t tr1, transform_multi_t tr, int lanes, const uint32_t init[8], const unsigned char* in)
 {
-        static const unsigned char pad[64] = {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        unsigned char sizedesc[8];
-        WriteBE64(sizedesc, ctx->bytes << 3);
-        sha256_update(ctx, pad, 1 + ((119 - (ctx->bytes % 64)) % 64));
-        sha256_update(ctx, sizedesc, 8);
-        WriteBE32(&hash->u8[0], ctx->s[0]);
-        WriteBE32(&hash->u8[4], ctx->s[1]);
-        WriteBE32(&hash->u8[8], ctx->s[2]);
-        WriteBE32(&hash->u8[12], ctx->s[3]);
-        WriteBE32(&hash->u8[16], ctx->s[4]);
-        WriteBE32(&hash->u8[20], ctx->s[5]);
-        WriteBE32(&hash->u8[24], ctx->s[6]);
-        WriteBE32(&hash->u8[28], ctx->s[7]);
+        struct sha256 out[16];
+        int i, j;
+        tr(out, init, in);
+        for (i = 0; i < lanes; ++i) {
+                uint32_t state[8];
+                memcpy(state, init, 8 * sizeof(uint32_t));
+                tr1(state, in + 64 * i, 1);
+                for (j = 0; j < 8; ++j) {
+                        if (ReadBE32(&out[i].u8[4 * j]) != state[j]) return 0;
+                }
+        }
+        return !0;
 }
 
-void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t blocks)
+static int self_test_pbkdf2(transform_pbkdf2_t tr1, transform_pbkdf2_t tr, int lanes, const uint32_t key[9][8], const unsigned char* in)
 {
-        if (transform_d64_8way) {
-                while (blocks >= 8) {
-                        transform_d64_8way(out, in);
-                        out += 8;
-                        in += 16;
-                        blocks -= 8;
-                }
-        }
-        if (transform_d64_4way) {
-                while (blocks >= 4) {
-                        transform_d64_4way(out, in);
-                        out += 4;
-                        in += 8;
-                        blocks -= 4;
+        uint32_t f[16 * 8] = {0}, u[16 * 8] = {0}, inner[16 * 8] = {0}, outer[16 * 8] = {0};
+        uint32_t f1[8], u1[8];
+        int i, j;
+        for (i = 0; i < lanes; ++i) {
+                memcpy(inner + 8 * i, key[i % 9], sizeof(f1));
+                memcpy(outer + 8 * i, key[(i + 4) % 9], sizeof(f1));
+                for (j = 0; j < 8; ++j) {
+                        f[8 * i + j] = ReadBE32(in + 32 * i + 4 * j);
+                        u[8 * i + j] = ReadBE32(in + 32 * i + 4 * j + 16);
                 }
         }
-        if (transform_d64_2way) {
-                while (blocks >= 2) {
-                        transform_d64_2way(out, in);
-                        out += 2;
-                        in += 4;
-                        blocks -= 2;
+        tr(f, u, inner, outer, 2);
+        for (i = 0; i < lanes; ++i) {
+                for (j = 0; j < 8; ++j) {
+                        f1[j] = ReadBE32(in + 32 * i + 4 * j);
+                        u1[j] = ReadBE32(in + 32 * i + 4 * j + 16);
                 }
+                tr1(f1, u1, key[i % 9], key[(i + 4) % 9], 2);
+                if (memcmp(f + 8 * i, f1, sizeof(f1)) || memcmp(u + 8 * i, u1, sizeof(u1))) return 0;
         }
-        while (blocks) {
-                transform_d64(out, in);
-                ++out;
-                in += 2;
-                --blocks;
+        return !0;
+}
+
+static int self_test_d80(transform_d80_t tr1, transform_d80_t tr, int lanes, const unsigned char* in)
+{
+        struct sha256 out[16], out1;
+        int i;
+        tr(out, in);
+        for (i = 0; i < lanes; ++i) {
+                tr1(&out1, in + 80 * i);
+                if (memcmp(&out[i], &out1, sizeof(out1))) return 0;
         }
+        return !0;
 }
 
-void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks)
+/* Test an early-exit kernel against the full 1-way kernel, with alternate
+ * lanes' targets set to just meet and just miss the last word of the hash. */
+static int self_test_d64below(transform_d64_t tr1, transform_d64_below_t tr, int lanes, const struct sha256* in)
 {
-        if (transform_8way) {
-                while (blocks >= 8) {
-                        transform_8way(out, midstate, in);
-                        out += 8;
-                        in += 512;
-                        blocks -= 8;
-                }
+        struct sha256 out;
+        uint32_t top[16], target[16] = {0}, mask;
+        int i;
+        for (i = 0; i < lanes; ++i) {
+                tr1(&out, in + 2 * i);
+                top[i] = ReadLE32(out.u8 + 28);
+                target[i] = top[i] - (uint32_t)(i & 1);
         }
-        if (transform_4way) {
-                while (blocks >= 4) {
-                        transform_4way(out, midstate, in);
-                        out += 4;
-                        in += 256;
+        mask = tr(in, target);
+        if (mask >> lanes) return 0;
+        for (i = 0; i < lanes; ++i) {
+                if (((mask >> i) & 1) != (top[i] <= target[i])) return 0;
+        }
+        return !0;
+}
+
+static int self_test_d80below(transform_d80_t tr1, transform_d80_below_t tr, int lanes, const unsigned char* in)
+{
+        struct sha256 out;
+        uint32_t top[16], target[16] = {0}, mask;
+        int i;
+        for (i = 0; i < lanes; ++i) {
+                tr1(&out, in + 80 * i);
+                top[i] = ReadLE32(out.u8 + 28);
+                target[i] = top[i] - (uint32_t)(i & 1);
+        }
+        mask = tr(in, target);
+        if (mask >> lanes) return 0;
+        for (i = 0; i < lanes; ++i) {
+                if (((mask >> i) & 1) != (top[i] <= target[i])) return 0;
+        }
+        return !0;
+}
+
+/* Test a 32-byte kernel against the 1-way transform of each padded message. */
+static int self_test_d32(transform_t tr1, transform_d32_t tr, int lanes, const struct sha256* in)
+{
+        unsigned char block[64];
+        struct sha256 out[16];
+        uint32_t s[8];
+        int i, j;
+        memset(block, 0, sizeof(block));
+        block[32] = 0x80;
+        block[62] = 1;
+        tr(out, in);
+        for (i = 0; i < lanes; ++i) {
+                memcpy(block, in + i, 32);
+                Initialize(s);
+                tr1(s, block, 1);
+                for (j = 0; j < 8; ++j) {
+                        if (ReadBE32(out[i].u8 + 4 * j) != s[j]) return 0;
+                }
+        }
+        return !0;
+}
+
+static int self_test_grind(transform_t tr1, transform_grind_t tr, int lanes, const uint32_t midstate[8], const unsigned char* in)
+{
+        struct sha256_grind ctx;
+        struct sha256 target;
+        unsigned char block[64];
+        uint32_t mask, s[8];
+        int twice, i;
+        size_t offset;
+        memset(&target, 0, sizeof(target));
+        WriteLE32(target.u8 + 28, 0x80000000ul);
+        for (twice = 0; twice < 2; ++twice) {
+                for (offset = 0; offset < 64; offset += 20) {
+                        sha256_grind_init(&ctx, midstate, in, offset, &target, twice);
+                        memcpy(block, in, sizeof(block));
+                        mask = tr(&ctx, 0xfffffffaul);
+                        if (mask >> lanes) return 0;
+                        for (i = 0; i < lanes; ++i) {
+                                sha256_grind_hash(s, &ctx, block, 0xfffffffaul + (uint32_t)i, tr1);
+                                if (((mask >> i) & 1) != (__builtin_bswap32(s[7]) <= ctx.target)) return 0;
+                        }
+                }
+        }
+        return !0;
+}
+
+static int self_test(const struct sha256_dispatch* d) {
+        /* Input state (equal to the initial SHA256 state) */
+        static const uint32_t init[8] = {
+                0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul
+        };
+        /* Some random input data to test with */
+        static const unsigned char data[641] = "-" /* Intentionally not aligned */
+                "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+                "eiusmod tempor incididunt ut labore et dolore magna aliqua. Et m"
+                "olestie ac feugiat sed lectus vestibulum mattis ullamcorper. Mor"
+                "bi blandit cursus risus at ultrices mi tempus imperdiet nulla. N"
+                "unc congue nisi vita suscipit tellus mauris. Imperdiet proin fer"
+                "mentum leo vel orci. Massa tempor nec feugiat nisl pretium fusce"
+                " id velit. Telus in metus vulputate eu scelerisque felis. Mi tem"
+                "pus imperdiet nulla malesuada pellentesque. Tristique magna sit.";
+        static const struct sha256* data_d64 = (const struct sha256*)&data[1];
+        /* Expected output state for hashing the i*64 first input bytes above (excluding SHA256 padding). */
+        static const uint32_t result[9][8] = {
+                {0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul},
+                {0x91f8ec6bul, 0x4da10fe3ul, 0x1c9c292cul, 0x45e18185ul, 0x435cc111ul, 0x3ca26f09ul, 0xeb954caeul, 0x402a7069ul},
+                {0xcabea5acul, 0x374fb97cul, 0x182ad996ul, 0x7bd69cbful, 0x450ff900ul, 0xc1d2be8aul, 0x6a41d505ul, 0xe6212dc3ul},
+                {0xbcff09d6ul, 0x3e76f36eul, 0x3ecb2501ul, 0x78866e97ul, 0xe1c1e2fdul, 0x32f4eafful, 0x8aa6c4e5ul, 0xdfc024bcul},
+                {0xa08c5d94ul, 0x0a862f93ul, 0x6b7f2f40ul, 0x8f9fae76ul, 0x6d40439ful, 0x79dcee0cul, 0x3e39ff3aul, 0xdc3bdbb1ul},
+                {0x216a0895ul, 0x9f1a3662ul, 0xe99946f9ul, 0x87ba4364ul, 0x0fb5db2cul, 0x12bed3d3ul, 0x6689c0c7ul, 0x292f1b04ul},
+                {0xca3067f8ul, 0xbc8c2656ul, 0x37cb7e0dul, 0x9b6b8b0ful, 0x46dc380bul, 0xf1287f57ul, 0xc42e4b23ul, 0x3fefe94dul},
+                {0x3e4c4039ul, 0xbb6fca8cul, 0x6f27d2f7ul, 0x301e44a4ul, 0x8352ba14ul, 0x5769ce37ul, 0x48a1155ful, 0xc0e1c4c6ul},
+                {0xfe2fa9ddul, 0x69d0862bul, 0x1ae0db23ul, 0x471f9244ul, 0xf55c0145ul, 0xc30f9c3bul, 0x40a84ea0ul, 0x5b8a266cul},
+        };
+        /* Expected output for each of the individual 8 64-byte messages under full double SHA256 (including padding). */
+        static const unsigned char result_d64[256] = {
+                0x09, 0x3a, 0xc4, 0xd0, 0x0f, 0xf7, 0x57, 0xe1, 0x72, 0x85, 0x79, 0x42, 0xfe, 0xe7, 0xe0, 0xa0,
+                0xfc, 0x52, 0xd7, 0xdb, 0x07, 0x63, 0x45, 0xfb, 0x53, 0x14, 0x7d, 0x17, 0x22, 0x86, 0xf0, 0x52,
+                0x48, 0xb6, 0x11, 0x9e, 0x6e, 0x48, 0x81, 0x6d, 0xcc, 0x57, 0x1f, 0xb2, 0x97, 0xa8, 0xd5, 0x25,
+                0x9b, 0x82, 0xaa, 0x89, 0xe2, 0xfd, 0x2d, 0x56, 0xe8, 0x28, 0x83, 0x0b, 0xe2, 0xfa, 0x53, 0xb7,
+                0xd6, 0x6b, 0x07, 0x85, 0x83, 0xb0, 0x10, 0xa2, 0xf5, 0x51, 0x3c, 0xf9, 0x60, 0x03, 0xab, 0x45,
+                0x6c, 0x15, 0x6e, 0xef, 0xb5, 0xac, 0x3e, 0x6c, 0xdf, 0xb4, 0x92, 0x22, 0x2d, 0xce, 0xbf, 0x3e,
+                0xe9, 0xe5, 0xf6, 0x29, 0x0e, 0x01, 0x4f, 0xd2, 0xd4, 0x45, 0x65, 0xb3, 0xbb, 0xf2, 0x4c, 0x16,
+                0x37, 0x50, 0x3c, 0x6e, 0x49, 0x8c, 0x5a, 0x89, 0x2b, 0x1b, 0xab, 0xc4, 0x37, 0xd1, 0x46, 0xe9,
+                0x3d, 0x0e, 0x85, 0xa2, 0x50, 0x73, 0xa1, 0x5e, 0x54, 0x37, 0xd7, 0x94, 0x17, 0x56, 0xc2, 0xd8,
+                0xe5, 0x9f, 0xed, 0x4e, 0xae, 0x15, 0x42, 0x06, 0x0d, 0x74, 0x74, 0x5e, 0x24, 0x30, 0xce, 0xd1,
+                0x9e, 0x50, 0xa3, 0x9a, 0xb8, 0xf0, 0x4a, 0x57, 0x69, 0x78, 0x67, 0x12, 0x84, 0x58, 0xbe, 0xc7,
+                0x36, 0xaa, 0xee, 0x7c, 0x64, 0xa3, 0x76, 0xec, 0xff, 0x55, 0x41, 0x00, 0x2a, 0x44, 0x68, 0x4d,
+                0xb6, 0x53, 0x9e, 0x1c, 0x95, 0xb7, 0xca, 0xdc, 0x7f, 0x7d, 0x74, 0x27, 0x5c, 0x8e, 0xa6, 0x84,
+                0xb5, 0xac, 0x87, 0xa9, 0xf3, 0xff, 0x75, 0xf2, 0x34, 0xcd, 0x1a, 0x3b, 0x82, 0x2c, 0x2b, 0x4e,
+                0x6a, 0x46, 0x30, 0xa6, 0x89, 0x86, 0x23, 0xac, 0xf8, 0xa5, 0x15, 0xe9, 0x0a, 0xaa, 0x1e, 0x9a,
+                0xd7, 0x93, 0x6b, 0x28, 0xe4, 0x3b, 0xfd, 0x59, 0xc6, 0xed, 0x7c, 0x5f, 0xa5, 0x41, 0xcb, 0x51
+        };
+        /* Expected output for the first 80 bytes of input under double SHA256. */
+        static const unsigned char result_d80[32] = {
+                0xe9, 0x82, 0xae, 0xd1, 0xa6, 0x27, 0x65, 0x01, 0xcd, 0x7d, 0x10, 0xaf, 0x74, 0x2a, 0xcb, 0x36,
+                0xd5, 0xcd, 0xa4, 0x06, 0x31, 0x8f, 0xd4, 0x98, 0x7e, 0x2e, 0x5e, 0x2a, 0x02, 0x16, 0x93, 0x2b
+        };
+
+        int i;
+
+        /* Test transform() for 0 through 8 transformations. */
+        for (i = 0; i <= 8; ++i) {
+                uint32_t state[8];
+                memcpy(state, init, 8 * sizeof(uint32_t));
+                d->transform(state, data + 1, i);
+                if (memcmp(state, result[i], 8 * sizeof(uint32_t))) return 0;
+        }
+
+        /* Test transform_d64 */
+        {
+            struct sha256 out[1];
+            d->transform_d64(out, data_d64);
+            if (memcmp(out, result_d64, 32)) return 0;
+        }
+
+        /* Test transform_d64_2way, if available. */
+        if (d->transform_d64_2way) {
+                struct sha256 out[2];
+                d->transform_d64_2way(out, data_d64);
+                if (memcmp(out, result_d64, 64)) return 0;
+        }
+
+        /* Test transform_d64_4way, if available. */
+        if (d->transform_d64_4way) {
+                struct sha256 out[4];
+                d->transform_d64_4way(out, data_d64);
+                if (memcmp(out, result_d64, 128)) return 0;
+        }
+
+        /* Test transform_d64_8way, if available. */
+        if (d->transform_d64_8way) {
+                struct sha256 out[8];
+                d->transform_d64_8way(out, data_d64);
+                if (memcmp(out, result_d64, 256)) return 0;
+        }
+
+        /* Test transform_d64_16way, if available, on the test data twice. */
+        if (d->transform_d64_16way) {
+                struct sha256 in[32];
+                struct sha256 out[16];
+                memcpy(in, data_d64, 512);
+                memcpy(in + 16, data_d64, 512);
+                d->transform_d64_16way(out, in);
+                if (memcmp(out, result_d64, 256)) return 0;
+                if (memcmp(out + 8, result_d64, 256)) return 0;
+        }
+
+        /* Test the multi-lane midstate transforms, if available, against
+         * the 1-way transform. */
+        {
+                unsigned char in[1024];
+                memcpy(in, data + 1, 512);
+                memcpy(in + 512, data + 1, 512);
+                if (d->transform_2way && !self_test_multi(d->transform, d->transform_2way, 2, init, in)) return 0;
+                if (d->transform_4way && !self_test_multi(d->transform, d->transform_4way, 4, init, in)) return 0;
+                if (d->transform_8way && !self_test_multi(d->transform, d->transform_8way, 8, init, in)) return 0;
+                if (d->transform_16way && !self_test_multi(d->transform, d->transform_16way, 16, init, in)) return 0;
+        }
+
+        /* Test the multi-lane PBKDF2 transforms, if available, against the
+         * 1-way transform, with a different pair of keys in each lane. */
+        if (d->transform_pbkdf2_2way && !self_test_pbkdf2(d->transform_pbkdf2, d->transform_pbkdf2_2way, 2, result, data + 1)) return 0;
+        if (d->transform_pbkdf2_4way && !self_test_pbkdf2(d->transform_pbkdf2, d->transform_pbkdf2_4way, 4, result, data + 1)) return 0;
+        if (d->transform_pbkdf2_8way && !self_test_pbkdf2(d->transform_pbkdf2, d->transform_pbkdf2_8way, 8, result, data + 1)) return 0;
+        if (d->transform_pbkdf2_16way && !self_test_pbkdf2(d->transform_pbkdf2, d->transform_pbkdf2_16way, 16, result, data + 1)) return 0;
+
+        /* Test transform_d80, and the multi-lane 80-byte transforms, if
+         * available, against it. */
+        {
+                unsigned char in[1280];
+                struct sha256 out[1];
+                d->transform_d80(out, data + 1);
+                if (memcmp(out, result_d80, 32)) return 0;
+                memcpy(in, data + 1, 640);
+                memcpy(in + 640, data + 1, 640);
+                if (d->transform_d80_2way && !self_test_d80(d->transform_d80, d->transform_d80_2way, 2, in)) return 0;
+                if (d->transform_d80_4way && !self_test_d80(d->transform_d80, d->transform_d80_4way, 4, in)) return 0;
+                if (d->transform_d80_8way && !self_test_d80(d->transform_d80, d->transform_d80_8way, 8, in)) return 0;
+                if (d->transform_d80_16way && !self_test_d80(d->transform_d80, d->transform_d80_16way, 16, in)) return 0;
+                if (d->transform_d80below && !self_test_d80below(d->transform_d80, d->transform_d80below, 1, in)) return 0;
+                if (d->transform_d80below_4way && !self_test_d80below(d->transform_d80, d->transform_d80below_4way, 4, in)) return 0;
+                if (d->transform_d80below_8way && !self_test_d80below(d->transform_d80, d->transform_d80below_8way, 8, in)) return 0;
+                if (d->transform_d80below_16way && !self_test_d80below(d->transform_d80, d->transform_d80below_16way, 16, in)) return 0;
+        }
+
+        /* Test the early-exit 64-byte kernels, if available, against
+         * transform_d64. */
+        {
+                struct sha256 in[32];
+                memcpy(in, data_d64, 512);
+                memcpy(in + 16, data_d64 + 4, 512);
+                if (d->transform_d64below && !self_test_d64below(d->transform_d64, d->transform_d64below, 1, in)) return 0;
+                if (d->transform_d64below_4way && !self_test_d64below(d->transform_d64, d->transform_d64below_4way, 4, in)) return 0;
+                if (d->transform_d64below_8way && !self_test_d64below(d->transform_d64, d->transform_d64below_8way, 8, in)) return 0;
+                if (d->transform_d64below_16way && !self_test_d64below(d->transform_d64, d->transform_d64below_16way, 16, in)) return 0;
+        }
+
+        /* Test the 32-byte kernels against the 1-way transform. */
+        if (!self_test_d32(d->transform, d->transform_d32, 1, data_d64)) return 0;
+        if (d->transform_d32_4way && !self_test_d32(d->transform, d->transform_d32_4way, 4, data_d64)) return 0;
+        if (d->transform_d32_8way && !self_test_d32(d->transform, d->transform_d32_8way, 8, data_d64)) return 0;
+        if (d->transform_d32_16way && !self_test_d32(d->transform, d->transform_d32_16way, 16, data_d64)) return 0;
+
+        /* Test the grinding kernels, if available, against the 1-way
+         * transform, with the nonce in several words and wrapping. */
+        if (d->transform_grind_4way && !self_test_grind(d->transform, d->transform_grind_4way, 4, result[1], data + 1)) return 0;
+        if (d->transform_grind_8way && !self_test_grind(d->transform, d->transform_grind_8way, 8, result[1], data + 1)) return 0;
+        if (d->transform_grind_16way && !self_test_grind(d->transform, d->transform_grind_16way, 16, result[1], data + 1)) return 0;
+
+        /* Test the multi-buffer transform against the 1-way transform, with
+         * each lane hashing the test data from a different offset. */
+        {
+                struct sha256_mb_mgr mgr;
+                uint32_t state[8];
+                unsigned lane, word;
+                mgr.lanes = d->mb_lanes;
+                for (lane = 0; lane < mgr.lanes; ++lane) {
+                        for (word = 0; word < 8; ++word) {
+                                mgr.s[word*mgr.lanes + lane] = init[word];
+                        }
+                        mgr.ptr[lane] = data + 1 + 8*lane;
+                }
+                sha256_mb_transform(d, &mgr, 8);
+                for (lane = 0; lane < mgr.lanes; ++lane) {
+                        memcpy(state, init, sizeof(state));
+                        d->transform(state, data + 1 + 8*lane, 8);
+                        for (word = 0; word < 8; ++word) {
+                                if (mgr.s[word*mgr.lanes + lane] != state[word]) return 0;
+                        }
+                }
+        }
+
+        return !0;
+}
+#endif /* NDEBUG */
+
+#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
+/** Check whether the OS has enabled AVX registers. */
+static int AVXEnabled(void)
+{
+        uint32_t a, d;
+        __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+        return (a & 6) == 6;
+}
+
+/** Check whether the OS has enabled the AVX-512 opmask and ZMM registers. */
+static int AVX512Enabled(void)
+{
+        uint32_t a, d;
+        __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+        return (a & 0xe6) == 0xe6;
+}
+#endif
+
+/** Return a bitmask of the backends which the host supports.
+ *
+ * This is also called from the IFUNC resolvers, before relocations have been
+ * applied, so it must not call into any other library or read any data which
+ * requires relocation.  For the same reason the AArch64 hardware capabilities
+ * are supplied by the caller rather than read with getauxval(). */
+static unsigned sha256_supported_backends(unsigned long hwcap)
+{
+        unsigned ret = 1u << SHA256_BACKEND_NOASM;
+#if defined(HAVE_GETCPUID)
+        int have_sse4 = 0;
+        int have_xsave = 0;
+        int have_avx = 0;
+        int have_avx2 = 0;
+        int have_bmi2 = 0;
+        int have_shani = 0;
+        int have_avx512 = 0;
+        int enabled_avx = 0;
+
+        uint32_t eax=0, ebx=0, ecx=0, edx=0;
+
+        (void)hwcap;
+        (void)AVXEnabled;
+        (void)AVX512Enabled;
+        (void)have_sse4;
+        (void)have_avx;
+        (void)have_xsave;
+        (void)have_avx2;
+        (void)have_bmi2;
+        (void)have_shani;
+        (void)have_avx512;
+        (void)enabled_avx;
+
+        GetCPUID(1, 0, &eax, &ebx, &ecx, &edx);
+        have_sse4 = (ecx >> 19) & 1;
+        have_xsave = (ecx >> 27) & 1;
+        have_avx = (ecx >> 28) & 1;
+        if (have_xsave && have_avx) {
+                enabled_avx = AVXEnabled();
+        }
+        if (have_sse4) {
+                GetCPUID(7, 0, &eax, &ebx, &ecx, &edx);
+                have_avx2 = (ebx >> 5) & 1;
+                have_bmi2 = (ebx >> 8) & 1;
+                have_shani = (ebx >> 29) & 1;
+                /* AVX512F and AVX512VL */
+                have_avx512 = ((ebx >> 16) & 1) && ((ebx >> 31) & 1);
+        }
+        if (have_avx512 && enabled_avx) {
+                have_avx512 = AVX512Enabled();
+        } else {
+                have_avx512 = 0;
+        }
+
+#if defined(SHA256_VEC)
+        /* The vector kernels use whichever instructions the library is
+         * compiled for. */
+#if defined(__AVX2__)
+        if (have_avx2 && have_avx && enabled_avx) {
+#elif defined(__AVX__)
+        if (have_avx && enabled_avx) {
+#else
+        {
+#endif
+                ret |= 1u << SHA256_BACKEND_VEC;
+        }
+#endif
+
+#if defined(__x86_64__) || defined(__amd64__)
+        if (have_sse4) {
+                ret |= 1u << SHA256_BACKEND_SSE4;
+        }
+#if !defined(BUILD_BITCOIN_INTERNAL)
+        if (have_sse4 && have_avx2 && have_avx && enabled_avx) {
+                ret |= 1u << SHA256_BACKEND_AVX2;
+#if defined(ENABLE_AVX2_BMI2)
+                if (have_bmi2) {
+                        ret |= 1u << SHA256_BACKEND_AVX2_RORX;
+                }
+#endif
+#if defined(ENABLE_AVX512)
+                if (have_avx512) {
+                        ret |= 1u << SHA256_BACKEND_AVX512;
+#if defined(ENABLE_AVX2_BMI2)
+                        if (have_bmi2) {
+                                ret |= 1u << SHA256_BACKEND_AVX512_RORX;
+                        }
+#endif
+                }
+#endif
+        }
+        if (have_shani) {
+                ret |= 1u << SHA256_BACKEND_SHANI;
+#if defined(ENABLE_AVX512)
+                if (have_avx512) {
+                        ret |= 1u << SHA256_BACKEND_SHANI_AVX512;
+                }
+#endif
+        }
+#endif /* !defined(BUILD_BITCOIN_INTERNAL) */
+#endif
+
+#elif defined(__aarch64__)
+        /* Advanced SIMD is part of the AArch64 base ABI elsewhere. */
+        int have_neon = !0;
+        int have_arm_shani = 0;
+
+#if defined(__linux__)
+        have_neon = (hwcap & HWCAP_ASIMD) != 0;
+        if (hwcap & HWCAP_SHA2) {
+                have_arm_shani = !0;
+        }
+#else
+        (void)hwcap;
+#endif
+
+#if defined(__APPLE__)
+        int val = 0;
+        size_t len = sizeof(val);
+        if (sysctlbyname("hw.optional.arm.FEAT_SHA256", &val, &len, NULL, 0) == 0) {
+                have_arm_shani = !0;
+        }
+#endif
+
+        if (have_neon) {
+                ret |= 1u << SHA256_BACKEND_NEON;
+        }
+        if (have_arm_shani) {
+                ret |= 1u << SHA256_BACKEND_ARMV8;
+        }
+#if defined(SHA256_VEC)
+        if (have_neon) {
+                ret |= 1u << SHA256_BACKEND_VEC;
+        }
+#endif
+#else
+        (void)hwcap;
+#if defined(SHA256_VEC)
+        ret |= 1u << SHA256_BACKEND_VEC;
+#endif
+#endif
+
+        return ret;
+}
+
+/** Choose the best backend for the host, which is the supported backend
+ * listed last in enum sha256_backend.  The same restrictions apply as for
+ * sha256_supported_backends(). */
+static enum sha256_backend sha256_select_backend(unsigned long hwcap)
+{
+        unsigned supported = sha256_supported_backends(hwcap);
+        int backend = SHA256_BACKEND_COUNT - 1;
+        while (!((supported >> backend) & 1)) {
+                --backend;
+        }
+        return (enum sha256_backend)backend;
+}
+
+/** The hardware capabilities argument to sha256_select_backend(). */
+static unsigned long sha256_hwcap(void)
+{
+#if defined(__linux__) && defined(__aarch64__)
+        return getauxval(AT_HWCAP);
+#else
+        return 0;
+#endif
+}
+
+static const struct sha256_dispatch* sha256_dispatch_init(void)
+{
+        const struct sha256_dispatch* d = &dispatch_tables[sha256_select_backend(sha256_hwcap())];
+        int expected = DISPATCH_NONE;
+        /* Detection is cheap and yields the same result in every thread, so
+         * threads which lose the race here use their own result rather than
+         * wait for the winner to finish the self-test, which bounds the
+         * latency of the first call regardless of contention. */
+        if (__atomic_compare_exchange_n(&dispatch_state, &expected, DISPATCH_BUSY, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                assert(self_test(d));
+                __atomic_store_n(&dispatch, d, __ATOMIC_RELEASE);
+                __atomic_store_n(&dispatch_state, DISPATCH_DONE, __ATOMIC_RELAXED);
+        }
+        return d;
+}
+
+const char* sha256_auto_detect(void)
+{
+        return get_dispatch()->name;
+}
+
+/* SHA-256 */
+
+void sha256_init(struct sha256_ctx* ctx)
+{
+        assert(ctx);
+        ctx->bytes = 0;
+        Initialize(ctx->s);
+}
+
+static inline __attribute__((always_inline)) void sha256_update_impl(const struct sha256_dispatch* d, struct sha256_ctx* ctx, const void *_data, size_t len)
+{
+        const unsigned char* data = (const unsigned char*)_data;
+        const unsigned char* end = data + len;
+        size_t bufsize = ctx->bytes % 64;
+        if (bufsize && bufsize + len >= 64) {
+                /* Fill the buffer, and process it. */
+                memcpy(ctx->buf.u8 + bufsize, data, 64 - bufsize);
+                ctx->bytes += 64 - bufsize;
+                data += 64 - bufsize;
+                d->transform(ctx->s, ctx->buf.u8, 1);
+                bufsize = 0;
+        }
+        if (end - data >= 64) {
+                size_t blocks = (end - data) / 64;
+                d->transform(ctx->s, data, blocks);
+                data += 64 * blocks;
+                ctx->bytes += 64 * blocks;
+        }
+        if (end > data) {
+                /* Fill the buffer with what remains. */
+                memcpy(ctx->buf.u8 + bufsize, data, end - data);
+                ctx->bytes += end - data;
+        }
+}
+
+static inline __attribute__((always_inline)) void sha256_done_impl(const struct sha256_dispatch* d, struct sha256* hash, struct sha256_ctx* ctx)
+{
+        static const unsigned char pad[64] = {0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        unsigned char sizedesc[8];
+        WriteBE64(sizedesc, ctx->bytes << 3);
+        sha256_update_impl(d, ctx, pad, 1 + ((119 - (ctx->bytes % 64)) % 64));
+        sha256_update_impl(d, ctx, sizedesc, 8);
+        WriteBE32(&hash->u8[0], ctx->s[0]);
+        WriteBE32(&hash->u8[4], ctx->s[1]);
+        WriteBE32(&hash->u8[8], ctx->s[2]);
+        WriteBE32(&hash->u8[12], ctx->s[3]);
+        WriteBE32(&hash->u8[16], ctx->s[4]);
+        WriteBE32(&hash->u8[20], ctx->s[5]);
+        WriteBE32(&hash->u8[24], ctx->s[6]);
+        WriteBE32(&hash->u8[28], ctx->s[7]);
+}
+
+static inline __attribute__((always_inline)) void sha256_double64_impl(const struct sha256_dispatch* d, struct sha256 out[], const struct sha256 in[], size_t blocks)
+{
+        if (d->transform_d64_16way) {
+                while (blocks >= 16) {
+                        d->transform_d64_16way(out, in);
+                        out += 16;
+                        in += 32;
+                        blocks -= 16;
+                }
+        }
+        if (d->transform_d64_8way) {
+                while (blocks >= 8) {
+                        d->transform_d64_8way(out, in);
+                        out += 8;
+                        in += 16;
+                        blocks -= 8;
+                }
+        }
+        if (d->transform_d64_4way) {
+                while (blocks >= 4) {
+                        d->transform_d64_4way(out, in);
+                        out += 4;
+                        in += 8;
+                        blocks -= 4;
+                }
+        }
+        if (d->transform_d64_2way) {
+                while (blocks >= 2) {
+                        d->transform_d64_2way(out, in);
+                        out += 2;
+                        in += 4;
+                        blocks -= 2;
+                }
+        }
+        while (blocks) {
+                d->transform_d64(out, in);
+                ++out;
+                in += 2;
+                --blocks;
+        }
+}
+
+/** The SHA256 of each 32-byte message in[i] into out[i], which may be in. */
+static inline __attribute__((always_inline)) void sha256_double32_impl(const struct sha256_dispatch* d, struct sha256 out[], const struct sha256 in[], size_t count)
+{
+        if (d->transform_d32_16way) {
+                while (count >= 16) {
+                        d->transform_d32_16way(out, in);
+                        out += 16;
+                        in += 16;
+                        count -= 16;
+                }
+        }
+        if (d->transform_d32_8way) {
+                while (count >= 8) {
+                        d->transform_d32_8way(out, in);
+                        out += 8;
+                        in += 8;
+                        count -= 8;
+                }
+        }
+        if (d->transform_d32_4way) {
+                while (count >= 4) {
+                        d->transform_d32_4way(out, in);
+                        out += 4;
+                        in += 4;
+                        count -= 4;
+                }
+        }
+        while (count) {
+                d->transform_d32(out, in);
+                ++out;
+                ++in;
+                --count;
+        }
+}
+
+static inline __attribute__((always_inline)) size_t sha256_double64_meets_target_impl(const struct sha256_dispatch* d, unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target)
+{
+        transform_d64_below_t tr = NULL;
+        struct sha256 buf[32], out[16];
+        uint32_t top[16], mask;
+        size_t i, j, lanes = 16, n, pass = 0;
+
+        if (d->transform_d64below_16way) {
+                tr = d->transform_d64below_16way;
+        } else if (d->transform_d64below_8way) {
+                tr = d->transform_d64below_8way;
+                lanes = 8;
+        } else if (d->transform_d64below_4way) {
+                tr = d->transform_d64below_4way;
+                lanes = 4;
+        } else if (d->transform_d64below) {
+                tr = d->transform_d64below;
+                lanes = 1;
+        }
+        for (j = 0; j < 16; ++j) {
+                top[j] = ReadLE32(target->u8 + 28);
+        }
+        memset(bitmap, 0, (blocks + 7) / 8);
+        for (i = 0; i < blocks; i += n) {
+                n = blocks - i < lanes ? blocks - i : lanes;
+                if (!tr) {
+                        sha256_double64_impl(d, out, in + 2 * i, n);
+                        mask = (1ul << n) - 1;
+                } else {
+                        if (n < lanes) {
+                                /* The spare lanes hash copies of the last
+                                 * block. */
+                                memcpy(buf, in + 2 * i, 64 * n);
+                                for (j = n; j < lanes; ++j) {
+                                        memcpy(buf + 2 * j, in + 2 * (blocks - 1), 64);
+                                }
+                                mask = tr(buf, top);
+                        } else {
+                                mask = tr(in + 2 * i, top);
+                        }
+                        /* Only the blocks whose most significant word passes
+                         * are hashed again in full. */
+                        for (j = 0; j < n; ++j) {
+                                if ((mask >> j) & 1) d->transform_d64(&out[j], in + 2 * (i + j));
+                        }
+                }
+                for (j = 0; j < n; ++j) {
+                        if (((mask >> j) & 1) && sha256_meets_target(&out[j], target)) {
+                                bitmap[(i + j) / 8] |= (unsigned char)(1u << ((i + j) % 8));
+                                ++pass;
+                        }
+                }
+        }
+        return pass;
+}
+
+static inline __attribute__((always_inline)) void sha256_midstate_impl(const struct sha256_dispatch* d, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks)
+{
+        if (d->transform_16way) {
+                while (blocks >= 16) {
+                        d->transform_16way(out, midstate, in);
+                        out += 16;
+                        in += 1024;
+                        blocks -= 16;
+                }
+        }
+        if (d->transform_8way) {
+                while (blocks >= 8) {
+                        d->transform_8way(out, midstate, in);
+                        out += 8;
+                        in += 512;
+                        blocks -= 8;
+                }
+        }
+        if (d->transform_4way) {
+                while (blocks >= 4) {
+                        d->transform_4way(out, midstate, in);
+                        out += 4;
+                        in += 256;
                         blocks -= 4;
                 }
         }
-        if (transform_2way) {
+        if (d->transform_2way) {
                 while (blocks >= 2) {
-                        transform_2way(out, midstate, in);
+                        d->transform_2way(out, midstate, in);
                         out += 2;
                         in += 128;
                         blocks -= 2;
@@ -783,7 +1802,7 @@ void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsi
                 unsigned char* _out = out->u8;
                 int i;
                 memcpy(s, midstate, 8 * sizeof(uint32_t));
-                transform(s, in, 1);
+                d->transform(s, in, 1);
                 for (i = 0; i < 8; ++i) {
                         WriteBE32(_out, s[i]);
                         _out += 4;
@@ -794,5 +1813,968 @@ void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsi
         }
 }
 
+static inline __attribute__((always_inline)) void sha256_midstate_final64_impl(const struct sha256_dispatch* d, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t count)
+{
+        struct sha256_mb_mgr mgr;
+        unsigned char pad[64];
+        unsigned lane, n;
+        int i;
+
+        /* The padding of a 128-byte message, which is the same in every
+         * lane. */
+        memset(pad, 0, sizeof(pad));
+        pad[0] = 0x80;
+        WriteBE64(pad + 56, 128 << 3);
+        mgr.lanes = d->mb_lanes;
+        while (count) {
+                n = count < mgr.lanes ? (unsigned)count : mgr.lanes;
+                /* The spare lanes of the last group hash the first message
+                 * again, and their results are discarded. */
+                for (lane = 0; lane < mgr.lanes; ++lane) {
+                        for (i = 0; i < 8; ++i) {
+                                mgr.s[i*mgr.lanes + lane] = midstate[i];
+                        }
+                        mgr.ptr[lane] = in + 64 * (lane < n ? lane : 0);
+                }
+                sha256_mb_transform(d, &mgr, 1);
+                for (lane = 0; lane < mgr.lanes; ++lane) {
+                        mgr.ptr[lane] = pad;
+                }
+                sha256_mb_transform(d, &mgr, 1);
+                for (lane = 0; lane < n; ++lane) {
+                        for (i = 0; i < 8; ++i) {
+                                WriteBE32(&out[lane].u8[4*i], mgr.s[i*mgr.lanes + lane]);
+                        }
+                }
+                out += n;
+                in += 64 * n;
+                count -= n;
+        }
+}
+
+/* PBKDF2 */
+
+static inline __attribute__((always_inline)) void sha256_pbkdf2_iterate_impl(const struct sha256_dispatch* d, uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t count, size_t iterations)
+{
+        static const size_t width[5] = { 16, 8, 4, 2, 1 };
+        transform_pbkdf2_t tr[5];
+        uint32_t pf[16 * 8], pu[16 * 8], pi[16 * 8], po[16 * 8];
+        size_t k, pad, j;
+
+        tr[0] = d->transform_pbkdf2_16way;
+        tr[1] = d->transform_pbkdf2_8way;
+        tr[2] = d->transform_pbkdf2_4way;
+        tr[3] = d->transform_pbkdf2_2way;
+        tr[4] = d->transform_pbkdf2;
+        while (count) {
+                /* The widest kernel which the remaining lanes fill. */
+                for (k = 0; !tr[k] || width[k] > count; ++k)
+                        ;
+                /* If that would leave lanes over, the narrowest kernel which
+                 * takes them all instead, if it is less than twice as wide,
+                 * with the spare lanes repeating the last. */
+                pad = k;
+                if (width[k] < count) {
+                        for (j = 0; j < k; ++j) {
+                                if (tr[j] && width[j] < 2 * count) pad = j;
+                        }
+                }
+                if (pad != k) {
+                        for (j = 0; j < width[pad]; ++j) {
+                                size_t lane = 8 * (j < count ? j : count - 1);
+                                memcpy(pf + 8 * j, f + lane, 8 * sizeof(uint32_t));
+                                memcpy(pu + 8 * j, u + lane, 8 * sizeof(uint32_t));
+                                memcpy(pi + 8 * j, inner + lane, 8 * sizeof(uint32_t));
+                                memcpy(po + 8 * j, outer + lane, 8 * sizeof(uint32_t));
+                        }
+                        tr[pad](pf, pu, pi, po, iterations);
+                        memcpy(f, pf, 8 * count * sizeof(uint32_t));
+                        memcpy(u, pu, 8 * count * sizeof(uint32_t));
+                        Wipe(pf, sizeof(pf));
+                        Wipe(pu, sizeof(pu));
+                        Wipe(pi, sizeof(pi));
+                        Wipe(po, sizeof(po));
+                        break;
+                }
+                tr[k](f, u, inner, outer, iterations);
+                f += 8 * width[k];
+                u += 8 * width[k];
+                inner += 8 * width[k];
+                outer += 8 * width[k];
+                count -= width[k];
+        }
+}
+
+/* Block headers */
+
+/** Decode the target in a block header's nBits field, with the consensus
+ * rules for doing so.  Returns zero for a negative, zero, or overflowing
+ * target, which is never met. */
+static int sha256_header_target(struct sha256* target, const unsigned char header[80])
+{
+        uint32_t bits = ReadLE32(header + 72);
+        uint32_t mantissa = bits & 0x007ffffful;
+        unsigned size = bits >> 24;
+        int i;
+
+        memset(target, 0, sizeof(*target));
+        if (mantissa && (bits & 0x00800000ul)) return 0;
+        if (mantissa && (size > 34 || (mantissa > 0xff && size > 33) || (mantissa > 0xffff && size > 32))) return 0;
+        if (size < 3) {
+                mantissa >>= 8 * (3 - size);
+                size = 3;
+        }
+        if (!mantissa) return 0;
+
+        for (i = 0; i < 3; ++i) {
+                if (size - 3 + i < 32) {
+                        target->u8[size - 3 + i] = (unsigned char)(mantissa >> (8 * i));
+                }
+        }
+        return !0;
+}
+
+/** Whether the double SHA256 of a block header, read as a little-endian
+ * number, is no greater than the target encoded in the header. */
+static int sha256_header_meets_target(const struct sha256* hash, const unsigned char header[80])
+{
+        struct sha256 target;
+        return sha256_header_target(&target, header) && sha256_meets_target(hash, &target);
+}
+
+/** As sha256_check_headers_impl() without hashes, for backends with
+ * early-exit kernels: only the headers whose hash has a most significant word
+ * no greater than their target's are hashed again in full. */
+static inline __attribute__((always_inline)) size_t sha256_check_headers_below_impl(const struct sha256_dispatch* d, unsigned char bitmap[], const unsigned char headers[], size_t count)
+{
+        transform_d80_below_t tr;
+        unsigned char buf[16 * 80];
+        uint32_t top[16], mask;
+        struct sha256 hash, target;
+        size_t i, j, lanes, n, pass = 0;
+
+        if (d->transform_d80below_16way) {
+                tr = d->transform_d80below_16way;
+                lanes = 16;
+        } else if (d->transform_d80below_8way) {
+                tr = d->transform_d80below_8way;
+                lanes = 8;
+        } else if (d->transform_d80below_4way) {
+                tr = d->transform_d80below_4way;
+                lanes = 4;
+        } else {
+                tr = d->transform_d80below;
+                lanes = 1;
+        }
+        memset(bitmap, 0, (count + 7) / 8);
+        for (i = 0; i < count; i += n) {
+                n = count - i < lanes ? count - i : lanes;
+                for (j = 0; j < n; ++j) {
+                        sha256_header_target(&target, headers + 80 * (i + j));
+                        top[j] = ReadLE32(target.u8 + 28);
+                }
+                if (n < lanes) {
+                        /* The spare lanes hash copies of the last header. */
+                        memcpy(buf, headers + 80 * i, 80 * n);
+                        for (j = n; j < lanes; ++j) {
+                                memcpy(buf + 80 * j, headers + 80 * (count - 1), 80);
+                                top[j] = 0;
+                        }
+                        mask = tr(buf, top);
+                } else {
+                        mask = tr(headers + 80 * i, top);
+                }
+                for (j = 0; j < n; ++j) {
+                        if (!((mask >> j) & 1)) continue;
+                        d->transform_d80(&hash, headers + 80 * (i + j));
+                        if (sha256_header_meets_target(&hash, headers + 80 * (i + j))) {
+                                bitmap[(i + j) / 8] |= (unsigned char)(1u << ((i + j) % 8));
+                                ++pass;
+                        }
+                }
+        }
+        return pass;
+}
+
+static inline __attribute__((always_inline)) size_t sha256_check_headers_impl(const struct sha256_dispatch* d, unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count)
+{
+        static const size_t width[5] = { 16, 8, 4, 2, 1 };
+        transform_d80_t tr[5];
+        unsigned char buf[16 * 80];
+        struct sha256 out[16];
+        struct sha256* dst;
+        size_t i, j, k, pad, n, pass = 0;
+
+        if (!hashes && (d->transform_d80below || d->transform_d80below_4way || d->transform_d80below_8way || d->transform_d80below_16way)) {
+                return sha256_check_headers_below_impl(d, bitmap, headers, count);
+        }
+
+        tr[0] = d->transform_d80_16way;
+        tr[1] = d->transform_d80_8way;
+        tr[2] = d->transform_d80_4way;
+        tr[3] = d->transform_d80_2way;
+        tr[4] = d->transform_d80;
+        memset(bitmap, 0, (count + 7) / 8);
+        for (i = 0; i < count; i += n) {
+                /* As for sha256_pbkdf2_iterate_impl(), the widest kernel which
+                 * the remaining headers fill, unless a kernel less than twice
+                 * as wide takes them all, with the spare lanes hashing copies
+                 * of the last header. */
+                for (k = 0; !tr[k] || width[k] > count - i; ++k)
+                        ;
+                pad = k;
+                if (width[k] < count - i) {
+                        for (j = 0; j < k; ++j) {
+                                if (tr[j] && width[j] < 2 * (count - i)) pad = j;
+                        }
+                }
+                dst = hashes ? hashes + i : out;
+                if (pad != k) {
+                        n = count - i;
+                        memcpy(buf, headers + 80 * i, 80 * n);
+                        for (j = n; j < width[pad]; ++j) {
+                                memcpy(buf + 80 * j, headers + 80 * (count - 1), 80);
+                        }
+                        tr[pad](out, buf);
+                        if (hashes) {
+                                memcpy(dst, out, n * sizeof(struct sha256));
+                        }
+                } else {
+                        n = width[k];
+                        tr[k](dst, headers + 80 * i);
+                }
+                for (j = 0; j < n; ++j) {
+                        if (sha256_header_meets_target(&dst[j], headers + 80 * (i + j))) {
+                                bitmap[(i + j) / 8] |= (unsigned char)(1u << ((i + j) % 8));
+                                ++pass;
+                        }
+                }
+        }
+        return pass;
+}
+
+/* Grinding */
+
+static inline __attribute__((always_inline)) size_t sha256_grind_impl(const struct sha256_dispatch* d, uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice)
+{
+        struct sha256_grind ctx;
+        struct sha256 hash;
+        unsigned char block[64];
+        transform_grind_t tr = NULL;
+        uint32_t lanes = 1, n, mask, i, s[8];
+        size_t found = 0;
+        int j;
+
+        sha256_grind_init(&ctx, midstate, tail, nonce_offset, target, twice);
+        memcpy(block, tail, sizeof(block));
+        if (d->transform_grind_16way) {
+                tr = d->transform_grind_16way;
+                lanes = 16;
+        } else if (d->transform_grind_8way) {
+                tr = d->transform_grind_8way;
+                lanes = 8;
+        } else if (d->transform_grind_4way) {
+                tr = d->transform_grind_4way;
+                lanes = 4;
+        }
+        while (count && found < max_nonces) {
+                n = count < lanes ? (uint32_t)count : lanes;
+                /* Only the lanes whose most significant word is no greater
+                 * than the target's are hashed again in full, and compared
+                 * with the whole target if that word still passes. */
+                mask = tr ? tr(&ctx, start) & ((1ul << n) - 1) : 1;
+                for (i = 0; mask && found < max_nonces; ++i, mask >>= 1) {
+                        if (!(mask & 1)) continue;
+                        sha256_grind_hash(s, &ctx, block, start + i, d->transform);
+                        if (__builtin_bswap32(s[7]) > ctx.target) continue;
+                        for (j = 0; j < 8; ++j) {
+                                WriteBE32(&hash.u8[4 * j], s[j]);
+                        }
+                        if (sha256_meets_target(&hash, target)) {
+                                nonces[found++] = start + i;
+                        }
+                }
+                start += n;
+                count -= n;
+        }
+        return found;
+}
+
+/* Merkle trees */
+
+/** The number of pairs at one level of a Merkle tree which can be hashed,
+ * given the number of elements of the level which have been computed.  The
+ * last element of a level with an odd number of elements is paired with
+ * itself. */
+static inline __attribute__((always_inline)) size_t merkle_ready(size_t size, size_t avail)
+{
+        return avail == size ? (size + 1) / 2 : avail / 2;
+}
+
+/** Compute the root of the Merkle tree over count hashes, overwriting them.
+ *
+ * Each level of the tree is stored over the start of the one below, which is
+ * safe as element j of a level is written only after the pair it replaces,
+ * j/2 of the level below, has been read.  Rather than completing one level
+ * before starting the next, pairs are hashed as soon as both their inputs are
+ * available, so that the tail of each level can share a batch with the head of
+ * the levels above and the widest double64 kernel stays saturated throughout.
+ * Returns non-zero if check is set and any level contains two identical
+ * hashes in the same pair (CVE-2012-2459). */
+static int sha256_merkle_root_impl(const struct sha256_dispatch* d, struct sha256* root, struct sha256 hashes[], size_t count, int check)
+{
+        /* The number of elements in, and the number so far computed of,
+         * each level of the tree, with the leaves at level 0. */
+        size_t size[8 * sizeof(size_t) + 1];
+        size_t avail[8 * sizeof(size_t) + 1];
+        /* A batch of pairs gathered from across levels, and the level of each. */
+        struct sha256 in[2 * 16];
+        struct sha256 out[16];
+        int level[16];
+        size_t lanes, batch, ready, i, j, k;
+        int levels, l, mutated = 0;
+
+        if (!count) {
+                memset(root, 0, sizeof(*root));
+                return 0;
+        }
+
+        lanes = d->transform_d64_16way ? 16
+              : d->transform_d64_8way ? 8
+              : d->transform_d64_4way ? 4
+              : d->transform_d64_2way ? 2 : 1;
+
+        size[0] = avail[0] = count;
+        for (levels = 0; size[levels] > 1; ++levels) {
+                size[levels + 1] = (size[levels] + 1) / 2;
+                avail[levels + 1] = 0;
+        }
+
+        while (!avail[levels]) {
+                /* Hash whole batches of complete pairs in place, level by
+                 * level, which at the lower levels of a large tree is nearly
+                 * all of the work. */
+                for (l = 0; l < levels; ++l) {
+                        j = avail[l + 1];
+                        ready = (avail[l] == size[l] ? size[l] : avail[l]) / 2;
+                        if (ready < j + lanes) {
+                                continue;
+                        }
+                        k = (ready - j) - (ready - j) % lanes;
+                        if (check) {
+                                for (i = j; i < j + k; ++i) {
+                                        mutated |= !memcmp(&hashes[2 * i], &hashes[2 * i + 1], sizeof(struct sha256));
+                                }
+                        }
+                        sha256_double64_impl(d, hashes + j, hashes + 2 * j, k);
+                        avail[l + 1] += k;
+                }
+
+                /* Gather the remaining pairs which are ready, from the lowest
+                 * levels first, into a single batch. */
+                batch = 0;
+                for (l = 0; l < levels && batch < lanes; ++l) {
+                        ready = merkle_ready(size[l], avail[l]);
+                        for (j = avail[l + 1]; j < ready && batch < lanes; ++j) {
+                                in[2 * batch] = hashes[2 * j];
+                                if (2 * j + 1 < size[l]) {
+                                        in[2 * batch + 1] = hashes[2 * j + 1];
+                                        if (check) {
+                                                mutated |= !memcmp(&in[2 * batch], &in[2 * batch + 1], sizeof(struct sha256));
+                                        }
+                                } else {
+                                        in[2 * batch + 1] = hashes[2 * j];
+                                }
+                                level[batch++] = l;
+                        }
+                }
+                if (batch) {
+                        sha256_double64_impl(d, out, in, batch);
+                        for (i = 0; i < batch; ++i) {
+                                hashes[avail[level[i] + 1]++] = out[i];
+                        }
+                }
+        }
+
+        *root = hashes[0];
+        return mutated;
+}
+
+/* Each public entry point is specialised for every backend, with the dispatch
+ * table a compile-time constant so that the kernels are called directly.  The
+ * specialisations make up the tables of sha256_backend_functions(), and where
+ * the loader supports it the global entry points are bound to the best of them
+ * at startup. */
+#define SHA256_SPECIALIZE(name, backend) \
+static void sha256_update_##name(struct sha256_ctx* ctx, const void *data, size_t len) \
+{ \
+        sha256_update_impl(&dispatch_tables[backend], ctx, data, len); \
+} \
+static void sha256_done_##name(struct sha256* hash, struct sha256_ctx* ctx) \
+{ \
+        sha256_done_impl(&dispatch_tables[backend], hash, ctx); \
+} \
+static void sha256_double64_##name(struct sha256 out[], const struct sha256 in[], size_t blocks) \
+{ \
+        sha256_double64_impl(&dispatch_tables[backend], out, in, blocks); \
+} \
+static size_t sha256_double64_meets_target_##name(unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target) \
+{ \
+        return sha256_double64_meets_target_impl(&dispatch_tables[backend], bitmap, in, blocks, target); \
+} \
+static void sha256_midstate_##name(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks) \
+{ \
+        sha256_midstate_impl(&dispatch_tables[backend], out, midstate, in, blocks); \
+} \
+static void sha256_merkle_root_##name(struct sha256* root, struct sha256 hashes[], size_t count) \
+{ \
+        sha256_merkle_root_impl(&dispatch_tables[backend], root, hashes, count, 0); \
+} \
+static int sha256_merkle_root_mutated_##name(struct sha256* root, struct sha256 hashes[], size_t count) \
+{ \
+        return sha256_merkle_root_impl(&dispatch_tables[backend], root, hashes, count, !0); \
+} \
+static size_t sha256_check_headers_##name(unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count) \
+{ \
+        return sha256_check_headers_impl(&dispatch_tables[backend], bitmap, hashes, headers, count); \
+} \
+static size_t sha256_grind_##name(uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice) \
+{ \
+        return sha256_grind_impl(&dispatch_tables[backend], nonces, max_nonces, midstate, tail, nonce_offset, start, count, target, twice); \
+}
+
+SHA256_SPECIALIZE(noasm, SHA256_BACKEND_NOASM)
+#if defined(SHA256_VEC)
+SHA256_SPECIALIZE(vec, SHA256_BACKEND_VEC)
+#endif
+#if defined(__x86_64__) || defined(__amd64__)
+SHA256_SPECIALIZE(sse4, SHA256_BACKEND_SSE4)
+#if !defined(BUILD_BITCOIN_INTERNAL)
+SHA256_SPECIALIZE(avx2, SHA256_BACKEND_AVX2)
+#if defined(ENABLE_AVX2_BMI2)
+SHA256_SPECIALIZE(avx2_rorx, SHA256_BACKEND_AVX2_RORX)
+#endif
+SHA256_SPECIALIZE(shani, SHA256_BACKEND_SHANI)
+#if defined(ENABLE_AVX512)
+SHA256_SPECIALIZE(avx512, SHA256_BACKEND_AVX512)
+#if defined(ENABLE_AVX2_BMI2)
+SHA256_SPECIALIZE(avx512_rorx, SHA256_BACKEND_AVX512_RORX)
+#endif
+SHA256_SPECIALIZE(shani_avx512, SHA256_BACKEND_SHANI_AVX512)
+#endif
+#endif /* !defined(BUILD_BITCOIN_INTERNAL) */
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+SHA256_SPECIALIZE(neon, SHA256_BACKEND_NEON)
+SHA256_SPECIALIZE(armv8, SHA256_BACKEND_ARMV8)
+#endif
+
+#define SHA256_FUNCTIONS(name) \
+        { \
+                sha256_update_##name, sha256_done_##name, \
+                sha256_double64_##name, sha256_double64_meets_target_##name, \
+                sha256_midstate_##name, \
+                sha256_merkle_root_##name, sha256_merkle_root_mutated_##name, \
+                sha256_check_headers_##name, sha256_grind_##name \
+        }
+
+/* Indexed by enum sha256_backend. */
+static const struct sha256_functions backend_functions[SHA256_BACKEND_COUNT] = {
+        SHA256_FUNCTIONS(noasm),
+#if defined(SHA256_VEC)
+        SHA256_FUNCTIONS(vec),
+#endif
+#if defined(__x86_64__) || defined(__amd64__)
+        SHA256_FUNCTIONS(sse4),
+#if !defined(BUILD_BITCOIN_INTERNAL)
+        SHA256_FUNCTIONS(avx2),
+#if defined(ENABLE_AVX2_BMI2)
+        SHA256_FUNCTIONS(avx2_rorx),
+#endif
+#if defined(ENABLE_AVX512)
+        SHA256_FUNCTIONS(avx512),
+#if defined(ENABLE_AVX2_BMI2)
+        SHA256_FUNCTIONS(avx512_rorx),
+#endif
+#endif
+        SHA256_FUNCTIONS(shani),
+#if defined(ENABLE_AVX512)
+        SHA256_FUNCTIONS(shani_avx512),
+#endif
+#endif /* !defined(BUILD_BITCOIN_INTERNAL) */
+#endif /* defined(__x86_64__) || defined(__amd64__) */
+#if defined(__aarch64__)
+        SHA256_FUNCTIONS(neon),
+        SHA256_FUNCTIONS(armv8),
+#endif
+};
+
+#if defined(SHA256_USE_IFUNC)
+#if defined(__x86_64__) || defined(__amd64__)
+#if defined(ENABLE_AVX2_BMI2) && !defined(BUILD_BITCOIN_INTERNAL)
+#define SHA256_RESOLVE_AVX2_RORX(fn) \
+        case SHA256_BACKEND_AVX2_RORX: return fn##_avx2_rorx;
+#if defined(ENABLE_AVX512)
+#define SHA256_RESOLVE_AVX512_RORX(fn) \
+        case SHA256_BACKEND_AVX512_RORX: return fn##_avx512_rorx;
+#endif
+#else
+#define SHA256_RESOLVE_AVX2_RORX(fn)
+#define SHA256_RESOLVE_AVX512_RORX(fn)
+#endif
+#if defined(BUILD_BITCOIN_INTERNAL)
+#define SHA256_RESOLVE_X86(fn) \
+        case SHA256_BACKEND_SSE4: return fn##_sse4;
+#elif defined(ENABLE_AVX512)
+#define SHA256_RESOLVE_X86(fn) \
+        case SHA256_BACKEND_SSE4: return fn##_sse4; \
+        case SHA256_BACKEND_AVX2: return fn##_avx2; \
+        SHA256_RESOLVE_AVX2_RORX(fn) \
+        case SHA256_BACKEND_AVX512: return fn##_avx512; \
+        SHA256_RESOLVE_AVX512_RORX(fn) \
+        case SHA256_BACKEND_SHANI: return fn##_shani; \
+        case SHA256_BACKEND_SHANI_AVX512: return fn##_shani_avx512;
+#else
+#define SHA256_RESOLVE_X86(fn) \
+        case SHA256_BACKEND_SSE4: return fn##_sse4; \
+        case SHA256_BACKEND_AVX2: return fn##_avx2; \
+        SHA256_RESOLVE_AVX2_RORX(fn) \
+        case SHA256_BACKEND_SHANI: return fn##_shani;
+#endif
+#else
+#define SHA256_RESOLVE_X86(fn)
+#endif
+#if defined(__aarch64__)
+#define SHA256_RESOLVE_ARM(fn) \
+        case SHA256_BACKEND_NEON: return fn##_neon; \
+        case SHA256_BACKEND_ARMV8: return fn##_armv8;
+/* The glibc dynamic loader passes AT_HWCAP to resolvers on AArch64. */
+#define SHA256_RESOLVER_PARAMS unsigned long hwcap
+#define SHA256_RESOLVER_HWCAP hwcap
+#else
+#define SHA256_RESOLVE_ARM(fn)
+#define SHA256_RESOLVER_PARAMS void
+#define SHA256_RESOLVER_HWCAP 0
+#endif
+
+#if defined(SHA256_VEC)
+#define SHA256_RESOLVE_VEC(fn) \
+        case SHA256_BACKEND_VEC: return fn##_vec;
+#else
+#define SHA256_RESOLVE_VEC(fn)
+#endif
+
+#define SHA256_RESOLVER(fn, type) \
+static type fn##_resolve(SHA256_RESOLVER_PARAMS) \
+{ \
+        switch (sha256_select_backend(SHA256_RESOLVER_HWCAP)) { \
+        SHA256_RESOLVE_X86(fn) \
+        SHA256_RESOLVE_ARM(fn) \
+        SHA256_RESOLVE_VEC(fn) \
+        default: break; \
+        } \
+        return fn##_noasm; \
+}
+
+typedef void (*sha256_update_t)(struct sha256_ctx*, const void*, size_t);
+typedef void (*sha256_done_t)(struct sha256*, struct sha256_ctx*);
+typedef void (*sha256_double64_t)(struct sha256[], const struct sha256[], size_t);
+typedef size_t (*sha256_double64_meets_target_t)(unsigned char[], const struct sha256[], size_t, const struct sha256*);
+typedef void (*sha256_midstate_t)(struct sha256[], const uint32_t[8], const unsigned char[], size_t);
+typedef void (*sha256_merkle_root_t)(struct sha256*, struct sha256[], size_t);
+typedef int (*sha256_merkle_root_mutated_t)(struct sha256*, struct sha256[], size_t);
+typedef size_t (*sha256_check_headers_t)(unsigned char[], struct sha256[], const unsigned char[], size_t);
+typedef size_t (*sha256_grind_t)(uint32_t[], size_t, const uint32_t[8], const unsigned char[64], size_t, uint32_t, uint64_t, const struct sha256*, int);
+
+SHA256_RESOLVER(sha256_update, sha256_update_t)
+SHA256_RESOLVER(sha256_done, sha256_done_t)
+SHA256_RESOLVER(sha256_double64, sha256_double64_t)
+SHA256_RESOLVER(sha256_double64_meets_target, sha256_double64_meets_target_t)
+SHA256_RESOLVER(sha256_midstate, sha256_midstate_t)
+SHA256_RESOLVER(sha256_merkle_root, sha256_merkle_root_t)
+SHA256_RESOLVER(sha256_merkle_root_mutated, sha256_merkle_root_mutated_t)
+SHA256_RESOLVER(sha256_check_headers, sha256_check_headers_t)
+SHA256_RESOLVER(sha256_grind, sha256_grind_t)
+
+void sha256_update(struct sha256_ctx* ctx, const void *data, size_t len) __attribute__((ifunc("sha256_update_resolve")));
+void sha256_done(struct sha256* hash, struct sha256_ctx* ctx) __attribute__((ifunc("sha256_done_resolve")));
+void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t blocks) __attribute__((ifunc("sha256_double64_resolve")));
+size_t sha256_double64_meets_target(unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target) __attribute__((ifunc("sha256_double64_meets_target_resolve")));
+void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks) __attribute__((ifunc("sha256_midstate_resolve")));
+void sha256_merkle_root(struct sha256* root, struct sha256 hashes[], size_t count) __attribute__((ifunc("sha256_merkle_root_resolve")));
+int sha256_merkle_root_mutated(struct sha256* root, struct sha256 hashes[], size_t count) __attribute__((ifunc("sha256_merkle_root_mutated_resolve")));
+size_t sha256_check_headers(unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count) __attribute__((ifunc("sha256_check_headers_resolve")));
+size_t sha256_grind(uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice) __attribute__((ifunc("sha256_grind_resolve")));
+
+/* The resolvers run before relocation is complete, so they cannot run the
+ * self-test themselves.  Run it once at load time instead, on the same
+ * backend the resolvers bound, so that a broken kernel is still caught. */
+static void __attribute__((constructor)) sha256_ifunc_self_test(void)
+{
+        (void)get_dispatch();
+}
+#else
+void sha256_update(struct sha256_ctx* ctx, const void *data, size_t len)
+{
+        sha256_update_impl(get_dispatch(), ctx, data, len);
+}
+
+void sha256_done(struct sha256* hash, struct sha256_ctx* ctx)
+{
+        sha256_done_impl(get_dispatch(), hash, ctx);
+}
+
+void sha256_double64(struct sha256 out[], const struct sha256 in[], size_t blocks)
+{
+        sha256_double64_impl(get_dispatch(), out, in, blocks);
+}
+
+size_t sha256_double64_meets_target(unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target)
+{
+        return sha256_double64_meets_target_impl(get_dispatch(), bitmap, in, blocks, target);
+}
+
+void sha256_midstate(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks)
+{
+        sha256_midstate_impl(get_dispatch(), out, midstate, in, blocks);
+}
+
+void sha256_merkle_root(struct sha256* root, struct sha256 hashes[], size_t count)
+{
+        sha256_merkle_root_impl(get_dispatch(), root, hashes, count, 0);
+}
+
+int sha256_merkle_root_mutated(struct sha256* root, struct sha256 hashes[], size_t count)
+{
+        return sha256_merkle_root_impl(get_dispatch(), root, hashes, count, !0);
+}
+
+size_t sha256_check_headers(unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count)
+{
+        return sha256_check_headers_impl(get_dispatch(), bitmap, hashes, headers, count);
+}
+
+size_t sha256_grind(uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice)
+{
+        return sha256_grind_impl(get_dispatch(), nonces, max_nonces, midstate, tail, nonce_offset, start, count, target, twice);
+}
+#endif /* defined(SHA256_USE_IFUNC) */
+
+void sha256_pbkdf2_iterate(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t count, size_t iterations)
+{
+        sha256_pbkdf2_iterate_impl(get_dispatch(), f, u, inner, outer, count, iterations);
+}
+
+void sha256_midstate_final64(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t count)
+{
+        sha256_midstate_final64_impl(get_dispatch(), out, midstate, in, count);
+}
+
+/* Backend registry */
+
+size_t sha256_backend_count(void)
+{
+        return SHA256_BACKEND_COUNT;
+}
+
+const char* sha256_backend_id(size_t backend)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        return dispatch_tables[backend].id;
+}
+
+int sha256_backend_supported(size_t backend)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        return (sha256_supported_backends(sha256_hwcap()) >> backend) & 1;
+}
+
+size_t sha256_backend_find(const char* id)
+{
+        size_t backend;
+        assert(id);
+        for (backend = 0; backend < SHA256_BACKEND_COUNT; ++backend) {
+                if (!strcmp(dispatch_tables[backend].id, id)) break;
+        }
+        return backend;
+}
+
+size_t sha256_backend_selected(void)
+{
+        return (size_t)(get_dispatch() - dispatch_tables);
+}
+
+void sha256_backend_describe(size_t backend, struct sha256_backend_info* info)
+{
+        const struct sha256_dispatch* d;
+        assert(backend < SHA256_BACKEND_COUNT && info);
+        d = &dispatch_tables[backend];
+        info->id = d->id;
+        info->name = d->name;
+        info->supported = sha256_backend_supported(backend);
+        info->double64_lanes = 1u << 1;
+        if (d->transform_d64_2way) info->double64_lanes |= 1u << 2;
+        if (d->transform_d64_4way) info->double64_lanes |= 1u << 4;
+        if (d->transform_d64_8way) info->double64_lanes |= 1u << 8;
+        if (d->transform_d64_16way) info->double64_lanes |= 1u << 16;
+        info->midstate_lanes = 1u << 1;
+        if (d->transform_2way) info->midstate_lanes |= 1u << 2;
+        if (d->transform_4way) info->midstate_lanes |= 1u << 4;
+        if (d->transform_8way) info->midstate_lanes |= 1u << 8;
+        if (d->transform_16way) info->midstate_lanes |= 1u << 16;
+        info->mb_lanes = d->mb_lanes;
+}
+
+#ifndef NDEBUG
+/* Whether each backend has passed its self-test, for backends other than the
+ * selected one, which is tested when it is selected. */
+static int backend_tested[SHA256_BACKEND_COUNT];
+#endif
+
+const struct sha256_functions* sha256_backend_functions(size_t backend)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        if (!sha256_backend_supported(backend)) {
+                return NULL;
+        }
+#ifndef NDEBUG
+        if (!__atomic_load_n(&backend_tested[backend], __ATOMIC_ACQUIRE)) {
+                assert(self_test(&dispatch_tables[backend]));
+                __atomic_store_n(&backend_tested[backend], !0, __ATOMIC_RELEASE);
+        }
+#endif
+        return &backend_functions[backend];
+}
+
+/* Backend-specific entry points, for benchmarks and tests. */
+
+void sha256_update_backend(size_t backend, struct sha256_ctx* ctx, const void *data, size_t len)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_update_impl(&dispatch_tables[backend], ctx, data, len);
+}
+
+void sha256_done_backend(size_t backend, struct sha256* hash, struct sha256_ctx* ctx)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_done_impl(&dispatch_tables[backend], hash, ctx);
+}
+
+void sha256_double64_backend(size_t backend, struct sha256 out[], const struct sha256 in[], size_t blocks)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_double64_impl(&dispatch_tables[backend], out, in, blocks);
+}
+
+size_t sha256_double64_meets_target_backend(size_t backend, unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        return sha256_double64_meets_target_impl(&dispatch_tables[backend], bitmap, in, blocks, target);
+}
+
+void sha256_midstate_backend(size_t backend, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_midstate_impl(&dispatch_tables[backend], out, midstate, in, blocks);
+}
+
+void sha256_merkle_root_backend(size_t backend, struct sha256* root, struct sha256 hashes[], size_t count)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_merkle_root_impl(&dispatch_tables[backend], root, hashes, count, 0);
+}
+
+size_t sha256_check_headers_backend(size_t backend, unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        return sha256_check_headers_impl(&dispatch_tables[backend], bitmap, hashes, headers, count);
+}
+
+size_t sha256_grind_backend(size_t backend, uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        return sha256_grind_impl(&dispatch_tables[backend], nonces, max_nonces, midstate, tail, nonce_offset, start, count, target, twice);
+}
+
+void sha256_pbkdf2_iterate_backend(size_t backend, uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t count, size_t iterations)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_pbkdf2_iterate_impl(&dispatch_tables[backend], f, u, inner, outer, count, iterations);
+}
+
+void sha256_midstate_final64_backend(size_t backend, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t count)
+{
+        assert(backend < SHA256_BACKEND_COUNT);
+        sha256_midstate_final64_impl(&dispatch_tables[backend], out, midstate, in, count);
+}
+
+/* Multi-buffer manager */
+
+void sha256_mb_init(struct sha256_mb_mgr* mgr)
+{
+        assert(mgr);
+        memset(mgr->job, 0, sizeof(mgr->job));
+        mgr->lanes = get_dispatch()->mb_lanes;
+        mgr->busy = 0;
+}
+
+/** Remove and return a lane's finished job, writing out its hash. */
+static struct sha256_mb_job* sha256_mb_complete(struct sha256_mb_mgr* mgr, unsigned lane)
+{
+        struct sha256_mb_job* job = mgr->job[lane];
+        int i;
+        for (i = 0; i < 8; ++i) {
+                WriteBE32(&job->hash.u8[4*i], mgr->s[i*mgr->lanes + lane]);
+        }
+        mgr->job[lane] = NULL;
+        --mgr->busy;
+        return job;
+}
+
+/** Hash all lanes until a job is finished, and return it. */
+static struct sha256_mb_job* sha256_mb_run(struct sha256_mb_mgr* mgr)
+{
+        unsigned i, active;
+        size_t blocks;
+        while (1) {
+                /* Return any job which is finished, and find the number of
+                 * blocks which can be hashed in all active lanes. */
+                active = mgr->lanes;
+                blocks = 0;
+                for (i = 0; i < mgr->lanes; ++i) {
+                        if (!mgr->job[i]) {
+                                continue;
+                        }
+                        if (!mgr->blocks[i]) {
+                                return sha256_mb_complete(mgr, i);
+                        }
+                        if (active == mgr->lanes || mgr->blocks[i] < blocks) {
+                                blocks = mgr->blocks[i];
+                        }
+                        active = i;
+                }
+                if (active == mgr->lanes) {
+                        return NULL;
+                }
+                /* Idle lanes hash the data of an active lane, and their
+                 * results are discarded. */
+                for (i = 0; i < mgr->lanes; ++i) {
+                        if (!mgr->job[i]) {
+                                mgr->ptr[i] = mgr->ptr[active];
+                        }
+                }
+                sha256_mb_transform(get_dispatch(), mgr, blocks);
+                for (i = 0; i < mgr->lanes; ++i) {
+                        if (!mgr->job[i]) {
+                                continue;
+                        }
+                        mgr->ptr[i] += 64 * blocks;
+                        mgr->blocks[i] -= blocks;
+                        if (!mgr->blocks[i] && mgr->tail_blocks[i]) {
+                                mgr->ptr[i] = mgr->tail[i];
+                                mgr->blocks[i] = mgr->tail_blocks[i];
+                                mgr->tail_blocks[i] = 0;
+                        }
+                }
+        }
+}
+
+struct sha256_mb_job* sha256_mb_submit_midstate(struct sha256_mb_mgr* mgr, struct sha256_mb_job* job, const uint32_t midstate[8], uint64_t offset)
+{
+        unsigned char* tail;
+        size_t rem;
+        unsigned lane, i;
+        assert(mgr && job && midstate);
+        assert(offset % 64 == 0);
+        assert(mgr->busy < mgr->lanes);
+        for (lane = 0; mgr->job[lane]; ++lane)
+                ;
+        for (i = 0; i < 8; ++i) {
+                mgr->s[i*mgr->lanes + lane] = midstate[i];
+        }
+        /* The final partial block of the message, plus padding and length,
+         * is hashed from the lane's tail buffer once the message's full
+         * blocks are consumed. */
+        rem = job->len % 64;
+        tail = mgr->tail[lane];
+        mgr->tail_blocks[lane] = 1 + (rem >= 56);
+        if (rem) {
+                memcpy(tail, (const unsigned char*)job->data + (job->len - rem), rem);
+        }
+        tail[rem] = 0x80;
+        memset(tail + rem + 1, 0, 64 * mgr->tail_blocks[lane] - 9 - rem);
+        WriteBE64(tail + 64 * mgr->tail_blocks[lane] - 8, (offset + job->len) << 3);
+        mgr->ptr[lane] = (const unsigned char*)job->data;
+        mgr->blocks[lane] = job->len / 64;
+        if (!mgr->blocks[lane]) {
+                mgr->ptr[lane] = tail;
+                mgr->blocks[lane] = mgr->tail_blocks[lane];
+                mgr->tail_blocks[lane] = 0;
+        }
+        mgr->job[lane] = job;
+        if (++mgr->busy < mgr->lanes) {
+                return NULL;
+        }
+        return sha256_mb_run(mgr);
+}
+
+struct sha256_mb_job* sha256_mb_submit(struct sha256_mb_mgr* mgr, struct sha256_mb_job* job)
+{
+        uint32_t init[8];
+        Initialize(init);
+        return sha256_mb_submit_midstate(mgr, job, init, 0);
+}
+
+struct sha256_mb_job* sha256_mb_flush(struct sha256_mb_mgr* mgr)
+{
+        assert(mgr);
+        return sha256_mb_run(mgr);
+}
+
+/* Batch double SHA256 */
+
+void sha256_double_batch(struct sha256 out[], const void* const data[], const size_t lens[], size_t count)
+{
+        struct sha256_mb_mgr mgr;
+        struct sha256_mb_job job[SHA256_MB_MAX_LANES];
+        size_t index[SHA256_MB_MAX_LANES];
+        unsigned free_slot[SHA256_MB_MAX_LANES];
+        unsigned num_free, slot;
+        struct sha256_mb_job* done;
+        size_t next = 0;
+
+        assert(out && data && lens);
+        sha256_mb_init(&mgr);
+        for (slot = 0; slot < mgr.lanes; ++slot) {
+                free_slot[slot] = slot;
+        }
+        num_free = mgr.lanes;
+
+        /* The first hashes run through the multi-buffer manager, which
+         * refills each lane as soon as its message is consumed, so that a long
+         * message holds up only its own lane. */
+        while (1) {
+                if (num_free && next < count) {
+                        slot = free_slot[--num_free];
+                        index[slot] = next;
+                        job[slot].data = data[next];
+                        job[slot].len = lens[next];
+                        done = sha256_mb_submit(&mgr, &job[slot]);
+                        ++next;
+                } else if (!(done = sha256_mb_flush(&mgr))) {
+                        break;
+                }
+                if (done) {
+                        slot = (unsigned)(done - job);
+                        out[index[slot]] = done->hash;
+                        free_slot[num_free++] = slot;
+                }
+        }
+
+        /* Every second hash is of 32 bytes, so they all run through the
+         * fixed-length kernels in full lanes. */
+        sha256_double32_impl(get_dispatch(), out, out, count);
+}
+
 /* End of File
  */
@@ -920,6 +920,1948 @@ void transform_sha256d64_armv8_2way(struct sha256 out[2], const struct sha256 in
         vst1q_u8(&out[1].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1B)));
 }
 
+
+/**
+ * @brief Compress two blocks from the same midstate.
+ *
+ * Block i is at in + 64*i, and out[i] is the midstate after it, as a hash.
+ * The two compressions are independent, so their instructions interleave
+ * and keep two of the crypto pipelines of a Neoverse core busy.
+ */
+void transform_sha256multi_armv8_2way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        uint32x4_t STATE0A, STATE1A, STATE0B, STATE1B;
+        uint32x4_t MSG0A, MSG1A, MSG2A, MSG3A, MSG0B, MSG1B, MSG2B, MSG3B;
+        uint32x4_t TMP0A, TMP2A, TMP0B, TMP2B, TMP;
+
+        /* Load midstate */
+        STATE0A = vld1q_u32(&s[0]);
+        STATE0B = STATE0A;
+        STATE1A = vld1q_u32(&s[4]);
+        STATE1B = STATE1A;
+
+        /* Load and convert input data to Big Endian */
+        MSG0A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 0)));
+        MSG1A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 16)));
+        MSG2A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 32)));
+        MSG3A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 48)));
+        MSG0B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 64)));
+        MSG1B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 80)));
+        MSG2B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 96)));
+        MSG3B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 112)));
+
+        /* Rounds 1-4 */
+        TMP = vld1q_u32(&K[0]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+
+        /* Rounds 5-8 */
+        TMP = vld1q_u32(&K[4]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+
+        /* Rounds 9-12 */
+        TMP = vld1q_u32(&K[8]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+
+        /* Rounds 13-16 */
+        TMP = vld1q_u32(&K[12]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+
+        /* Rounds 17-20 */
+        TMP = vld1q_u32(&K[16]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+
+        /* Rounds 21-24 */
+        TMP = vld1q_u32(&K[20]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+
+        /* Rounds 25-28 */
+        TMP = vld1q_u32(&K[24]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+
+        /* Rounds 29-32 */
+        TMP = vld1q_u32(&K[28]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+
+        /* Rounds 33-36 */
+        TMP = vld1q_u32(&K[32]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+
+        /* Rounds 37-40 */
+        TMP = vld1q_u32(&K[36]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+
+        /* Rounds 41-44 */
+        TMP = vld1q_u32(&K[40]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+
+        /* Rounds 45-48 */
+        TMP = vld1q_u32(&K[44]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+
+        /* Rounds 49-52 */
+        TMP = vld1q_u32(&K[48]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+
+        /* Rounds 53-56 */
+        TMP = vld1q_u32(&K[52]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+
+        /* Rounds 57-60 */
+        TMP = vld1q_u32(&K[56]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+
+        /* Rounds 61-64 */
+        TMP = vld1q_u32(&K[60]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+
+        /* Combine with midstate */
+        TMP = vld1q_u32(&s[0]);
+        STATE0A = vaddq_u32(STATE0A, TMP);
+        STATE0B = vaddq_u32(STATE0B, TMP);
+        TMP = vld1q_u32(&s[4]);
+        STATE1A = vaddq_u32(STATE1A, TMP);
+        STATE1B = vaddq_u32(STATE1B, TMP);
+
+        /* Store result */
+        vst1q_u8(&out[0].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0A)));
+        vst1q_u8(&out[0].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1A)));
+        vst1q_u8(&out[1].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0B)));
+        vst1q_u8(&out[1].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1B)));
+}
+
+/**
+ * @brief Compress four blocks from the same midstate.
+ *
+ * As transform_sha256multi_armv8_2way, for cores such as Neoverse V1 and N2
+ * whose SHA256H latency is covered only by four independent chains.
+ */
+void transform_sha256multi_armv8_4way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        uint32x4_t STATE0A, STATE1A, STATE0B, STATE1B, STATE0C, STATE1C, STATE0D, STATE1D;
+        uint32x4_t MSG0A, MSG1A, MSG2A, MSG3A, MSG0B, MSG1B, MSG2B, MSG3B, MSG0C, MSG1C, MSG2C, MSG3C, MSG0D, MSG1D, MSG2D, MSG3D;
+        uint32x4_t TMP0A, TMP2A, TMP0B, TMP2B, TMP0C, TMP2C, TMP0D, TMP2D, TMP;
+
+        /* Load midstate */
+        STATE0A = vld1q_u32(&s[0]);
+        STATE0B = STATE0A;
+        STATE0C = STATE0A;
+        STATE0D = STATE0A;
+        STATE1A = vld1q_u32(&s[4]);
+        STATE1B = STATE1A;
+        STATE1C = STATE1A;
+        STATE1D = STATE1A;
+
+        /* Load and convert input data to Big Endian */
+        MSG0A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 0)));
+        MSG1A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 16)));
+        MSG2A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 32)));
+        MSG3A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 48)));
+        MSG0B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 64)));
+        MSG1B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 80)));
+        MSG2B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 96)));
+        MSG3B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 112)));
+        MSG0C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 128)));
+        MSG1C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 144)));
+        MSG2C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 160)));
+        MSG3C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 176)));
+        MSG0D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 192)));
+        MSG1D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 208)));
+        MSG2D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 224)));
+        MSG3D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 240)));
+
+        /* Rounds 1-4 */
+        TMP = vld1q_u32(&K[0]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Rounds 5-8 */
+        TMP = vld1q_u32(&K[4]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Rounds 9-12 */
+        TMP = vld1q_u32(&K[8]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Rounds 13-16 */
+        TMP = vld1q_u32(&K[12]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Rounds 17-20 */
+        TMP = vld1q_u32(&K[16]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Rounds 21-24 */
+        TMP = vld1q_u32(&K[20]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Rounds 25-28 */
+        TMP = vld1q_u32(&K[24]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Rounds 29-32 */
+        TMP = vld1q_u32(&K[28]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Rounds 33-36 */
+        TMP = vld1q_u32(&K[32]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Rounds 37-40 */
+        TMP = vld1q_u32(&K[36]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Rounds 41-44 */
+        TMP = vld1q_u32(&K[40]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Rounds 45-48 */
+        TMP = vld1q_u32(&K[44]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Rounds 49-52 */
+        TMP = vld1q_u32(&K[48]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Rounds 53-56 */
+        TMP = vld1q_u32(&K[52]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Rounds 57-60 */
+        TMP = vld1q_u32(&K[56]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Rounds 61-64 */
+        TMP = vld1q_u32(&K[60]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Combine with midstate */
+        TMP = vld1q_u32(&s[0]);
+        STATE0A = vaddq_u32(STATE0A, TMP);
+        STATE0B = vaddq_u32(STATE0B, TMP);
+        STATE0C = vaddq_u32(STATE0C, TMP);
+        STATE0D = vaddq_u32(STATE0D, TMP);
+        TMP = vld1q_u32(&s[4]);
+        STATE1A = vaddq_u32(STATE1A, TMP);
+        STATE1B = vaddq_u32(STATE1B, TMP);
+        STATE1C = vaddq_u32(STATE1C, TMP);
+        STATE1D = vaddq_u32(STATE1D, TMP);
+
+        /* Store result */
+        vst1q_u8(&out[0].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0A)));
+        vst1q_u8(&out[0].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1A)));
+        vst1q_u8(&out[1].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0B)));
+        vst1q_u8(&out[1].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1B)));
+        vst1q_u8(&out[2].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0C)));
+        vst1q_u8(&out[2].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1C)));
+        vst1q_u8(&out[3].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0D)));
+        vst1q_u8(&out[3].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1D)));
+}
+
+/**
+ * @brief The double SHA256 of four 64-byte messages, interleaved as in
+ * transform_sha256d64_armv8_2way.
+ */
+void transform_sha256d64_armv8_4way(struct sha256 out[4], const struct sha256 in[8])
+{
+        /* Initial state. */
+        static const __attribute__((aligned (16))) uint32_t INIT[8] = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+
+        /* Precomputed message schedule for the 2nd transform. */
+        static const __attribute__((aligned (16))) uint32_t MIDS[64] = {
+                0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+                0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+                0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+                0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254,
+                0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+                0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7,
+                0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+                0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd,
+                0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+                0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537,
+                0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+                0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7,
+                0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+                0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c,
+                0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76
+        };
+
+        /* A few precomputed message schedule values for the 3rd transform. */
+        static const __attribute__((aligned (16))) uint32_t FINS[12] = {
+                0x5807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+                0x80000000, 0x00000000, 0x00000000, 0x00000000,
+                0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf274
+        };
+
+        /* Padding processed in the 3rd transform (byteswapped). */
+        static const __attribute__((aligned (16))) uint32_t FINAL[8] = {0x80000000, 0, 0, 0, 0, 0, 0, 0x100};
+
+        uint32x4_t STATE0A, STATE0B, STATE0C, STATE0D, STATE1A, STATE1B, STATE1C, STATE1D, ABEF_SAVEA, ABEF_SAVEB, ABEF_SAVEC, ABEF_SAVED, CDGH_SAVEA, CDGH_SAVEB, CDGH_SAVEC, CDGH_SAVED;
+        uint32x4_t MSG0A, MSG0B, MSG0C, MSG0D, MSG1A, MSG1B, MSG1C, MSG1D, MSG2A, MSG2B, MSG2C, MSG2D, MSG3A, MSG3B, MSG3C, MSG3D;
+        uint32x4_t TMP0A, TMP0B, TMP0C, TMP0D, TMP2A, TMP2B, TMP2C, TMP2D, TMP;
+
+        /* Transform 1: Load state */
+        STATE0A = vld1q_u32(&INIT[0]);
+        STATE0B = vld1q_u32(&INIT[0]);
+        STATE0C = vld1q_u32(&INIT[0]);
+        STATE0D = vld1q_u32(&INIT[0]);
+        STATE0B = STATE0A;
+        STATE0C = STATE0A;
+        STATE0D = STATE0A;
+        STATE1A = vld1q_u32(&INIT[4]);
+        STATE1B = vld1q_u32(&INIT[4]);
+        STATE1C = vld1q_u32(&INIT[4]);
+        STATE1D = vld1q_u32(&INIT[4]);
+        STATE1B = STATE1A;
+        STATE1C = STATE1A;
+        STATE1D = STATE1A;
+
+        /* Transform 1: Load and convert input data to Big Endian */
+        MSG0A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[0].u8[0])));
+        MSG1A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[0].u8[16])));
+        MSG2A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[1].u8[0])));
+        MSG3A = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[1].u8[16])));
+        MSG0B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[2].u8[0])));
+        MSG1B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[2].u8[16])));
+        MSG2B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[3].u8[0])));
+        MSG3B = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[3].u8[16])));
+        MSG0C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[4].u8[0])));
+        MSG1C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[4].u8[16])));
+        MSG2C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[5].u8[0])));
+        MSG3C = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[5].u8[16])));
+        MSG0D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[6].u8[0])));
+        MSG1D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[6].u8[16])));
+        MSG2D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[7].u8[0])));
+        MSG3D = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&in[7].u8[16])));
+
+        /* Transform 1: Rounds 1-4 */
+        TMP = vld1q_u32(&K[0]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 1: Rounds 5-8 */
+        TMP = vld1q_u32(&K[4]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 1: Rounds 9-12 */
+        TMP = vld1q_u32(&K[8]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 1: Rounds 13-16 */
+        TMP = vld1q_u32(&K[12]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 1: Rounds 17-20 */
+        TMP = vld1q_u32(&K[16]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 1: Rounds 21-24 */
+        TMP = vld1q_u32(&K[20]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 1: Rounds 25-28 */
+        TMP = vld1q_u32(&K[24]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 1: Rounds 29-32 */
+        TMP = vld1q_u32(&K[28]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 1: Rounds 33-36 */
+        TMP = vld1q_u32(&K[32]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 1: Rounds 37-40 */
+        TMP = vld1q_u32(&K[36]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 1: Rounds 41-44 */
+        TMP = vld1q_u32(&K[40]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 1: Rounds 45-48 */
+        TMP = vld1q_u32(&K[44]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 1: Rounds 49-52 */
+        TMP = vld1q_u32(&K[48]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 1: Rounds 53-56 */
+        TMP = vld1q_u32(&K[52]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 1: Rounds 57-60 */
+        TMP = vld1q_u32(&K[56]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 1: Rounds 61-64 */
+        TMP = vld1q_u32(&K[60]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 1: Update state */
+        TMP = vld1q_u32(&INIT[0]);
+        STATE0A = vaddq_u32(STATE0A, TMP);
+        STATE0B = vaddq_u32(STATE0B, TMP);
+        STATE0C = vaddq_u32(STATE0C, TMP);
+        STATE0D = vaddq_u32(STATE0D, TMP);
+        TMP = vld1q_u32(&INIT[4]);
+        STATE1A = vaddq_u32(STATE1A, TMP);
+        STATE1B = vaddq_u32(STATE1B, TMP);
+        STATE1C = vaddq_u32(STATE1C, TMP);
+        STATE1D = vaddq_u32(STATE1D, TMP);
+
+        /* Transform 2: Save state */
+        ABEF_SAVEA = STATE0A;
+        ABEF_SAVEB = STATE0B;
+        ABEF_SAVEC = STATE0C;
+        ABEF_SAVED = STATE0D;
+        CDGH_SAVEA = STATE1A;
+        CDGH_SAVEB = STATE1B;
+        CDGH_SAVEC = STATE1C;
+        CDGH_SAVED = STATE1D;
+
+        /* Transform 2: Rounds 1-4 */
+        TMP = vld1q_u32(&MIDS[0]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 5-8 */
+        TMP = vld1q_u32(&MIDS[4]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 9-12 */
+        TMP = vld1q_u32(&MIDS[8]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 13-16 */
+        TMP = vld1q_u32(&MIDS[12]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 17-20 */
+        TMP = vld1q_u32(&MIDS[16]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 21-24 */
+        TMP = vld1q_u32(&MIDS[20]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 25-28 */
+        TMP = vld1q_u32(&MIDS[24]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 29-32 */
+        TMP = vld1q_u32(&MIDS[28]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 33-36 */
+        TMP = vld1q_u32(&MIDS[32]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 37-40 */
+        TMP = vld1q_u32(&MIDS[36]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 41-44 */
+        TMP = vld1q_u32(&MIDS[40]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 45-48 */
+        TMP = vld1q_u32(&MIDS[44]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 49-52 */
+        TMP = vld1q_u32(&MIDS[48]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 53-56 */
+        TMP = vld1q_u32(&MIDS[52]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 57-60 */
+        TMP = vld1q_u32(&MIDS[56]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Rounds 61-64 */
+        TMP = vld1q_u32(&MIDS[60]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+
+        /* Transform 2: Update state */
+        STATE0A = vaddq_u32(STATE0A, ABEF_SAVEA);
+        STATE0B = vaddq_u32(STATE0B, ABEF_SAVEB);
+        STATE0C = vaddq_u32(STATE0C, ABEF_SAVEC);
+        STATE0D = vaddq_u32(STATE0D, ABEF_SAVED);
+        STATE1A = vaddq_u32(STATE1A, CDGH_SAVEA);
+        STATE1B = vaddq_u32(STATE1B, CDGH_SAVEB);
+        STATE1C = vaddq_u32(STATE1C, CDGH_SAVEC);
+        STATE1D = vaddq_u32(STATE1D, CDGH_SAVED);
+
+        /* Transform 3: Pad previous output */
+        MSG0A = STATE0A;
+        MSG0B = STATE0B;
+        MSG0C = STATE0C;
+        MSG0D = STATE0D;
+        MSG1A = STATE1A;
+        MSG1B = STATE1B;
+        MSG1C = STATE1C;
+        MSG1D = STATE1D;
+        MSG2A = vld1q_u32(&FINAL[0]);
+        MSG2B = vld1q_u32(&FINAL[0]);
+        MSG2C = vld1q_u32(&FINAL[0]);
+        MSG2D = vld1q_u32(&FINAL[0]);
+        MSG2B = MSG2A;
+        MSG2C = MSG2A;
+        MSG2D = MSG2A;
+        MSG3A = vld1q_u32(&FINAL[4]);
+        MSG3B = vld1q_u32(&FINAL[4]);
+        MSG3C = vld1q_u32(&FINAL[4]);
+        MSG3D = vld1q_u32(&FINAL[4]);
+        MSG3B = MSG3A;
+        MSG3C = MSG3A;
+        MSG3D = MSG3A;
+
+        /* Transform 3: Load state */
+        STATE0A = vld1q_u32(&INIT[0]);
+        STATE0B = vld1q_u32(&INIT[0]);
+        STATE0C = vld1q_u32(&INIT[0]);
+        STATE0D = vld1q_u32(&INIT[0]);
+        STATE0B = STATE0A;
+        STATE0C = STATE0A;
+        STATE0D = STATE0A;
+        STATE1A = vld1q_u32(&INIT[4]);
+        STATE1B = vld1q_u32(&INIT[4]);
+        STATE1C = vld1q_u32(&INIT[4]);
+        STATE1D = vld1q_u32(&INIT[4]);
+        STATE1B = STATE1A;
+        STATE1C = STATE1A;
+        STATE1D = STATE1A;
+
+        /* Transform 3: Rounds 1-4 */
+        TMP = vld1q_u32(&K[0]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 3: Rounds 5-8 */
+        TMP = vld1q_u32(&K[4]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 3: Rounds 9-12 */
+        TMP = vld1q_u32(&FINS[0]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vld1q_u32(&FINS[4]);
+        MSG2B = vld1q_u32(&FINS[4]);
+        MSG2C = vld1q_u32(&FINS[4]);
+        MSG2D = vld1q_u32(&FINS[4]);
+        MSG2B = MSG2A;
+        MSG2C = MSG2A;
+        MSG2D = MSG2A;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 3: Rounds 13-16 */
+        TMP = vld1q_u32(&FINS[8]);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 3: Rounds 17-20 */
+        TMP = vld1q_u32(&K[16]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 3: Rounds 21-24 */
+        TMP = vld1q_u32(&K[20]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 3: Rounds 25-28 */
+        TMP = vld1q_u32(&K[24]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 3: Rounds 29-32 */
+        TMP = vld1q_u32(&K[28]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 3: Rounds 33-36 */
+        TMP = vld1q_u32(&K[32]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG0A = vsha256su0q_u32(MSG0A, MSG1A);
+        MSG0B = vsha256su0q_u32(MSG0B, MSG1B);
+        MSG0C = vsha256su0q_u32(MSG0C, MSG1C);
+        MSG0D = vsha256su0q_u32(MSG0D, MSG1D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG0A = vsha256su1q_u32(MSG0A, MSG2A, MSG3A);
+        MSG0B = vsha256su1q_u32(MSG0B, MSG2B, MSG3B);
+        MSG0C = vsha256su1q_u32(MSG0C, MSG2C, MSG3C);
+        MSG0D = vsha256su1q_u32(MSG0D, MSG2D, MSG3D);
+
+        /* Transform 3: Rounds 37-40 */
+        TMP = vld1q_u32(&K[36]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG1A = vsha256su0q_u32(MSG1A, MSG2A);
+        MSG1B = vsha256su0q_u32(MSG1B, MSG2B);
+        MSG1C = vsha256su0q_u32(MSG1C, MSG2C);
+        MSG1D = vsha256su0q_u32(MSG1D, MSG2D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG1A = vsha256su1q_u32(MSG1A, MSG3A, MSG0A);
+        MSG1B = vsha256su1q_u32(MSG1B, MSG3B, MSG0B);
+        MSG1C = vsha256su1q_u32(MSG1C, MSG3C, MSG0C);
+        MSG1D = vsha256su1q_u32(MSG1D, MSG3D, MSG0D);
+
+        /* Transform 3: Rounds 41-44 */
+        TMP = vld1q_u32(&K[40]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG2A = vsha256su0q_u32(MSG2A, MSG3A);
+        MSG2B = vsha256su0q_u32(MSG2B, MSG3B);
+        MSG2C = vsha256su0q_u32(MSG2C, MSG3C);
+        MSG2D = vsha256su0q_u32(MSG2D, MSG3D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG2A = vsha256su1q_u32(MSG2A, MSG0A, MSG1A);
+        MSG2B = vsha256su1q_u32(MSG2B, MSG0B, MSG1B);
+        MSG2C = vsha256su1q_u32(MSG2C, MSG0C, MSG1C);
+        MSG2D = vsha256su1q_u32(MSG2D, MSG0D, MSG1D);
+
+        /* Transform 3: Rounds 45-48 */
+        TMP = vld1q_u32(&K[44]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        MSG3A = vsha256su0q_u32(MSG3A, MSG0A);
+        MSG3B = vsha256su0q_u32(MSG3B, MSG0B);
+        MSG3C = vsha256su0q_u32(MSG3C, MSG0C);
+        MSG3D = vsha256su0q_u32(MSG3D, MSG0D);
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+        MSG3A = vsha256su1q_u32(MSG3A, MSG1A, MSG2A);
+        MSG3B = vsha256su1q_u32(MSG3B, MSG1B, MSG2B);
+        MSG3C = vsha256su1q_u32(MSG3C, MSG1C, MSG2C);
+        MSG3D = vsha256su1q_u32(MSG3D, MSG1D, MSG2D);
+
+        /* Transform 3: Rounds 49-52 */
+        TMP = vld1q_u32(&K[48]);
+        TMP0A = vaddq_u32(MSG0A, TMP);
+        TMP0B = vaddq_u32(MSG0B, TMP);
+        TMP0C = vaddq_u32(MSG0C, TMP);
+        TMP0D = vaddq_u32(MSG0D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 3: Rounds 53-56 */
+        TMP = vld1q_u32(&K[52]);
+        TMP0A = vaddq_u32(MSG1A, TMP);
+        TMP0B = vaddq_u32(MSG1B, TMP);
+        TMP0C = vaddq_u32(MSG1C, TMP);
+        TMP0D = vaddq_u32(MSG1D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 3: Rounds 57-60 */
+        TMP = vld1q_u32(&K[56]);
+        TMP0A = vaddq_u32(MSG2A, TMP);
+        TMP0B = vaddq_u32(MSG2B, TMP);
+        TMP0C = vaddq_u32(MSG2C, TMP);
+        TMP0D = vaddq_u32(MSG2D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 3: Rounds 61-64 */
+        TMP = vld1q_u32(&K[60]);
+        TMP0A = vaddq_u32(MSG3A, TMP);
+        TMP0B = vaddq_u32(MSG3B, TMP);
+        TMP0C = vaddq_u32(MSG3C, TMP);
+        TMP0D = vaddq_u32(MSG3D, TMP);
+        TMP2A = STATE0A;
+        TMP2B = STATE0B;
+        TMP2C = STATE0C;
+        TMP2D = STATE0D;
+        STATE0A = vsha256hq_u32(STATE0A, STATE1A, TMP0A);
+        STATE0B = vsha256hq_u32(STATE0B, STATE1B, TMP0B);
+        STATE0C = vsha256hq_u32(STATE0C, STATE1C, TMP0C);
+        STATE0D = vsha256hq_u32(STATE0D, STATE1D, TMP0D);
+        STATE1A = vsha256h2q_u32(STATE1A, TMP2A, TMP0A);
+        STATE1B = vsha256h2q_u32(STATE1B, TMP2B, TMP0B);
+        STATE1C = vsha256h2q_u32(STATE1C, TMP2C, TMP0C);
+        STATE1D = vsha256h2q_u32(STATE1D, TMP2D, TMP0D);
+
+        /* Transform 3: Update state */
+        TMP = vld1q_u32(&INIT[0]);
+        STATE0A = vaddq_u32(STATE0A, TMP);
+        STATE0B = vaddq_u32(STATE0B, TMP);
+        STATE0C = vaddq_u32(STATE0C, TMP);
+        STATE0D = vaddq_u32(STATE0D, TMP);
+        TMP = vld1q_u32(&INIT[4]);
+        STATE1A = vaddq_u32(STATE1A, TMP);
+        STATE1B = vaddq_u32(STATE1B, TMP);
+        STATE1C = vaddq_u32(STATE1C, TMP);
+        STATE1D = vaddq_u32(STATE1D, TMP);
+
+        /* Store result */
+        vst1q_u8(&out[0].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0A)));
+        vst1q_u8(&out[0].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1A)));
+        vst1q_u8(&out[1].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0B)));
+        vst1q_u8(&out[1].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1B)));
+        vst1q_u8(&out[2].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0C)));
+        vst1q_u8(&out[2].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1C)));
+        vst1q_u8(&out[3].u8[0], vrev32q_u8(vreinterpretq_u8_u32(STATE0D)));
+        vst1q_u8(&out[3].u8[16], vrev32q_u8(vreinterpretq_u8_u32(STATE1D)));
+}
+
 #else
 /* -Wempty-translation-unit
  * ISO C requires a translation unit to contain at least one declaration
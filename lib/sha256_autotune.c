@@ -0,0 +1,310 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* for clock_gettime, fchmod and mkstemp */
+#define _POSIX_C_SOURCE 200809L
+
+#include <sha2/sha256.h>
+#include "common.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "compat/cpuid.h"
+
+/* The classes of operation, in the order of their backends in the cache. */
+#define AUTOTUNE_UPDATE 0
+#define AUTOTUNE_DOUBLE64 1
+#define AUTOTUNE_MIDSTATE 2
+#define AUTOTUNE_CLASSES 3
+
+/* Each measurement hashes AUTOTUNE_BLOCKS blocks at a time, for about 2ms of
+ * CPU time, and the best of AUTOTUNE_ROUNDS is kept, the first of which also
+ * warms up the kernel. */
+#define AUTOTUNE_BLOCKS 64
+#define AUTOTUNE_ROUNDS 3
+#define AUTOTUNE_NSEC 2000000L
+
+/* The CPU time of the calling thread, so that other threads of the process do
+ * not count against the kernel being measured. */
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+#define AUTOTUNE_CLOCK CLOCK_THREAD_CPUTIME_ID
+#else
+#define AUTOTUNE_CLOCK CLOCK_MONOTONIC
+#endif
+
+/* Another backend replaces the selected one only if it is faster by more
+ * than this factor, so that noise does not change the choice. */
+#define AUTOTUNE_MARGIN 1.03
+
+/* The length of the cache key in hex digits, without the terminating NUL. */
+#define AUTOTUNE_KEY_LEN 16
+
+struct autotune_buffers {
+        struct sha256 in[2 * AUTOTUNE_BLOCKS];
+        struct sha256 out[AUTOTUNE_BLOCKS];
+};
+
+/** Hash one batch of a class of operation. */
+static void autotune_run(const struct sha256_functions* fns, int op, struct autotune_buffers* b)
+{
+        struct sha256_ctx ctx = SHA256_INIT;
+
+        switch (op) {
+        case AUTOTUNE_UPDATE:
+                fns->update(&ctx, b->in, sizeof(b->in));
+                fns->done(b->out, &ctx);
+                break;
+        case AUTOTUNE_DOUBLE64:
+                fns->double64(b->out, b->in, AUTOTUNE_BLOCKS);
+                break;
+        default:
+                fns->midstate(b->out, ctx.s, (const unsigned char*)b->in, AUTOTUNE_BLOCKS);
+                break;
+        }
+}
+
+/** The time from start to now, in nanoseconds. */
+static double autotune_elapsed(const struct timespec* start, const struct timespec* now)
+{
+        return (double)(now->tv_sec - start->tv_sec) * 1e9 + (double)(now->tv_nsec - start->tv_nsec);
+}
+
+/** The best rate, in batches per nanosecond, of a class of operation, or zero
+ * if the clock is not available. */
+static double autotune_rate(const struct sha256_functions* fns, int op, struct autotune_buffers* b)
+{
+        double rate, elapsed, best = 0.0;
+        unsigned long runs;
+        struct timespec start, now;
+        int round;
+
+        for (round = 0; round < AUTOTUNE_ROUNDS; ++round) {
+                if (clock_gettime(AUTOTUNE_CLOCK, &start)) {
+                        return 0.0;
+                }
+                runs = 0;
+                do {
+                        autotune_run(fns, op, b);
+                        ++runs;
+                        if (clock_gettime(AUTOTUNE_CLOCK, &now)) {
+                                return 0.0;
+                        }
+                        elapsed = autotune_elapsed(&start, &now);
+                } while (elapsed < AUTOTUNE_NSEC);
+                rate = (double)runs / elapsed;
+                if (rate > best) {
+                        best = rate;
+                }
+        }
+        return best;
+}
+
+/** Measure each supported backend, and return the fastest for each class. */
+static void autotune_measure(size_t choice[AUTOTUNE_CLASSES])
+{
+        const struct sha256_functions* fns;
+        struct autotune_buffers b;
+        unsigned char* data = (unsigned char*)b.in;
+        size_t selected = sha256_backend_selected();
+        size_t backend, i;
+        double rate, best;
+        int op;
+
+        for (i = 0; i < sizeof(b.in); ++i) {
+                data[i] = (unsigned char)(i * 7 + 1);
+        }
+        for (op = 0; op < AUTOTUNE_CLASSES; ++op) {
+                choice[op] = selected;
+                best = autotune_rate(sha256_backend_functions(selected), op, &b);
+                for (backend = 0; backend < sha256_backend_count(); ++backend) {
+                        fns = sha256_backend_functions(backend);
+                        if (backend == selected || !fns) {
+                                continue;
+                        }
+                        rate = autotune_rate(fns, op, &b);
+                        if (rate > best * AUTOTUNE_MARGIN) {
+                                choice[op] = backend;
+                                best = rate;
+                        }
+                }
+        }
+}
+
+/** Add a word to the cache key. */
+static void autotune_key_word(struct sha256_ctx* ctx, uint32_t x)
+{
+        unsigned char buf[4];
+        WriteBE32(buf, x);
+        sha256_update(ctx, buf, sizeof(buf));
+}
+
+/** Write the cache key of the host and library, which is a hash of the CPUID
+ * signature and of the backends and which of them are supported. */
+static void autotune_key(char key[AUTOTUNE_KEY_LEN + 1])
+{
+        static const char hex[] = "0123456789abcdef";
+        struct sha256_ctx ctx = SHA256_INIT;
+        struct sha256 hash;
+        const char* id;
+        size_t backend;
+        int i;
+#if defined(HAVE_GETCPUID)
+        uint32_t max_leaf, eax, ebx, ecx, edx;
+
+        /* The vendor, the family, model and stepping, and the feature flags,
+         * but not the APIC ID in leaf 1 EBX, which differs between cores. */
+        GetCPUID(0, 0, &max_leaf, &ebx, &ecx, &edx);
+        autotune_key_word(&ctx, ebx);
+        autotune_key_word(&ctx, edx);
+        autotune_key_word(&ctx, ecx);
+        GetCPUID(1, 0, &eax, &ebx, &ecx, &edx);
+        autotune_key_word(&ctx, eax);
+        autotune_key_word(&ctx, ecx);
+        autotune_key_word(&ctx, edx);
+        if (max_leaf >= 7) {
+                GetCPUID(7, 0, &eax, &ebx, &ecx, &edx);
+                autotune_key_word(&ctx, ebx);
+                autotune_key_word(&ctx, ecx);
+        }
+#endif
+        for (backend = 0; backend < sha256_backend_count(); ++backend) {
+                id = sha256_backend_id(backend);
+                sha256_update(&ctx, id, strlen(id) + 1);
+                autotune_key_word(&ctx, (uint32_t)sha256_backend_supported(backend));
+        }
+        sha256_done(&hash, &ctx);
+        for (i = 0; i < AUTOTUNE_KEY_LEN / 2; ++i) {
+                key[2 * i] = hex[hash.u8[i] >> 4];
+                key[2 * i + 1] = hex[hash.u8[i] & 15];
+        }
+        key[AUTOTUNE_KEY_LEN] = '\0';
+}
+
+/** Read the choice from the cache, if it has the given key and names only
+ * supported backends. */
+static int autotune_load(size_t choice[AUTOTUNE_CLASSES], const char* cache, const char* key)
+{
+        char file_key[AUTOTUNE_KEY_LEN + 1];
+        char ids[AUTOTUNE_CLASSES][32];
+        FILE* f;
+        int n, op;
+
+        f = fopen(cache, "r");
+        if (!f) {
+                return 0;
+        }
+        n = fscanf(f, "%16s %31s %31s %31s", file_key, ids[0], ids[1], ids[2]);
+        fclose(f);
+        if (n != 1 + AUTOTUNE_CLASSES || strcmp(file_key, key)) {
+                return 0;
+        }
+        for (op = 0; op < AUTOTUNE_CLASSES; ++op) {
+                choice[op] = sha256_backend_find(ids[op]);
+                if (choice[op] == sha256_backend_count() || !sha256_backend_supported(choice[op])) {
+                        return 0;
+                }
+        }
+        return !0;
+}
+
+/** Write the choice to the cache, ignoring any error, since a damaged cache
+ * is only measured again.  The choice is written to a temporary file in the
+ * same directory which then replaces the cache, so that readers and other
+ * writers never see a partly written cache. */
+static void autotune_save(const size_t choice[AUTOTUNE_CLASSES], const char* cache, const char* key)
+{
+        static const char suffix[] = ".XXXXXX";
+        size_t len = strlen(cache);
+        char* tmp;
+        FILE* f;
+        int fd, ok;
+
+        tmp = (char*)malloc(len + sizeof(suffix));
+        if (!tmp) {
+                return;
+        }
+        memcpy(tmp, cache, len);
+        memcpy(tmp + len, suffix, sizeof(suffix));
+        fd = mkstemp(tmp);
+        if (fd < 0) {
+                free(tmp);
+                return;
+        }
+        /* mkstemp() creates the file readable only by its owner. */
+        (void)fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        f = fdopen(fd, "w");
+        if (!f) {
+                close(fd);
+                unlink(tmp);
+                free(tmp);
+                return;
+        }
+        ok = fprintf(f, "%s %s %s %s\n", key,
+                sha256_backend_id(choice[AUTOTUNE_UPDATE]),
+                sha256_backend_id(choice[AUTOTUNE_DOUBLE64]),
+                sha256_backend_id(choice[AUTOTUNE_MIDSTATE])) > 0;
+        ok = !fclose(f) && ok;
+        if (!ok || rename(tmp, cache)) {
+                unlink(tmp);
+        }
+        free(tmp);
+}
+
+int sha256_autotune(struct sha256_tuning* tuning, const char* cache)
+{
+        char key[AUTOTUNE_KEY_LEN + 1];
+        size_t choice[AUTOTUNE_CLASSES];
+        int cached = 0;
+
+        assert(tuning);
+        if (cache) {
+                autotune_key(key);
+                cached = autotune_load(choice, cache, key);
+        }
+        if (!cached) {
+                autotune_measure(choice);
+                if (cache) {
+                        autotune_save(choice, cache, key);
+                }
+        }
+        tuning->update = choice[AUTOTUNE_UPDATE];
+        tuning->double64 = choice[AUTOTUNE_DOUBLE64];
+        tuning->midstate = choice[AUTOTUNE_MIDSTATE];
+        return cached;
+}
+
+void sha256_tuned_functions(struct sha256_functions* fns, const struct sha256_tuning* tuning)
+{
+        const struct sha256_functions* update;
+        const struct sha256_functions* double64;
+        const struct sha256_functions* midstate;
+
+        assert(fns && tuning);
+        update = sha256_backend_functions(tuning->update);
+        double64 = sha256_backend_functions(tuning->double64);
+        midstate = sha256_backend_functions(tuning->midstate);
+        assert(update && double64 && midstate);
+
+        fns->update = update->update;
+        fns->done = update->done;
+        fns->double64 = double64->double64;
+        fns->double64_meets_target = double64->double64_meets_target;
+        fns->merkle_root = double64->merkle_root;
+        fns->merkle_root_mutated = double64->merkle_root_mutated;
+        fns->check_headers = double64->check_headers;
+        fns->midstate = midstate->midstate;
+        fns->grind = midstate->grind;
+}
+
+/* End of File
+ */
@@ -12,6 +12,7 @@
 #include "sha256_internal.h"
 
 #include <stdint.h> /* for uint32_t */
+#include <string.h> /* for memcpy */
 #include <immintrin.h> /* for assembly intrinsics */
 
 #include "common.h"
@@ -199,7 +200,113 @@ void transform_sha256multi_avx2_8way(struct sha256* out, const uint32_t* s, cons
         Write8_avx2(&out->u8[28], Add_avx2(h, K_avx2(s[7])));
 }
 
-void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[16])
+/** Hash eight 32-byte messages, whose words are w0 to w7, into out as the
+ * second hash of a double SHA256, or if top is set, compute only the last word
+ * of each hash and return it instead. */
+static inline __attribute__((always_inline)) __m256i sha256d32_avx2_8way(struct sha256 out[8], __m256i w0, __m256i w1, __m256i w2, __m256i w3, __m256i w4, __m256i w5, __m256i w6, __m256i w7, int top)
+{
+        __m256i a, b, c, d, e, f, g, h;
+        __m256i w8, w9, w10, w11, w12, w13, w14, w15;
+
+        a = K_avx2(1779033703);
+        b = K_avx2(-1150833019);
+        c = K_avx2(1013904242);
+        d = K_avx2(-1521486534);
+        e = K_avx2(1359893119);
+        f = K_avx2(-1694144372);
+        g = K_avx2(528734635);
+        h = K_avx2(1541459225);
+
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(961987163), w4));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1508970993), w5));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1841331548), w6));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1424204075), w7));
+        Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(1476897432));
+        Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(310598401));
+        Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(607225278));
+        Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(1426881987));
+        Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(1925078388));
+        Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(-2132889090));
+        Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(-1680079193));
+        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1046744460));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc_avx2(&w0, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc3_avx2(&w1, K_avx2(10485760), sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc3_avx2(&w2, sigma1_avx2(w0), sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc3_avx2(&w3, sigma1_avx2(w1), sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc3_avx2(&w4, sigma1_avx2(w2), sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc3_avx2(&w5, sigma1_avx2(w3), sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), K_avx2(256), sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, K_avx2(285220864))));
+        w8 = Add3_avx2(K_avx2(-2147483648), sigma1_avx2(w6), w1);
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), w8));
+        w9 = Add_avx2(sigma1_avx2(w7), w2);
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), w9));
+        w10 = Add_avx2(sigma1_avx2(w8), w3);
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), w10));
+        w11 = Add_avx2(sigma1_avx2(w9), w4);
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), w11));
+        w12 = Add_avx2(sigma1_avx2(w10), w5);
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), w12));
+        w13 = Add_avx2(sigma1_avx2(w11), w6);
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), w13));
+        w14 = Add3_avx2(sigma1_avx2(w12), w7, K_avx2(4194338));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), w14));
+        w15 = Add4_avx2(K_avx2(256), sigma1_avx2(w13), w8, sigma0_avx2(w0));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), w15));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        /* Rounds 61 to 63 only rotate h into its place as the last word of
+         * the hash. */
+        if (top) return Add_avx2(h, K_avx2(1541459225));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-1538233109), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add5_avx2(K_avx2(-1090935817), w14, sigma1_avx2(w12), w7, sigma0_avx2(w15)));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add5_avx2(K_avx2(-965641998), w15, sigma1_avx2(w13), w8, sigma0_avx2(w0)));
+
+        /* Output */
+        Write8_avx2(&out->u8[0], Add_avx2(a, K_avx2(1779033703)));
+        Write8_avx2(&out->u8[4], Add_avx2(b, K_avx2(-1150833019)));
+        Write8_avx2(&out->u8[8], Add_avx2(c, K_avx2(1013904242)));
+        Write8_avx2(&out->u8[12], Add_avx2(d, K_avx2(-1521486534)));
+        Write8_avx2(&out->u8[16], Add_avx2(e, K_avx2(1359893119)));
+        Write8_avx2(&out->u8[20], Add_avx2(f, K_avx2(-1694144372)));
+        Write8_avx2(&out->u8[24], Add_avx2(g, K_avx2(528734635)));
+        Write8_avx2(&out->u8[28], Add_avx2(h, K_avx2(1541459225)));
+        return h;
+}
+
+/** Double SHA256 eight 64-byte blocks, with top as for sha256d32_avx2_8way(). */
+static inline __attribute__((always_inline)) __m256i sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[16], int top)
 {
         /* Transform 1 */
         __m256i a = K_avx2(1779033703);
@@ -379,15 +486,445 @@ void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[
         w6 = Add_avx2(t6, g);
         w7 = Add_avx2(t7, h);
 
-        /* Transform 3 */
-        a = K_avx2(1779033703);
-        b = K_avx2(-1150833019);
-        c = K_avx2(1013904242);
-        d = K_avx2(-1521486534);
-        e = K_avx2(1359893119);
-        f = K_avx2(-1694144372);
-        g = K_avx2(528734635);
-        h = K_avx2(1541459225);
+        return sha256d32_avx2_8way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[16])
+{
+        sha256d64_avx2_8way(out, in, 0);
+}
+
+/* Read8_avx2(), for blocks at the 80-byte stride of block headers. */
+static inline __attribute__((always_inline)) __m256i ReadHeader8_avx2(const unsigned char* chunk)
+{
+        return _mm256_shuffle_epi8(
+                _mm256_set_epi32(
+                        ReadLE32(chunk + 0),
+                        ReadLE32(chunk + 80),
+                        ReadLE32(chunk + 160),
+                        ReadLE32(chunk + 240),
+                        ReadLE32(chunk + 320),
+                        ReadLE32(chunk + 400),
+                        ReadLE32(chunk + 480),
+                        ReadLE32(chunk + 560)),
+                _mm256_set_epi32(
+                        202182159, 134810123, 67438087, 66051,
+                        202182159, 134810123, 67438087, 66051));
+}
+
+/** Double SHA256 eight block headers, with top as for sha256d64_avx2_8way(). */
+static inline __attribute__((always_inline)) __m256i sha256d80_avx2_8way(struct sha256 out[8], const unsigned char in[640], int top)
+{
+        /* Transform 1 */
+        __m256i a = K_avx2(1779033703);
+        __m256i b = K_avx2(-1150833019);
+        __m256i c = K_avx2(1013904242);
+        __m256i d = K_avx2(-1521486534);
+        __m256i e = K_avx2(1359893119);
+        __m256i f = K_avx2(-1694144372);
+        __m256i g = K_avx2(528734635);
+        __m256i h = K_avx2(1541459225);
+
+        __m256i w0 = ReadHeader8_avx2(&in[0]),
+                w1 = ReadHeader8_avx2(&in[4]),
+                w2 = ReadHeader8_avx2(&in[8]),
+                w3 = ReadHeader8_avx2(&in[12]),
+                w4 = ReadHeader8_avx2(&in[16]),
+                w5 = ReadHeader8_avx2(&in[20]),
+                w6 = ReadHeader8_avx2(&in[24]),
+                w7 = ReadHeader8_avx2(&in[28]),
+                w8 = ReadHeader8_avx2(&in[32]),
+                w9 = ReadHeader8_avx2(&in[36]),
+                w10 = ReadHeader8_avx2(&in[40]),
+                w11 = ReadHeader8_avx2(&in[44]),
+                w12 = ReadHeader8_avx2(&in[48]),
+                w13 = ReadHeader8_avx2(&in[52]),
+                w14 = ReadHeader8_avx2(&in[56]),
+                w15 = ReadHeader8_avx2(&in[60]);
+
+        __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(961987163), w4));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1508970993), w5));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1841331548), w6));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1424204075), w7));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-670586216), w8));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(310598401), w9));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(607225278), w10));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1426881987), w11));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1925078388), w12));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-2132889090), w13));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1680079193), w14));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1046744716), w15));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-1538233109), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1090935817), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-965641998), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+
+        t0 = a = Add_avx2(a, K_avx2(1779033703));
+        t1 = b = Add_avx2(b, K_avx2(-1150833019));
+        t2 = c = Add_avx2(c, K_avx2(1013904242));
+        t3 = d = Add_avx2(d, K_avx2(-1521486534));
+        t4 = e = Add_avx2(e, K_avx2(1359893119));
+        t5 = f = Add_avx2(f, K_avx2(-1694144372));
+        t6 = g = Add_avx2(g, K_avx2(528734635));
+        t7 = h = Add_avx2(h, K_avx2(1541459225));
+
+        /* Transform 2 */
+        w0 = ReadHeader8_avx2(&in[64]);
+        w1 = ReadHeader8_avx2(&in[68]);
+        w2 = ReadHeader8_avx2(&in[72]);
+        w3 = ReadHeader8_avx2(&in[76]);
+
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+        Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(-1185496485));
+        Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(1508970993));
+        Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(-1841331548));
+        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1424204075));
+        Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(-670586216));
+        Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(310598401));
+        Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(607225278));
+        Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(1426881987));
+        Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(1925078388));
+        Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(-2132889090));
+        Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(-1680079193));
+        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1046744076));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc_avx2(&w0, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc3_avx2(&w1, K_avx2(17825792), sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc3_avx2(&w2, sigma1_avx2(w0), sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc3_avx2(&w3, sigma1_avx2(w1), K_avx2(285220864))));
+        w4 = Add_avx2(K_avx2(-2147483648), sigma1_avx2(w2));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), w4));
+        w5 = sigma1_avx2(w3);
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), w5));
+        w6 = Add_avx2(sigma1_avx2(w4), K_avx2(640));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), w6));
+        w7 = Add_avx2(sigma1_avx2(w5), w0);
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), w7));
+        w8 = Add_avx2(sigma1_avx2(w6), w1);
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), w8));
+        w9 = Add_avx2(sigma1_avx2(w7), w2);
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), w9));
+        w10 = Add_avx2(sigma1_avx2(w8), w3);
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), w10));
+        w11 = Add_avx2(sigma1_avx2(w9), w4);
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), w11));
+        w12 = Add_avx2(sigma1_avx2(w10), w5);
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), w12));
+        w13 = Add_avx2(sigma1_avx2(w11), w6);
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), w13));
+        w14 = Add3_avx2(sigma1_avx2(w12), w7, K_avx2(10485845));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), w14));
+        w15 = Add4_avx2(K_avx2(640), sigma1_avx2(w13), w8, sigma0_avx2(w0));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), w15));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-1538233109), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1090935817), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-965641998), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+
+        w0 = Add_avx2(t0, a);
+        w1 = Add_avx2(t1, b);
+        w2 = Add_avx2(t2, c);
+        w3 = Add_avx2(t3, d);
+        w4 = Add_avx2(t4, e);
+        w5 = Add_avx2(t5, f);
+        w6 = Add_avx2(t6, g);
+        w7 = Add_avx2(t7, h);
+
+        return sha256d32_avx2_8way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d80_avx2_8way(struct sha256 out[8], const unsigned char in[640])
+{
+        sha256d80_avx2_8way(out, in, 0);
+}
+
+/* Read8_avx2(), for messages at the 32-byte stride of hashes. */
+static inline __attribute__((always_inline)) __m256i ReadHash8_avx2(const unsigned char* chunk)
+{
+        return _mm256_shuffle_epi8(
+                _mm256_set_epi32(
+                        ReadLE32(chunk + 0),
+                        ReadLE32(chunk + 32),
+                        ReadLE32(chunk + 64),
+                        ReadLE32(chunk + 96),
+                        ReadLE32(chunk + 128),
+                        ReadLE32(chunk + 160),
+                        ReadLE32(chunk + 192),
+                        ReadLE32(chunk + 224)),
+                _mm256_set_epi32(
+                        202182159, 134810123, 67438087, 66051,
+                        202182159, 134810123, 67438087, 66051));
+}
+
+void transform_sha256d32_avx2_8way(struct sha256 out[8], const struct sha256 in[8])
+{
+        sha256d32_avx2_8way(out,
+                ReadHash8_avx2(&in->u8[0]),
+                ReadHash8_avx2(&in->u8[4]),
+                ReadHash8_avx2(&in->u8[8]),
+                ReadHash8_avx2(&in->u8[12]),
+                ReadHash8_avx2(&in->u8[16]),
+                ReadHash8_avx2(&in->u8[20]),
+                ReadHash8_avx2(&in->u8[24]),
+                ReadHash8_avx2(&in->u8[28]),
+                0);
+}
+
+static inline __attribute__((always_inline)) __m256i ReadLanes8_avx2(const unsigned char* const in[8], size_t offset)
+{
+        return _mm256_shuffle_epi8(
+                _mm256_setr_epi32(
+                        ReadLE32(in[0] + offset),
+                        ReadLE32(in[1] + offset),
+                        ReadLE32(in[2] + offset),
+                        ReadLE32(in[3] + offset),
+                        ReadLE32(in[4] + offset),
+                        ReadLE32(in[5] + offset),
+                        ReadLE32(in[6] + offset),
+                        ReadLE32(in[7] + offset)),
+                _mm256_set_epi32(
+                        202182159, 134810123, 67438087, 66051,
+                        202182159, 134810123, 67438087, 66051));
+}
+
+void transform_sha256mb_avx2_8way(uint32_t* s, const unsigned char* const in[8], size_t blocks)
+{
+        __m256i a, b, c, d, e, f, g, h;
+        __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+        __m256i w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
+        size_t offset = 0;
+
+        /* Load the transposed state.  See the comment in sha256_shani.c about
+         * the use of memcpy for unaligned vector access. */
+        memcpy(&a, s + 0, sizeof(a));
+        memcpy(&b, s + 8, sizeof(b));
+        memcpy(&c, s + 16, sizeof(c));
+        memcpy(&d, s + 24, sizeof(d));
+        memcpy(&e, s + 32, sizeof(e));
+        memcpy(&f, s + 40, sizeof(f));
+        memcpy(&g, s + 48, sizeof(g));
+        memcpy(&h, s + 56, sizeof(h));
+
+        for (; blocks; --blocks, offset += 64) {
+                t0 = a;
+                t1 = b;
+                t2 = c;
+                t3 = d;
+                t4 = e;
+                t5 = f;
+                t6 = g;
+                t7 = h;
+
+                w0 = ReadLanes8_avx2(in, offset + 0);
+                w1 = ReadLanes8_avx2(in, offset + 4);
+                w2 = ReadLanes8_avx2(in, offset + 8);
+                w3 = ReadLanes8_avx2(in, offset + 12);
+                w4 = ReadLanes8_avx2(in, offset + 16);
+                w5 = ReadLanes8_avx2(in, offset + 20);
+                w6 = ReadLanes8_avx2(in, offset + 24);
+                w7 = ReadLanes8_avx2(in, offset + 28);
+                w8 = ReadLanes8_avx2(in, offset + 32);
+                w9 = ReadLanes8_avx2(in, offset + 36);
+                w10 = ReadLanes8_avx2(in, offset + 40);
+                w11 = ReadLanes8_avx2(in, offset + 44);
+                w12 = ReadLanes8_avx2(in, offset + 48);
+                w13 = ReadLanes8_avx2(in, offset + 52);
+                w14 = ReadLanes8_avx2(in, offset + 56);
+                w15 = ReadLanes8_avx2(in, offset + 60);
+
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(961987163), w4));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1508970993), w5));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1841331548), w6));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1424204075), w7));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-670586216), w8));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(310598401), w9));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(607225278), w10));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1426881987), w11));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1925078388), w12));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-2132889090), w13));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1680079193), w14));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1046744716), w15));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-1538233109), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1090935817), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-965641998), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+
+                a = Add_avx2(a, t0);
+                b = Add_avx2(b, t1);
+                c = Add_avx2(c, t2);
+                d = Add_avx2(d, t3);
+                e = Add_avx2(e, t4);
+                f = Add_avx2(f, t5);
+                g = Add_avx2(g, t6);
+                h = Add_avx2(h, t7);
+        }
+
+        /* Store the transposed state. */
+        memcpy(s + 0, &a, sizeof(a));
+        memcpy(s + 8, &b, sizeof(b));
+        memcpy(s + 16, &c, sizeof(c));
+        memcpy(s + 24, &d, sizeof(d));
+        memcpy(s + 32, &e, sizeof(e));
+        memcpy(s + 40, &f, sizeof(f));
+        memcpy(s + 48, &g, sizeof(g));
+        memcpy(s + 56, &h, sizeof(h));
+}
+
+/** Load word i of each lane of a lane-major state. */
+static inline __attribute__((always_inline)) __m256i Gather8_avx2(const uint32_t* s, int i)
+{
+        return _mm256_setr_epi32(s[i], s[8 + i], s[16 + i], s[24 + i], s[32 + i], s[40 + i], s[48 + i], s[56 + i]);
+}
+
+/** Store word i of each lane into a lane-major state. */
+static inline __attribute__((always_inline)) void Scatter8_avx2(uint32_t* s, int i, __m256i v)
+{
+        uint32_t t[8];
+        int j;
+        memcpy(t, &v, sizeof(t));
+        for (j = 0; j < 8; ++j) {
+                s[8 * j + i] = t[j];
+        }
+}
+
+/** Compress the 32-byte message in[] from the state s[] into out[], which may
+ * alias in[].  The block has the fixed format of both hashes of an HMAC of a
+ * 32-byte message: the message follows the 64-byte key block, so the padding
+ * and the length of 96 bytes are folded into the schedule and the round
+ * constants, as in transform 3 of the double-SHA256 kernel above. */
+static inline __attribute__((always_inline)) void Hmac32_avx2(__m256i* out, const __m256i* s, const __m256i* in)
+{
+        __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        __m256i w0 = in[0], w1 = in[1], w2 = in[2], w3 = in[3], w4 = in[4], w5 = in[5], w6 = in[6], w7 = in[7];
+        __m256i w8, w9, w10, w11, w12, w13, w14, w15;
 
         Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
         Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
@@ -404,14 +941,14 @@ void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[
         Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(1925078388));
         Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(-2132889090));
         Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(-1680079193));
-        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1046744460));
+        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1046743948));
         Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc_avx2(&w0, sigma0_avx2(w1))));
-        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc3_avx2(&w1, K_avx2(10485760), sigma0_avx2(w2))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc3_avx2(&w1, K_avx2(31457280), sigma0_avx2(w2))));
         Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc3_avx2(&w2, sigma1_avx2(w0), sigma0_avx2(w3))));
         Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc3_avx2(&w3, sigma1_avx2(w1), sigma0_avx2(w4))));
         Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc3_avx2(&w4, sigma1_avx2(w2), sigma0_avx2(w5))));
         Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc3_avx2(&w5, sigma1_avx2(w3), sigma0_avx2(w6))));
-        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), K_avx2(256), sigma0_avx2(w7))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), K_avx2(768), sigma0_avx2(w7))));
         Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, K_avx2(285220864))));
         w8 = Add3_avx2(K_avx2(-2147483648), sigma1_avx2(w6), w1);
         Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), w8));
@@ -425,9 +962,9 @@ void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[
         Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), w12));
         w13 = Add_avx2(sigma1_avx2(w11), w6);
         Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), w13));
-        w14 = Add3_avx2(sigma1_avx2(w12), w7, K_avx2(4194338));
+        w14 = Add3_avx2(sigma1_avx2(w12), w7, K_avx2(12583014));
         Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), w14));
-        w15 = Add4_avx2(K_avx2(256), sigma1_avx2(w13), w8, sigma0_avx2(w0));
+        w15 = Add4_avx2(K_avx2(768), sigma1_avx2(w13), w8, sigma0_avx2(w0));
         Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), w15));
         Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
         Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
@@ -462,15 +999,451 @@ void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[
         Round_avx2(c, d, e, &f, g, h, a, &b, Add5_avx2(K_avx2(-1090935817), w14, sigma1_avx2(w12), w7, sigma0_avx2(w15)));
         Round_avx2(b, c, d, &e, f, g, h, &a, Add5_avx2(K_avx2(-965641998), w15, sigma1_avx2(w13), w8, sigma0_avx2(w0)));
 
-        /* Output */
-        Write8_avx2(&out->u8[0], Add_avx2(a, K_avx2(1779033703)));
-        Write8_avx2(&out->u8[4], Add_avx2(b, K_avx2(-1150833019)));
-        Write8_avx2(&out->u8[8], Add_avx2(c, K_avx2(1013904242)));
-        Write8_avx2(&out->u8[12], Add_avx2(d, K_avx2(-1521486534)));
-        Write8_avx2(&out->u8[16], Add_avx2(e, K_avx2(1359893119)));
-        Write8_avx2(&out->u8[20], Add_avx2(f, K_avx2(-1694144372)));
-        Write8_avx2(&out->u8[24], Add_avx2(g, K_avx2(528734635)));
-        Write8_avx2(&out->u8[28], Add_avx2(h, K_avx2(1541459225)));
+        out[0] = Add_avx2(s[0], a);
+        out[1] = Add_avx2(s[1], b);
+        out[2] = Add_avx2(s[2], c);
+        out[3] = Add_avx2(s[3], d);
+        out[4] = Add_avx2(s[4], e);
+        out[5] = Add_avx2(s[5], f);
+        out[6] = Add_avx2(s[6], g);
+        out[7] = Add_avx2(s[7], h);
+}
+
+void transform_sha256pbkdf2_avx2_8way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        __m256i si[8], so[8], w[8], x[8];
+        int i;
+
+        for (i = 0; i < 8; ++i) {
+                si[i] = Gather8_avx2(inner, i);
+                so[i] = Gather8_avx2(outer, i);
+                w[i] = Gather8_avx2(u, i);
+                x[i] = Gather8_avx2(f, i);
+        }
+        for (; iterations; --iterations) {
+                Hmac32_avx2(w, si, w);
+                Hmac32_avx2(w, so, w);
+                for (i = 0; i < 8; ++i) {
+                        x[i] = _mm256_xor_si256(x[i], w[i]);
+                }
+        }
+        for (i = 0; i < 8; ++i) {
+                Scatter8_avx2(u, i, w[i]);
+                Scatter8_avx2(f, i, x[i]);
+        }
+}
+
+/** The lanes of v which are no greater than t, as unsigned numbers. */
+static inline __attribute__((always_inline)) uint32_t LessEqual8_avx2(__m256i v, __m256i t)
+{
+        return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_max_epu32(v, t), t)));
+}
+
+/** The last words of the hashes in h, byte-swapped to be read as little-endian
+ * numbers, and with message i moved from lane 7 - i to lane i. */
+static inline __attribute__((always_inline)) __m256i Top8_avx2(__m256i h)
+{
+        return _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(h, _mm256_set_epi32(
+                202182159, 134810123, 67438087, 66051,
+                202182159, 134810123, 67438087, 66051)), _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+uint32_t transform_sha256d64below_avx2_8way(const struct sha256 in[16], const uint32_t target[8])
+{
+        return LessEqual8_avx2(Top8_avx2(sha256d64_avx2_8way(NULL, in, !0)), _mm256_loadu_si256((const __m256i*)target));
+}
+
+uint32_t transform_sha256d80below_avx2_8way(const unsigned char in[640], const uint32_t target[8])
+{
+        return LessEqual8_avx2(Top8_avx2(sha256d80_avx2_8way(NULL, in, !0)), _mm256_loadu_si256((const __m256i*)target));
+}
+
+uint32_t transform_sha256grind_avx2_8way(const struct sha256_grind* ctx, uint32_t nonce)
+{
+        const uint64_t dep = ctx->dep;
+        __m256i n = _mm256_shuffle_epi8(Add_avx2(K_avx2(nonce), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)), _mm256_set_epi32(
+                202182159, 134810123, 67438087, 66051,
+                202182159, 134810123, 67438087, 66051));
+        __m256i a = K_avx2(ctx->state[0]);
+        __m256i b = K_avx2(ctx->state[1]);
+        __m256i c = K_avx2(ctx->state[2]);
+        __m256i d = K_avx2(ctx->state[3]);
+        __m256i e = K_avx2(ctx->state[4]);
+        __m256i f = K_avx2(ctx->state[5]);
+        __m256i g = K_avx2(ctx->state[6]);
+        __m256i h = K_avx2(ctx->state[7]);
+
+        __m256i w0 = K_avx2(ctx->w[0]),
+                w1 = K_avx2(ctx->w[1]),
+                w2 = K_avx2(ctx->w[2]),
+                w3 = K_avx2(ctx->w[3]),
+                w4 = K_avx2(ctx->w[4]),
+                w5 = K_avx2(ctx->w[5]),
+                w6 = K_avx2(ctx->w[6]),
+                w7 = K_avx2(ctx->w[7]),
+                w8 = K_avx2(ctx->w[8]),
+                w9 = K_avx2(ctx->w[9]),
+                w10 = K_avx2(ctx->w[10]),
+                w11 = K_avx2(ctx->w[11]),
+                w12 = K_avx2(ctx->w[12]),
+                w13 = K_avx2(ctx->w[13]),
+                w14 = K_avx2(ctx->w[14]),
+                w15 = K_avx2(ctx->w[15]);
+
+        /* Enter at the round which first reads the nonce, with the
+         * state rotated to match. */
+        switch (ctx->word) {
+        case 0:
+                if ((dep >> 0) & 1) {
+                        w0 = n;
+                        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+                } else {
+                        Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(ctx->kw[0]));
+                }
+                /* FALLTHROUGH */
+        case 1:
+                if ((dep >> 1) & 1) {
+                        w1 = n;
+                        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+                } else {
+                        Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(ctx->kw[1]));
+                }
+                /* FALLTHROUGH */
+        case 2:
+                if ((dep >> 2) & 1) {
+                        w2 = n;
+                        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+                } else {
+                        Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(ctx->kw[2]));
+                }
+                /* FALLTHROUGH */
+        case 3:
+                if ((dep >> 3) & 1) {
+                        w3 = n;
+                        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+                } else {
+                        Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(ctx->kw[3]));
+                }
+                /* FALLTHROUGH */
+        case 4:
+                if ((dep >> 4) & 1) {
+                        w4 = n;
+                        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(961987163), w4));
+                } else {
+                        Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(ctx->kw[4]));
+                }
+                /* FALLTHROUGH */
+        case 5:
+                if ((dep >> 5) & 1) {
+                        w5 = n;
+                        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1508970993), w5));
+                } else {
+                        Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(ctx->kw[5]));
+                }
+                /* FALLTHROUGH */
+        case 6:
+                if ((dep >> 6) & 1) {
+                        w6 = n;
+                        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1841331548), w6));
+                } else {
+                        Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(ctx->kw[6]));
+                }
+                /* FALLTHROUGH */
+        case 7:
+                if ((dep >> 7) & 1) {
+                        w7 = n;
+                        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1424204075), w7));
+                } else {
+                        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(ctx->kw[7]));
+                }
+                /* FALLTHROUGH */
+        case 8:
+                if ((dep >> 8) & 1) {
+                        w8 = n;
+                        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-670586216), w8));
+                } else {
+                        Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(ctx->kw[8]));
+                }
+                /* FALLTHROUGH */
+        case 9:
+                if ((dep >> 9) & 1) {
+                        w9 = n;
+                        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(310598401), w9));
+                } else {
+                        Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(ctx->kw[9]));
+                }
+                /* FALLTHROUGH */
+        case 10:
+                if ((dep >> 10) & 1) {
+                        w10 = n;
+                        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(607225278), w10));
+                } else {
+                        Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(ctx->kw[10]));
+                }
+                /* FALLTHROUGH */
+        case 11:
+                if ((dep >> 11) & 1) {
+                        w11 = n;
+                        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1426881987), w11));
+                } else {
+                        Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(ctx->kw[11]));
+                }
+                /* FALLTHROUGH */
+        case 12:
+                if ((dep >> 12) & 1) {
+                        w12 = n;
+                        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1925078388), w12));
+                } else {
+                        Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(ctx->kw[12]));
+                }
+                /* FALLTHROUGH */
+        case 13:
+                if ((dep >> 13) & 1) {
+                        w13 = n;
+                        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-2132889090), w13));
+                } else {
+                        Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(ctx->kw[13]));
+                }
+                /* FALLTHROUGH */
+        case 14:
+                if ((dep >> 14) & 1) {
+                        w14 = n;
+                        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1680079193), w14));
+                } else {
+                        Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(ctx->kw[14]));
+                }
+                /* FALLTHROUGH */
+        case 15:
+                if ((dep >> 15) & 1) {
+                        w15 = n;
+                        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1046744716), w15));
+                } else {
+                        Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(ctx->kw[15]));
+                }
+        }
+        if ((dep >> 16) & 1) {
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        } else {
+                w0 = K_avx2(ctx->w[16]);
+                Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(ctx->kw[16]));
+        }
+        if ((dep >> 17) & 1) {
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        } else {
+                w1 = K_avx2(ctx->w[17]);
+                Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(ctx->kw[17]));
+        }
+        if ((dep >> 18) & 1) {
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        } else {
+                w2 = K_avx2(ctx->w[18]);
+                Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(ctx->kw[18]));
+        }
+        if ((dep >> 19) & 1) {
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        } else {
+                w3 = K_avx2(ctx->w[19]);
+                Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(ctx->kw[19]));
+        }
+        if ((dep >> 20) & 1) {
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        } else {
+                w4 = K_avx2(ctx->w[20]);
+                Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(ctx->kw[20]));
+        }
+        if ((dep >> 21) & 1) {
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        } else {
+                w5 = K_avx2(ctx->w[21]);
+                Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(ctx->kw[21]));
+        }
+        if ((dep >> 22) & 1) {
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        } else {
+                w6 = K_avx2(ctx->w[22]);
+                Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(ctx->kw[22]));
+        }
+        if ((dep >> 23) & 1) {
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        } else {
+                w7 = K_avx2(ctx->w[23]);
+                Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(ctx->kw[23]));
+        }
+        if ((dep >> 24) & 1) {
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        } else {
+                w8 = K_avx2(ctx->w[24]);
+                Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(ctx->kw[24]));
+        }
+        if ((dep >> 25) & 1) {
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        } else {
+                w9 = K_avx2(ctx->w[25]);
+                Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(ctx->kw[25]));
+        }
+        if ((dep >> 26) & 1) {
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        } else {
+                w10 = K_avx2(ctx->w[26]);
+                Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(ctx->kw[26]));
+        }
+        if ((dep >> 27) & 1) {
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        } else {
+                w11 = K_avx2(ctx->w[27]);
+                Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(ctx->kw[27]));
+        }
+        if ((dep >> 28) & 1) {
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        } else {
+                w12 = K_avx2(ctx->w[28]);
+                Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(ctx->kw[28]));
+        }
+        if ((dep >> 29) & 1) {
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        } else {
+                w13 = K_avx2(ctx->w[29]);
+                Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(ctx->kw[29]));
+        }
+        if ((dep >> 30) & 1) {
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        } else {
+                w14 = K_avx2(ctx->w[30]);
+                Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(ctx->kw[30]));
+        }
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+        Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+        Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+        Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+        Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+        Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+        Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+        Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+        Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+
+        if (ctx->twice) {
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-1538233109), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add5_avx2(K_avx2(-1090935817), w14, sigma1_avx2(w12), w7, sigma0_avx2(w15)));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add5_avx2(K_avx2(-965641998), w15, sigma1_avx2(w13), w8, sigma0_avx2(w0)));
+
+                w0 = Add_avx2(a, K_avx2(ctx->midstate[0]));
+                w1 = Add_avx2(b, K_avx2(ctx->midstate[1]));
+                w2 = Add_avx2(c, K_avx2(ctx->midstate[2]));
+                w3 = Add_avx2(d, K_avx2(ctx->midstate[3]));
+                w4 = Add_avx2(e, K_avx2(ctx->midstate[4]));
+                w5 = Add_avx2(f, K_avx2(ctx->midstate[5]));
+                w6 = Add_avx2(g, K_avx2(ctx->midstate[6]));
+                w7 = Add_avx2(h, K_avx2(ctx->midstate[7]));
+
+                a = K_avx2(1779033703);
+                b = K_avx2(-1150833019);
+                c = K_avx2(1013904242);
+                d = K_avx2(-1521486534);
+                e = K_avx2(1359893119);
+                f = K_avx2(-1694144372);
+                g = K_avx2(528734635);
+                h = K_avx2(1541459225);
+
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1116352408), w0));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(1899447441), w1));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1245643825), w2));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-373957723), w3));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(961987163), w4));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1508970993), w5));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-1841331548), w6));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1424204075), w7));
+                Round_avx2(a, b, c, &d, e, f, g, &h, K_avx2(1476897432));
+                Round_avx2(h, a, b, &c, d, e, f, &g, K_avx2(310598401));
+                Round_avx2(g, h, a, &b, c, d, e, &f, K_avx2(607225278));
+                Round_avx2(f, g, h, &a, b, c, d, &e, K_avx2(1426881987));
+                Round_avx2(e, f, g, &h, a, b, c, &d, K_avx2(1925078388));
+                Round_avx2(d, e, f, &g, h, a, b, &c, K_avx2(-2132889090));
+                Round_avx2(c, d, e, &f, g, h, a, &b, K_avx2(-1680079193));
+                Round_avx2(b, c, d, &e, f, g, h, &a, K_avx2(-1046744460));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-459576895), Inc_avx2(&w0, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-272742522), Inc3_avx2(&w1, K_avx2(10485760), sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(264347078), Inc3_avx2(&w2, sigma1_avx2(w0), sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(604807628), Inc3_avx2(&w3, sigma1_avx2(w1), sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(770255983), Inc3_avx2(&w4, sigma1_avx2(w2), sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1249150122), Inc3_avx2(&w5, sigma1_avx2(w3), sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1555081692), Inc4_avx2(&w6, sigma1_avx2(w4), K_avx2(256), sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1996064986), Inc4_avx2(&w7, sigma1_avx2(w5), w0, K_avx2(285220864))));
+                w8 = Add3_avx2(K_avx2(-2147483648), sigma1_avx2(w6), w1);
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1740746414), w8));
+                w9 = Add_avx2(sigma1_avx2(w7), w2);
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1473132947), w9));
+                w10 = Add_avx2(sigma1_avx2(w8), w3);
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1341970488), w10));
+                w11 = Add_avx2(sigma1_avx2(w9), w4);
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1084653625), w11));
+                w12 = Add_avx2(sigma1_avx2(w10), w5);
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-958395405), w12));
+                w13 = Add_avx2(sigma1_avx2(w11), w6);
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-710438585), w13));
+                w14 = Add3_avx2(sigma1_avx2(w12), w7, K_avx2(4194338));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(113926993), w14));
+                w15 = Add4_avx2(K_avx2(256), sigma1_avx2(w13), w8, sigma0_avx2(w0));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(338241895), w15));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(666307205), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(773529912), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(1294757372), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(1396182291), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(1695183700), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1986661051), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-2117940946), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(-1838011259), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(-1564481375), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(-1474664885), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-1035236496), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-949202525), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-778901479), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(-694614492), Inc4_avx2(&w13, sigma1_avx2(w11), w6, sigma0_avx2(w14))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(-200395387), Inc4_avx2(&w14, sigma1_avx2(w12), w7, sigma0_avx2(w15))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(275423344), Inc4_avx2(&w15, sigma1_avx2(w13), w8, sigma0_avx2(w0))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(430227734), Inc4_avx2(&w0, sigma1_avx2(w14), w9, sigma0_avx2(w1))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(506948616), Inc4_avx2(&w1, sigma1_avx2(w15), w10, sigma0_avx2(w2))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(659060556), Inc4_avx2(&w2, sigma1_avx2(w0), w11, sigma0_avx2(w3))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(883997877), Inc4_avx2(&w3, sigma1_avx2(w1), w12, sigma0_avx2(w4))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(958139571), Inc4_avx2(&w4, sigma1_avx2(w2), w13, sigma0_avx2(w5))));
+                Round_avx2(d, e, f, &g, h, a, b, &c, Add_avx2(K_avx2(1322822218), Inc4_avx2(&w5, sigma1_avx2(w3), w14, sigma0_avx2(w6))));
+                Round_avx2(c, d, e, &f, g, h, a, &b, Add_avx2(K_avx2(1537002063), Inc4_avx2(&w6, sigma1_avx2(w4), w15, sigma0_avx2(w7))));
+                Round_avx2(b, c, d, &e, f, g, h, &a, Add_avx2(K_avx2(1747873779), Inc4_avx2(&w7, sigma1_avx2(w5), w0, sigma0_avx2(w8))));
+                Round_avx2(a, b, c, &d, e, f, g, &h, Add_avx2(K_avx2(1955562222), Inc4_avx2(&w8, sigma1_avx2(w6), w1, sigma0_avx2(w9))));
+                Round_avx2(h, a, b, &c, d, e, f, &g, Add_avx2(K_avx2(2024104815), Inc4_avx2(&w9, sigma1_avx2(w7), w2, sigma0_avx2(w10))));
+                Round_avx2(g, h, a, &b, c, d, e, &f, Add_avx2(K_avx2(-2067236844), Inc4_avx2(&w10, sigma1_avx2(w8), w3, sigma0_avx2(w11))));
+                Round_avx2(f, g, h, &a, b, c, d, &e, Add_avx2(K_avx2(-1933114872), Inc4_avx2(&w11, sigma1_avx2(w9), w4, sigma0_avx2(w12))));
+                Round_avx2(e, f, g, &h, a, b, c, &d, Add_avx2(K_avx2(-1866530822), Inc4_avx2(&w12, sigma1_avx2(w10), w5, sigma0_avx2(w13))));
+                h = Add_avx2(h, K_avx2(1541459225));
+        } else {
+                h = Add_avx2(h, K_avx2(ctx->midstate[7]));
+        }
+
+        /* h is now the last word of the hash, whose bytes are the most
+         * significant when the hash is read as a little-endian number. */
+        return LessEqual8_avx2(_mm256_shuffle_epi8(h, _mm256_set_epi32(
+                202182159, 134810123, 67438087, 66051,
+                202182159, 134810123, 67438087, 66051)), K_avx2(ctx->target));
 }
 
 #else
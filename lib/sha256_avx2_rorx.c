@@ -0,0 +1,187 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#if defined(HAVE_CONFIG_H)
+#include <libsha2-config.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__amd64__)) && defined(ENABLE_AVX2_BMI2)
+
+#include <sha2/sha256.h>
+#include "sha256_internal.h"
+
+#include <stdint.h> /* for uint32_t */
+#include <immintrin.h> /* for assembly intrinsics */
+
+/* A single-stream transform after the design of Intel's sha256_rorx code.
+ * The message schedules of two consecutive blocks are computed together, one
+ * block in each 128-bit half of a 256-bit register, while the scalar rounds of
+ * the first block are run, and the words plus round constants of both are
+ * kept on the stack.  The rounds of the second block then only read their
+ * words back.  This file is built with BMI2 enabled, so that the compiler
+ * uses the flag-free, three-operand rorx for the scalar rotates, and andn for
+ * Ch, which leaves it free to interleave the rounds with the schedule. */
+
+static const __attribute__((aligned (32))) uint32_t K256[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define Ror_rorx(x, n) ((x) >> (n) | (x) << (32 - (n)))
+
+static inline __attribute__((always_inline)) uint32_t Ch_rorx(uint32_t x, uint32_t y, uint32_t z) { return (x & y) ^ (~x & z); }
+static inline __attribute__((always_inline)) uint32_t Maj_rorx(uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); }
+static inline __attribute__((always_inline)) uint32_t Sigma0_rorx(uint32_t x) { return Ror_rorx(x, 2) ^ Ror_rorx(x, 13) ^ Ror_rorx(x, 22); }
+static inline __attribute__((always_inline)) uint32_t Sigma1_rorx(uint32_t x) { return Ror_rorx(x, 6) ^ Ror_rorx(x, 11) ^ Ror_rorx(x, 25); }
+
+/** One round of SHA-256, with the round constant already added to w. */
+static inline __attribute__((always_inline)) void Round_rorx(uint32_t a, uint32_t b, uint32_t c, uint32_t* d, uint32_t e, uint32_t f, uint32_t g, uint32_t* h, uint32_t kw)
+{
+        uint32_t t1 = *h + Sigma1_rorx(e) + Ch_rorx(e, f, g) + kw;
+        uint32_t t2 = Sigma0_rorx(a) + Maj_rorx(a, b, c);
+        *d += t1;
+        *h = t1 + t2;
+}
+
+/** Eight rounds, from the words at kw and kw + step. */
+static inline __attribute__((always_inline)) void Round8_rorx(uint32_t* s, const uint32_t* kw, int step)
+{
+        Round_rorx(s[0], s[1], s[2], &s[3], s[4], s[5], s[6], &s[7], kw[0]);
+        Round_rorx(s[7], s[0], s[1], &s[2], s[3], s[4], s[5], &s[6], kw[1]);
+        Round_rorx(s[6], s[7], s[0], &s[1], s[2], s[3], s[4], &s[5], kw[2]);
+        Round_rorx(s[5], s[6], s[7], &s[0], s[1], s[2], s[3], &s[4], kw[3]);
+        Round_rorx(s[4], s[5], s[6], &s[7], s[0], s[1], s[2], &s[3], kw[step + 0]);
+        Round_rorx(s[3], s[4], s[5], &s[6], s[7], s[0], s[1], &s[2], kw[step + 1]);
+        Round_rorx(s[2], s[3], s[4], &s[5], s[6], s[7], s[0], &s[1], kw[step + 2]);
+        Round_rorx(s[1], s[2], s[3], &s[4], s[5], s[6], s[7], &s[0], kw[step + 3]);
+}
+
+#define Add_rorx(x, y) _mm256_add_epi32((x), (y))
+#define Xor_rorx(x, y) _mm256_xor_si256((x), (y))
+#define Or_rorx(x, y) _mm256_or_si256((x), (y))
+#define ShR_rorx(x, n) _mm256_srli_epi32((x), (n))
+#define ShL_rorx(x, n) _mm256_slli_epi32((x), (n))
+
+static inline __attribute__((always_inline)) __m256i sigma0_rorx(__m256i x) { return Xor_rorx(Xor_rorx(Or_rorx(ShR_rorx(x, 7), ShL_rorx(x, 25)), Or_rorx(ShR_rorx(x, 18), ShL_rorx(x, 14))), ShR_rorx(x, 3)); }
+static inline __attribute__((always_inline)) __m256i sigma1_rorx(__m256i x) { return Xor_rorx(Xor_rorx(Or_rorx(ShR_rorx(x, 17), ShL_rorx(x, 15)), Or_rorx(ShR_rorx(x, 19), ShL_rorx(x, 13))), ShR_rorx(x, 10)); }
+
+/** The next four words of the message schedule of each half, from the
+ * sixteen before them in x0 to x3.  The words which depend on the first two
+ * of the new ones are completed in a second step, in which the lanes whose
+ * sigma1 input is shifted in as zero are unchanged, as sigma1(0) is 0. */
+static inline __attribute__((always_inline)) __m256i Schedule_rorx(__m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+        __m256i w = Add_rorx(Add_rorx(x0, _mm256_alignr_epi8(x3, x2, 4)), sigma0_rorx(_mm256_alignr_epi8(x1, x0, 4)));
+        w = Add_rorx(w, sigma1_rorx(_mm256_srli_si256(x3, 8)));
+        return Add_rorx(w, sigma1_rorx(_mm256_slli_si256(w, 8)));
+}
+
+/** Compress the blocks at chunk and chunk + 64, or only the first if second is
+ * zero, in which case the upper half repeats it. */
+static inline __attribute__((always_inline)) void Transform2_rorx(uint32_t* s, const unsigned char* chunk, int second)
+{
+        const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull, 0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+        __attribute__((aligned (32))) uint32_t kw[128];
+        __m256i x0, x1, x2, x3;
+        uint32_t r[8];
+        int i, j;
+
+        if (second) {
+                x0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 0))), _mm_loadu_si128((const __m128i*)(chunk + 64)), 1);
+                x1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 16))), _mm_loadu_si128((const __m128i*)(chunk + 80)), 1);
+                x2 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 32))), _mm_loadu_si128((const __m128i*)(chunk + 96)), 1);
+                x3 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 48))), _mm_loadu_si128((const __m128i*)(chunk + 112)), 1);
+        } else {
+                x0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 0)));
+                x1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 16)));
+                x2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 32)));
+                x3 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(chunk + 48)));
+        }
+        x0 = _mm256_shuffle_epi8(x0, MASK);
+        x1 = _mm256_shuffle_epi8(x1, MASK);
+        x2 = _mm256_shuffle_epi8(x2, MASK);
+        x3 = _mm256_shuffle_epi8(x3, MASK);
+
+        for (i = 0; i < 8; ++i) {
+                r[i] = s[i];
+        }
+
+        /* Rounds 0-47 of the first block, while the schedule of both is
+         * computed.  The words of rounds 4i to 4i+3 are at kw + 8i for the
+         * first block and kw + 8i + 4 for the second. */
+        for (i = 0; i < 48; i += 16) {
+                _mm256_store_si256((__m256i*)(kw + 2 * i + 0), Add_rorx(x0, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + i + 0)))));
+                _mm256_store_si256((__m256i*)(kw + 2 * i + 8), Add_rorx(x1, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + i + 4)))));
+                x0 = Schedule_rorx(x0, x1, x2, x3);
+                x1 = Schedule_rorx(x1, x2, x3, x0);
+                Round8_rorx(r, kw + 2 * i + 0, 8);
+                _mm256_store_si256((__m256i*)(kw + 2 * i + 16), Add_rorx(x2, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + i + 8)))));
+                _mm256_store_si256((__m256i*)(kw + 2 * i + 24), Add_rorx(x3, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + i + 12)))));
+                x2 = Schedule_rorx(x2, x3, x0, x1);
+                x3 = Schedule_rorx(x3, x0, x1, x2);
+                Round8_rorx(r, kw + 2 * i + 16, 8);
+        }
+
+        /* Rounds 48-63 of the first block, whose words need no schedule. */
+        _mm256_store_si256((__m256i*)(kw + 96), Add_rorx(x0, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + 48)))));
+        _mm256_store_si256((__m256i*)(kw + 104), Add_rorx(x1, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + 52)))));
+        _mm256_store_si256((__m256i*)(kw + 112), Add_rorx(x2, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + 56)))));
+        _mm256_store_si256((__m256i*)(kw + 120), Add_rorx(x3, _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(K256 + 60)))));
+        Round8_rorx(r, kw + 96, 8);
+        Round8_rorx(r, kw + 112, 8);
+        for (i = 0; i < 8; ++i) {
+                s[i] += r[i];
+                r[i] = s[i];
+        }
+        if (!second) {
+                return;
+        }
+
+        /* The second block, from the words already on the stack. */
+        for (j = 4; j < 128; j += 16) {
+                Round8_rorx(r, kw + j, 8);
+        }
+        for (i = 0; i < 8; ++i) {
+                s[i] += r[i];
+        }
+}
+
+void transform_sha256_avx2_rorx(uint32_t* s, const unsigned char* chunk, size_t blocks)
+{
+        while (blocks >= 2) {
+                Transform2_rorx(s, chunk, !0);
+                chunk += 128;
+                blocks -= 2;
+        }
+        if (blocks) {
+                Transform2_rorx(s, chunk, 0);
+        }
+}
+
+#else
+/* -Wempty-translation-unit
+ * ISO C requires a translation unit to contain at least one declaration
+ */
+typedef int avx2_rorx_make_iso_compilers_happy;
+#endif
+
+/* End of File
+ */
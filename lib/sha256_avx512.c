@@ -0,0 +1,1424 @@
+/* Copyright (c) 2017-2019 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#if defined(HAVE_CONFIG_H)
+#include <libsha2-config.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__amd64__)) && defined(ENABLE_AVX512)
+
+#include <sha2/sha256.h>
+#include "sha256_internal.h"
+
+#include <stdint.h> /* for uint32_t */
+#include <string.h> /* for memcpy */
+#include <immintrin.h> /* for assembly intrinsics */
+
+#include "common.h"
+
+/* This is the 16-lane counterpart to the AVX2 code in sha256_avx2.c.  The
+ * round structure is identical, but AVX-512F provides a native rotate
+ * (vprord) and a three-input bitwise operation (vpternlogd) which replace the
+ * shift/shift/or sequences and the two-instruction Ch, Maj and Xor3 helpers.
+ *
+ * As with the other vector implementations, multiple-expansion hazards are
+ * avoided by keeping macros which reference a parameter more than once as
+ * inlines.
+ */
+
+#define K_avx512(x) _mm512_set1_epi32(x)
+
+#define Add_avx512(x, y) _mm512_add_epi32((x), (y))
+#define Add3_avx512(x, y, z) Add_avx512(Add_avx512((x), (y)), (z))
+#define Add4_avx512(x, y, z, w) Add_avx512(Add_avx512((x), (y)), Add_avx512((z), (w)))
+#define Add5_avx512(x, y, z, w, v) Add_avx512(Add3_avx512((x), (y), (z)), Add_avx512((w), (v)))
+static inline __attribute__((always_inline)) __m512i Inc_avx512(__m512i *x, __m512i y) { *x = Add_avx512(*x, y); return *x; }
+static inline __attribute__((always_inline)) __m512i Inc3_avx512(__m512i *x, __m512i y, __m512i z) { *x = Add3_avx512(*x, y, z); return *x; }
+static inline __attribute__((always_inline)) __m512i Inc4_avx512(__m512i *x, __m512i y, __m512i z, __m512i w) { *x = Add4_avx512(*x, y, z, w); return *x; }
+/* vpternlogd truth tables: 0x96 = x^y^z, 0xca = x?y:z, 0xe8 = majority */
+#define Xor3_avx512(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0x96)
+#define Ch_avx512(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0xca)
+#define Maj_avx512(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0xe8)
+#define ShR_avx512(x, n) _mm512_srli_epi32((x), (n))
+#define RoR_avx512(x, n) _mm512_ror_epi32((x), (n))
+#define RoL_avx512(x, n) _mm512_rol_epi32((x), (n))
+
+static inline __attribute__((always_inline)) __m512i Sigma0_avx512(__m512i x) { return Xor3_avx512(RoR_avx512(x, 2), RoR_avx512(x, 13), RoR_avx512(x, 22)); }
+static inline __attribute__((always_inline)) __m512i Sigma1_avx512(__m512i x) { return Xor3_avx512(RoR_avx512(x, 6), RoR_avx512(x, 11), RoR_avx512(x, 25)); }
+static inline __attribute__((always_inline)) __m512i sigma0_avx512(__m512i x) { return Xor3_avx512(RoR_avx512(x, 7), RoR_avx512(x, 18), ShR_avx512(x, 3)); }
+static inline __attribute__((always_inline)) __m512i sigma1_avx512(__m512i x) { return Xor3_avx512(RoR_avx512(x, 17), RoR_avx512(x, 19), ShR_avx512(x, 10)); }
+
+/** One round of SHA-256. */
+static inline __attribute__((always_inline)) void Round_avx512(__m512i a, __m512i b, __m512i c, __m512i *d, __m512i e, __m512i f, __m512i g, __m512i *h, __m512i k)
+{
+        __m512i t1 = Add4_avx512(*h, Sigma1_avx512(e), Ch_avx512(e, f, g), k);
+        __m512i t2 = Add_avx512(Sigma0_avx512(a), Maj_avx512(a, b, c));
+        *d = Add_avx512(*d, t1);
+        *h = Add_avx512(t1, t2);
+}
+
+/** Byte-swap each 32-bit lane.  vpshufb would require AVX512BW, so the swap
+ * is instead built out of two rotates and a bitwise select. */
+static inline __attribute__((always_inline)) __m512i Bswap_avx512(__m512i x)
+{
+        return Ch_avx512(K_avx512(0x00ff00ff), RoL_avx512(x, 8), RoR_avx512(x, 8));
+}
+
+static inline __attribute__((always_inline)) __m512i Read16_avx512(const unsigned char* chunk)
+{
+        return Bswap_avx512(_mm512_i32gather_epi32(
+                _mm512_set_epi32(
+                        0, 64, 128, 192, 256, 320, 384, 448,
+                        512, 576, 640, 704, 768, 832, 896, 960),
+                (const void*)chunk, 1));
+}
+
+static inline __attribute__((always_inline)) void Write16_avx512(unsigned char *out, __m512i v)
+{
+        _mm512_i32scatter_epi32((void*)out,
+                _mm512_set_epi32(
+                        0, 32, 64, 96, 128, 160, 192, 224,
+                        256, 288, 320, 352, 384, 416, 448, 480),
+                Bswap_avx512(v), 1);
+}
+
+void transform_sha256multi_avx512_16way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        /* Transform 1 */
+        __m512i a = K_avx512(s[0]);
+        __m512i b = K_avx512(s[1]);
+        __m512i c = K_avx512(s[2]);
+        __m512i d = K_avx512(s[3]);
+        __m512i e = K_avx512(s[4]);
+        __m512i f = K_avx512(s[5]);
+        __m512i g = K_avx512(s[6]);
+        __m512i h = K_avx512(s[7]);
+
+        __m512i w0 = Read16_avx512(&in[0]),
+                w1 = Read16_avx512(&in[4]),
+                w2 = Read16_avx512(&in[8]),
+                w3 = Read16_avx512(&in[12]),
+                w4 = Read16_avx512(&in[16]),
+                w5 = Read16_avx512(&in[20]),
+                w6 = Read16_avx512(&in[24]),
+                w7 = Read16_avx512(&in[28]),
+                w8 = Read16_avx512(&in[32]),
+                w9 = Read16_avx512(&in[36]),
+                w10 = Read16_avx512(&in[40]),
+                w11 = Read16_avx512(&in[44]),
+                w12 = Read16_avx512(&in[48]),
+                w13 = Read16_avx512(&in[52]),
+                w14 = Read16_avx512(&in[56]),
+                w15 = Read16_avx512(&in[60]);
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-670586216), w8));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(310598401), w9));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(607225278), w10));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1426881987), w11));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1925078388), w12));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-2132889090), w13));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1680079193), w14));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1046744716), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1090935817), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-965641998), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+
+        /* Output */
+        Write16_avx512(&out->u8[0], Add_avx512(a, K_avx512(s[0])));
+        Write16_avx512(&out->u8[4], Add_avx512(b, K_avx512(s[1])));
+        Write16_avx512(&out->u8[8], Add_avx512(c, K_avx512(s[2])));
+        Write16_avx512(&out->u8[12], Add_avx512(d, K_avx512(s[3])));
+        Write16_avx512(&out->u8[16], Add_avx512(e, K_avx512(s[4])));
+        Write16_avx512(&out->u8[20], Add_avx512(f, K_avx512(s[5])));
+        Write16_avx512(&out->u8[24], Add_avx512(g, K_avx512(s[6])));
+        Write16_avx512(&out->u8[28], Add_avx512(h, K_avx512(s[7])));
+}
+
+/** Hash sixteen 32-byte messages, whose words are w0 to w7, as the second
+ * hash of a double SHA256; with top set, return just the last word of each
+ * hash instead of writing the hashes out. */
+static inline __attribute__((always_inline)) __m512i sha256d32_avx512_16way(struct sha256 out[16], __m512i w0, __m512i w1, __m512i w2, __m512i w3, __m512i w4, __m512i w5, __m512i w6, __m512i w7, int top)
+{
+        __m512i a, b, c, d, e, f, g, h;
+        __m512i w8, w9, w10, w11, w12, w13, w14, w15;
+
+        a = K_avx512(1779033703);
+        b = K_avx512(-1150833019);
+        c = K_avx512(1013904242);
+        d = K_avx512(-1521486534);
+        e = K_avx512(1359893119);
+        f = K_avx512(-1694144372);
+        g = K_avx512(528734635);
+        h = K_avx512(1541459225);
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(1476897432));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(310598401));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(607225278));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1426881987));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1925078388));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-2132889090));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1680079193));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1046744460));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc_avx512(&w0, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc3_avx512(&w1, K_avx512(10485760), sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc3_avx512(&w2, sigma1_avx512(w0), sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc3_avx512(&w3, sigma1_avx512(w1), sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc3_avx512(&w4, sigma1_avx512(w2), sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc3_avx512(&w5, sigma1_avx512(w3), sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), K_avx512(256), sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, K_avx512(285220864))));
+        w8 = Add3_avx512(K_avx512(-2147483648), sigma1_avx512(w6), w1);
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), w8));
+        w9 = Add_avx512(sigma1_avx512(w7), w2);
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), w9));
+        w10 = Add_avx512(sigma1_avx512(w8), w3);
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), w10));
+        w11 = Add_avx512(sigma1_avx512(w9), w4);
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), w11));
+        w12 = Add_avx512(sigma1_avx512(w10), w5);
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), w12));
+        w13 = Add_avx512(sigma1_avx512(w11), w6);
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), w13));
+        w14 = Add3_avx512(sigma1_avx512(w12), w7, K_avx512(4194338));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), w14));
+        w15 = Add4_avx512(K_avx512(256), sigma1_avx512(w13), w8, sigma0_avx512(w0));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        /* The last three rounds leave h as it is. */
+        if (top) return Add_avx512(h, K_avx512(1541459225));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add5_avx512(K_avx512(-1090935817), w14, sigma1_avx512(w12), w7, sigma0_avx512(w15)));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add5_avx512(K_avx512(-965641998), w15, sigma1_avx512(w13), w8, sigma0_avx512(w0)));
+
+        /* Output */
+        Write16_avx512(&out->u8[0], Add_avx512(a, K_avx512(1779033703)));
+        Write16_avx512(&out->u8[4], Add_avx512(b, K_avx512(-1150833019)));
+        Write16_avx512(&out->u8[8], Add_avx512(c, K_avx512(1013904242)));
+        Write16_avx512(&out->u8[12], Add_avx512(d, K_avx512(-1521486534)));
+        Write16_avx512(&out->u8[16], Add_avx512(e, K_avx512(1359893119)));
+        Write16_avx512(&out->u8[20], Add_avx512(f, K_avx512(-1694144372)));
+        Write16_avx512(&out->u8[24], Add_avx512(g, K_avx512(528734635)));
+        Write16_avx512(&out->u8[28], Add_avx512(h, K_avx512(1541459225)));
+        return h;
+}
+
+/** Double SHA256 sixteen 64-byte blocks, with top as for
+ * sha256d32_avx512_16way(). */
+static inline __attribute__((always_inline)) __m512i sha256d64_avx512_16way(struct sha256 out[16], const struct sha256 in[32], int top)
+{
+        /* Transform 1 */
+        __m512i a = K_avx512(1779033703);
+        __m512i b = K_avx512(-1150833019);
+        __m512i c = K_avx512(1013904242);
+        __m512i d = K_avx512(-1521486534);
+        __m512i e = K_avx512(1359893119);
+        __m512i f = K_avx512(-1694144372);
+        __m512i g = K_avx512(528734635);
+        __m512i h = K_avx512(1541459225);
+
+        __m512i w0 = Read16_avx512(&in[0].u8[0]),
+                w1 = Read16_avx512(&in[0].u8[4]),
+                w2 = Read16_avx512(&in[0].u8[8]),
+                w3 = Read16_avx512(&in[0].u8[12]),
+                w4 = Read16_avx512(&in[0].u8[16]),
+                w5 = Read16_avx512(&in[0].u8[20]),
+                w6 = Read16_avx512(&in[0].u8[24]),
+                w7 = Read16_avx512(&in[0].u8[28]),
+                w8 = Read16_avx512(&in[1].u8[0]),
+                w9 = Read16_avx512(&in[1].u8[4]),
+                w10 = Read16_avx512(&in[1].u8[8]),
+                w11 = Read16_avx512(&in[1].u8[12]),
+                w12 = Read16_avx512(&in[1].u8[16]),
+                w13 = Read16_avx512(&in[1].u8[20]),
+                w14 = Read16_avx512(&in[1].u8[24]),
+                w15 = Read16_avx512(&in[1].u8[28]);
+
+        __m512i t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-670586216), w8));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(310598401), w9));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(607225278), w10));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1426881987), w11));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1925078388), w12));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-2132889090), w13));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1680079193), w14));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1046744716), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1090935817), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-965641998), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+
+        t0 = a = Add_avx512(a, K_avx512(1779033703));
+        t1 = b = Add_avx512(b, K_avx512(-1150833019));
+        t2 = c = Add_avx512(c, K_avx512(1013904242));
+        t3 = d = Add_avx512(d, K_avx512(-1521486534));
+        t4 = e = Add_avx512(e, K_avx512(1359893119));
+        t5 = f = Add_avx512(f, K_avx512(-1694144372));
+        t6 = g = Add_avx512(g, K_avx512(528734635));
+        t7 = h = Add_avx512(h, K_avx512(1541459225));
+
+        /* Transform 2 */
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-1031131240));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(1899447441));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(-1245643825));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(-373957723));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(961987163));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(1508970993));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1841331548));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1424204075));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-670586216));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(310598401));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(607225278));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1426881987));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1925078388));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-2132889090));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1680079193));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1046744204));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(1687906753));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(-251771002));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(266464710));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(604828244));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1340683375));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(1825146046));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(1639530782));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(385452282));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-221884078));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(-1467065747));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(-1340474267));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(-1176920377));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(-1710083645));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-418452832));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-38722773));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-952811856));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(812235477));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(-879268513));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(1510936975));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(-601952515));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(171292297));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-569673212));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(1492437661));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-513975530));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(8339078));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(923306368));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(-1526207950));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1873515831));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(390095120));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(227333873));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-844481683));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1061437897));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-2090779686));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(-615996573));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(184740145));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1875991719));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1377499850));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(825459761));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(1859394197));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(1833138320));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-1013149198));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(-1630753859));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(-1245077274));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1395635772));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(-758693434));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(119766691));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1533719704));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(1276714358));
+
+        w0 = Add_avx512(t0, a);
+        w1 = Add_avx512(t1, b);
+        w2 = Add_avx512(t2, c);
+        w3 = Add_avx512(t3, d);
+        w4 = Add_avx512(t4, e);
+        w5 = Add_avx512(t5, f);
+        w6 = Add_avx512(t6, g);
+        w7 = Add_avx512(t7, h);
+
+        return sha256d32_avx512_16way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d64_avx512_16way(struct sha256 out[16], const struct sha256 in[32])
+{
+        sha256d64_avx512_16way(out, in, 0);
+}
+
+/* Read16_avx512(), for blocks at the 80-byte stride of block headers. */
+static inline __attribute__((always_inline)) __m512i ReadHeader16_avx512(const unsigned char* chunk)
+{
+        return Bswap_avx512(_mm512_i32gather_epi32(
+                _mm512_set_epi32(
+                        0, 80, 160, 240, 320, 400, 480, 560,
+                        640, 720, 800, 880, 960, 1040, 1120, 1200),
+                (const void*)chunk, 1));
+}
+
+/** The same for sixteen block headers. */
+static inline __attribute__((always_inline)) __m512i sha256d80_avx512_16way(struct sha256 out[16], const unsigned char in[1280], int top)
+{
+        /* Transform 1 */
+        __m512i a = K_avx512(1779033703);
+        __m512i b = K_avx512(-1150833019);
+        __m512i c = K_avx512(1013904242);
+        __m512i d = K_avx512(-1521486534);
+        __m512i e = K_avx512(1359893119);
+        __m512i f = K_avx512(-1694144372);
+        __m512i g = K_avx512(528734635);
+        __m512i h = K_avx512(1541459225);
+
+        __m512i w0 = ReadHeader16_avx512(&in[0]),
+                w1 = ReadHeader16_avx512(&in[4]),
+                w2 = ReadHeader16_avx512(&in[8]),
+                w3 = ReadHeader16_avx512(&in[12]),
+                w4 = ReadHeader16_avx512(&in[16]),
+                w5 = ReadHeader16_avx512(&in[20]),
+                w6 = ReadHeader16_avx512(&in[24]),
+                w7 = ReadHeader16_avx512(&in[28]),
+                w8 = ReadHeader16_avx512(&in[32]),
+                w9 = ReadHeader16_avx512(&in[36]),
+                w10 = ReadHeader16_avx512(&in[40]),
+                w11 = ReadHeader16_avx512(&in[44]),
+                w12 = ReadHeader16_avx512(&in[48]),
+                w13 = ReadHeader16_avx512(&in[52]),
+                w14 = ReadHeader16_avx512(&in[56]),
+                w15 = ReadHeader16_avx512(&in[60]);
+
+        __m512i t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-670586216), w8));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(310598401), w9));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(607225278), w10));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1426881987), w11));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1925078388), w12));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-2132889090), w13));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1680079193), w14));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1046744716), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1090935817), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-965641998), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+
+        t0 = a = Add_avx512(a, K_avx512(1779033703));
+        t1 = b = Add_avx512(b, K_avx512(-1150833019));
+        t2 = c = Add_avx512(c, K_avx512(1013904242));
+        t3 = d = Add_avx512(d, K_avx512(-1521486534));
+        t4 = e = Add_avx512(e, K_avx512(1359893119));
+        t5 = f = Add_avx512(f, K_avx512(-1694144372));
+        t6 = g = Add_avx512(g, K_avx512(528734635));
+        t7 = h = Add_avx512(h, K_avx512(1541459225));
+
+        /* Transform 2 */
+        w0 = ReadHeader16_avx512(&in[64]);
+        w1 = ReadHeader16_avx512(&in[68]);
+        w2 = ReadHeader16_avx512(&in[72]);
+        w3 = ReadHeader16_avx512(&in[76]);
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(-1185496485));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(1508970993));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1841331548));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1424204075));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(-670586216));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(310598401));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(607225278));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1426881987));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1925078388));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-2132889090));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1680079193));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1046744076));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc_avx512(&w0, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc3_avx512(&w1, K_avx512(17825792), sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc3_avx512(&w2, sigma1_avx512(w0), sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc3_avx512(&w3, sigma1_avx512(w1), K_avx512(285220864))));
+        w4 = Add_avx512(K_avx512(-2147483648), sigma1_avx512(w2));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), w4));
+        w5 = sigma1_avx512(w3);
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), w5));
+        w6 = Add_avx512(sigma1_avx512(w4), K_avx512(640));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), w6));
+        w7 = Add_avx512(sigma1_avx512(w5), w0);
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), w7));
+        w8 = Add_avx512(sigma1_avx512(w6), w1);
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), w8));
+        w9 = Add_avx512(sigma1_avx512(w7), w2);
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), w9));
+        w10 = Add_avx512(sigma1_avx512(w8), w3);
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), w10));
+        w11 = Add_avx512(sigma1_avx512(w9), w4);
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), w11));
+        w12 = Add_avx512(sigma1_avx512(w10), w5);
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), w12));
+        w13 = Add_avx512(sigma1_avx512(w11), w6);
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), w13));
+        w14 = Add3_avx512(sigma1_avx512(w12), w7, K_avx512(10485845));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), w14));
+        w15 = Add4_avx512(K_avx512(640), sigma1_avx512(w13), w8, sigma0_avx512(w0));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1090935817), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-965641998), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+
+        w0 = Add_avx512(t0, a);
+        w1 = Add_avx512(t1, b);
+        w2 = Add_avx512(t2, c);
+        w3 = Add_avx512(t3, d);
+        w4 = Add_avx512(t4, e);
+        w5 = Add_avx512(t5, f);
+        w6 = Add_avx512(t6, g);
+        w7 = Add_avx512(t7, h);
+
+        return sha256d32_avx512_16way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d80_avx512_16way(struct sha256 out[16], const unsigned char in[1280])
+{
+        sha256d80_avx512_16way(out, in, 0);
+}
+
+static inline __attribute__((always_inline)) __m512i ReadHash16_avx512(const unsigned char* chunk)
+{
+        return Bswap_avx512(_mm512_i32gather_epi32(
+                _mm512_set_epi32(
+                        0, 32, 64, 96, 128, 160, 192, 224,
+                        256, 288, 320, 352, 384, 416, 448, 480),
+                (const void*)chunk, 1));
+}
+
+void transform_sha256d32_avx512_16way(struct sha256 out[16], const struct sha256 in[16])
+{
+        sha256d32_avx512_16way(out,
+                ReadHash16_avx512(&in->u8[0]),
+                ReadHash16_avx512(&in->u8[4]),
+                ReadHash16_avx512(&in->u8[8]),
+                ReadHash16_avx512(&in->u8[12]),
+                ReadHash16_avx512(&in->u8[16]),
+                ReadHash16_avx512(&in->u8[20]),
+                ReadHash16_avx512(&in->u8[24]),
+                ReadHash16_avx512(&in->u8[28]),
+                0);
+}
+
+/** Read the 32-bit word at the same offset in each of 16 lanes, gathering
+ * from lane pointers expressed as 64-bit displacements from a base. */
+static inline __attribute__((always_inline)) __m512i ReadLanes16_avx512(__m512i lo, __m512i hi, const unsigned char* base)
+{
+        return Bswap_avx512(
+                _mm512_inserti64x4(
+                        _mm512_castsi256_si512(_mm512_i64gather_epi32(lo, base, 1)),
+                        _mm512_i64gather_epi32(hi, base, 1), 1));
+}
+
+void transform_sha256mb_avx512_16way(uint32_t* s, const unsigned char* const in[16], size_t blocks)
+{
+        __m512i a, b, c, d, e, f, g, h;
+        __m512i t0, t1, t2, t3, t4, t5, t6, t7;
+        __m512i w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
+        __m512i lo, hi;
+        size_t offset = 0;
+
+        /* The lane pointers are converted to displacements from the first,
+         * so that each message word can be read with a pair of gathers. */
+        lo = _mm512_sub_epi64(_mm512_setr_epi64(
+                        (int64_t)(uintptr_t)in[0], (int64_t)(uintptr_t)in[1],
+                        (int64_t)(uintptr_t)in[2], (int64_t)(uintptr_t)in[3],
+                        (int64_t)(uintptr_t)in[4], (int64_t)(uintptr_t)in[5],
+                        (int64_t)(uintptr_t)in[6], (int64_t)(uintptr_t)in[7]),
+                _mm512_set1_epi64((int64_t)(uintptr_t)in[0]));
+        hi = _mm512_sub_epi64(_mm512_setr_epi64(
+                        (int64_t)(uintptr_t)in[8], (int64_t)(uintptr_t)in[9],
+                        (int64_t)(uintptr_t)in[10], (int64_t)(uintptr_t)in[11],
+                        (int64_t)(uintptr_t)in[12], (int64_t)(uintptr_t)in[13],
+                        (int64_t)(uintptr_t)in[14], (int64_t)(uintptr_t)in[15]),
+                _mm512_set1_epi64((int64_t)(uintptr_t)in[0]));
+
+        /* Load the transposed state.  See the comment in sha256_shani.c about
+         * the use of memcpy for unaligned vector access. */
+        memcpy(&a, s + 0, sizeof(a));
+        memcpy(&b, s + 16, sizeof(b));
+        memcpy(&c, s + 32, sizeof(c));
+        memcpy(&d, s + 48, sizeof(d));
+        memcpy(&e, s + 64, sizeof(e));
+        memcpy(&f, s + 80, sizeof(f));
+        memcpy(&g, s + 96, sizeof(g));
+        memcpy(&h, s + 112, sizeof(h));
+
+        for (; blocks; --blocks, offset += 64) {
+                t0 = a;
+                t1 = b;
+                t2 = c;
+                t3 = d;
+                t4 = e;
+                t5 = f;
+                t6 = g;
+                t7 = h;
+
+                w0 = ReadLanes16_avx512(lo, hi, in[0] + offset + 0);
+                w1 = ReadLanes16_avx512(lo, hi, in[0] + offset + 4);
+                w2 = ReadLanes16_avx512(lo, hi, in[0] + offset + 8);
+                w3 = ReadLanes16_avx512(lo, hi, in[0] + offset + 12);
+                w4 = ReadLanes16_avx512(lo, hi, in[0] + offset + 16);
+                w5 = ReadLanes16_avx512(lo, hi, in[0] + offset + 20);
+                w6 = ReadLanes16_avx512(lo, hi, in[0] + offset + 24);
+                w7 = ReadLanes16_avx512(lo, hi, in[0] + offset + 28);
+                w8 = ReadLanes16_avx512(lo, hi, in[0] + offset + 32);
+                w9 = ReadLanes16_avx512(lo, hi, in[0] + offset + 36);
+                w10 = ReadLanes16_avx512(lo, hi, in[0] + offset + 40);
+                w11 = ReadLanes16_avx512(lo, hi, in[0] + offset + 44);
+                w12 = ReadLanes16_avx512(lo, hi, in[0] + offset + 48);
+                w13 = ReadLanes16_avx512(lo, hi, in[0] + offset + 52);
+                w14 = ReadLanes16_avx512(lo, hi, in[0] + offset + 56);
+                w15 = ReadLanes16_avx512(lo, hi, in[0] + offset + 60);
+
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-670586216), w8));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(310598401), w9));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(607225278), w10));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1426881987), w11));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1925078388), w12));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-2132889090), w13));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1680079193), w14));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1046744716), w15));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1090935817), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-965641998), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+
+                a = Add_avx512(a, t0);
+                b = Add_avx512(b, t1);
+                c = Add_avx512(c, t2);
+                d = Add_avx512(d, t3);
+                e = Add_avx512(e, t4);
+                f = Add_avx512(f, t5);
+                g = Add_avx512(g, t6);
+                h = Add_avx512(h, t7);
+        }
+
+        /* Store the transposed state. */
+        memcpy(s + 0, &a, sizeof(a));
+        memcpy(s + 16, &b, sizeof(b));
+        memcpy(s + 32, &c, sizeof(c));
+        memcpy(s + 48, &d, sizeof(d));
+        memcpy(s + 64, &e, sizeof(e));
+        memcpy(s + 80, &f, sizeof(f));
+        memcpy(s + 96, &g, sizeof(g));
+        memcpy(s + 112, &h, sizeof(h));
+}
+
+/** Load word i of each lane of a lane-major state. */
+static inline __attribute__((always_inline)) __m512i Gather16_avx512(const uint32_t* s, int i)
+{
+        return _mm512_setr_epi32(
+                s[i], s[8 + i], s[16 + i], s[24 + i], s[32 + i], s[40 + i], s[48 + i], s[56 + i],
+                s[64 + i], s[72 + i], s[80 + i], s[88 + i], s[96 + i], s[104 + i], s[112 + i], s[120 + i]);
+}
+
+/** Store word i of each lane into a lane-major state. */
+static inline __attribute__((always_inline)) void Scatter16_avx512(uint32_t* s, int i, __m512i v)
+{
+        uint32_t t[16];
+        int j;
+        memcpy(t, &v, sizeof(t));
+        for (j = 0; j < 16; ++j) {
+                s[8 * j + i] = t[j];
+        }
+}
+
+/** The 16-lane counterpart of Hmac32_avx2() in sha256_avx2.c. */
+static inline __attribute__((always_inline)) void Hmac32_avx512(__m512i* out, const __m512i* s, const __m512i* in)
+{
+        __m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        __m512i w0 = in[0], w1 = in[1], w2 = in[2], w3 = in[3], w4 = in[4], w5 = in[5], w6 = in[6], w7 = in[7];
+        __m512i w8, w9, w10, w11, w12, w13, w14, w15;
+
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(1476897432));
+        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(310598401));
+        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(607225278));
+        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1426881987));
+        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1925078388));
+        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-2132889090));
+        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1680079193));
+        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1046743948));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc_avx512(&w0, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc3_avx512(&w1, K_avx512(31457280), sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc3_avx512(&w2, sigma1_avx512(w0), sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc3_avx512(&w3, sigma1_avx512(w1), sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc3_avx512(&w4, sigma1_avx512(w2), sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc3_avx512(&w5, sigma1_avx512(w3), sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), K_avx512(768), sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, K_avx512(285220864))));
+        w8 = Add3_avx512(K_avx512(-2147483648), sigma1_avx512(w6), w1);
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), w8));
+        w9 = Add_avx512(sigma1_avx512(w7), w2);
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), w9));
+        w10 = Add_avx512(sigma1_avx512(w8), w3);
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), w10));
+        w11 = Add_avx512(sigma1_avx512(w9), w4);
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), w11));
+        w12 = Add_avx512(sigma1_avx512(w10), w5);
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), w12));
+        w13 = Add_avx512(sigma1_avx512(w11), w6);
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), w13));
+        w14 = Add3_avx512(sigma1_avx512(w12), w7, K_avx512(12583014));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), w14));
+        w15 = Add4_avx512(K_avx512(768), sigma1_avx512(w13), w8, sigma0_avx512(w0));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), w15));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add5_avx512(K_avx512(-1090935817), w14, sigma1_avx512(w12), w7, sigma0_avx512(w15)));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add5_avx512(K_avx512(-965641998), w15, sigma1_avx512(w13), w8, sigma0_avx512(w0)));
+
+        out[0] = Add_avx512(s[0], a);
+        out[1] = Add_avx512(s[1], b);
+        out[2] = Add_avx512(s[2], c);
+        out[3] = Add_avx512(s[3], d);
+        out[4] = Add_avx512(s[4], e);
+        out[5] = Add_avx512(s[5], f);
+        out[6] = Add_avx512(s[6], g);
+        out[7] = Add_avx512(s[7], h);
+}
+
+void transform_sha256pbkdf2_avx512_16way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        __m512i si[8], so[8], w[8], x[8];
+        int i;
+
+        for (i = 0; i < 8; ++i) {
+                si[i] = Gather16_avx512(inner, i);
+                so[i] = Gather16_avx512(outer, i);
+                w[i] = Gather16_avx512(u, i);
+                x[i] = Gather16_avx512(f, i);
+        }
+        for (; iterations; --iterations) {
+                Hmac32_avx512(w, si, w);
+                Hmac32_avx512(w, so, w);
+                for (i = 0; i < 8; ++i) {
+                        x[i] = _mm512_xor_si512(x[i], w[i]);
+                }
+        }
+        for (i = 0; i < 8; ++i) {
+                Scatter16_avx512(u, i, w[i]);
+                Scatter16_avx512(f, i, x[i]);
+        }
+}
+
+/* Messages are loaded into the lanes in reverse order, so the last words of
+ * their hashes are reversed to match target before comparing. */
+uint32_t transform_sha256d64below_avx512_16way(const struct sha256 in[32], const uint32_t target[16])
+{
+        __m512i h = Bswap_avx512(sha256d64_avx512_16way(NULL, in, !0));
+        return (uint32_t)_mm512_cmple_epu32_mask(_mm512_permutexvar_epi32(_mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), h), _mm512_loadu_si512(target));
+}
+
+uint32_t transform_sha256d80below_avx512_16way(const unsigned char in[1280], const uint32_t target[16])
+{
+        __m512i h = Bswap_avx512(sha256d80_avx512_16way(NULL, in, !0));
+        return (uint32_t)_mm512_cmple_epu32_mask(_mm512_permutexvar_epi32(_mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), h), _mm512_loadu_si512(target));
+}
+
+uint32_t transform_sha256grind_avx512_16way(const struct sha256_grind* ctx, uint32_t nonce)
+{
+        const uint64_t dep = ctx->dep;
+        __m512i n = Bswap_avx512(Add_avx512(K_avx512(nonce), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+        __m512i a = K_avx512(ctx->state[0]);
+        __m512i b = K_avx512(ctx->state[1]);
+        __m512i c = K_avx512(ctx->state[2]);
+        __m512i d = K_avx512(ctx->state[3]);
+        __m512i e = K_avx512(ctx->state[4]);
+        __m512i f = K_avx512(ctx->state[5]);
+        __m512i g = K_avx512(ctx->state[6]);
+        __m512i h = K_avx512(ctx->state[7]);
+
+        __m512i w0 = K_avx512(ctx->w[0]),
+                w1 = K_avx512(ctx->w[1]),
+                w2 = K_avx512(ctx->w[2]),
+                w3 = K_avx512(ctx->w[3]),
+                w4 = K_avx512(ctx->w[4]),
+                w5 = K_avx512(ctx->w[5]),
+                w6 = K_avx512(ctx->w[6]),
+                w7 = K_avx512(ctx->w[7]),
+                w8 = K_avx512(ctx->w[8]),
+                w9 = K_avx512(ctx->w[9]),
+                w10 = K_avx512(ctx->w[10]),
+                w11 = K_avx512(ctx->w[11]),
+                w12 = K_avx512(ctx->w[12]),
+                w13 = K_avx512(ctx->w[13]),
+                w14 = K_avx512(ctx->w[14]),
+                w15 = K_avx512(ctx->w[15]);
+
+        /* Enter at the round which first reads the nonce, with the
+         * state rotated to match. */
+        switch (ctx->word) {
+        case 0:
+                if ((dep >> 0) & 1) {
+                        w0 = n;
+                        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+                } else {
+                        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(ctx->kw[0]));
+                }
+                /* FALLTHROUGH */
+        case 1:
+                if ((dep >> 1) & 1) {
+                        w1 = n;
+                        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+                } else {
+                        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(ctx->kw[1]));
+                }
+                /* FALLTHROUGH */
+        case 2:
+                if ((dep >> 2) & 1) {
+                        w2 = n;
+                        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+                } else {
+                        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(ctx->kw[2]));
+                }
+                /* FALLTHROUGH */
+        case 3:
+                if ((dep >> 3) & 1) {
+                        w3 = n;
+                        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+                } else {
+                        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(ctx->kw[3]));
+                }
+                /* FALLTHROUGH */
+        case 4:
+                if ((dep >> 4) & 1) {
+                        w4 = n;
+                        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+                } else {
+                        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(ctx->kw[4]));
+                }
+                /* FALLTHROUGH */
+        case 5:
+                if ((dep >> 5) & 1) {
+                        w5 = n;
+                        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+                } else {
+                        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(ctx->kw[5]));
+                }
+                /* FALLTHROUGH */
+        case 6:
+                if ((dep >> 6) & 1) {
+                        w6 = n;
+                        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+                } else {
+                        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(ctx->kw[6]));
+                }
+                /* FALLTHROUGH */
+        case 7:
+                if ((dep >> 7) & 1) {
+                        w7 = n;
+                        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+                } else {
+                        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(ctx->kw[7]));
+                }
+                /* FALLTHROUGH */
+        case 8:
+                if ((dep >> 8) & 1) {
+                        w8 = n;
+                        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-670586216), w8));
+                } else {
+                        Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(ctx->kw[8]));
+                }
+                /* FALLTHROUGH */
+        case 9:
+                if ((dep >> 9) & 1) {
+                        w9 = n;
+                        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(310598401), w9));
+                } else {
+                        Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(ctx->kw[9]));
+                }
+                /* FALLTHROUGH */
+        case 10:
+                if ((dep >> 10) & 1) {
+                        w10 = n;
+                        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(607225278), w10));
+                } else {
+                        Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(ctx->kw[10]));
+                }
+                /* FALLTHROUGH */
+        case 11:
+                if ((dep >> 11) & 1) {
+                        w11 = n;
+                        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1426881987), w11));
+                } else {
+                        Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(ctx->kw[11]));
+                }
+                /* FALLTHROUGH */
+        case 12:
+                if ((dep >> 12) & 1) {
+                        w12 = n;
+                        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1925078388), w12));
+                } else {
+                        Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(ctx->kw[12]));
+                }
+                /* FALLTHROUGH */
+        case 13:
+                if ((dep >> 13) & 1) {
+                        w13 = n;
+                        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-2132889090), w13));
+                } else {
+                        Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(ctx->kw[13]));
+                }
+                /* FALLTHROUGH */
+        case 14:
+                if ((dep >> 14) & 1) {
+                        w14 = n;
+                        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1680079193), w14));
+                } else {
+                        Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(ctx->kw[14]));
+                }
+                /* FALLTHROUGH */
+        case 15:
+                if ((dep >> 15) & 1) {
+                        w15 = n;
+                        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1046744716), w15));
+                } else {
+                        Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(ctx->kw[15]));
+                }
+        }
+        if ((dep >> 16) & 1) {
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        } else {
+                w0 = K_avx512(ctx->w[16]);
+                Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(ctx->kw[16]));
+        }
+        if ((dep >> 17) & 1) {
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        } else {
+                w1 = K_avx512(ctx->w[17]);
+                Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(ctx->kw[17]));
+        }
+        if ((dep >> 18) & 1) {
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        } else {
+                w2 = K_avx512(ctx->w[18]);
+                Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(ctx->kw[18]));
+        }
+        if ((dep >> 19) & 1) {
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        } else {
+                w3 = K_avx512(ctx->w[19]);
+                Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(ctx->kw[19]));
+        }
+        if ((dep >> 20) & 1) {
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        } else {
+                w4 = K_avx512(ctx->w[20]);
+                Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(ctx->kw[20]));
+        }
+        if ((dep >> 21) & 1) {
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        } else {
+                w5 = K_avx512(ctx->w[21]);
+                Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(ctx->kw[21]));
+        }
+        if ((dep >> 22) & 1) {
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        } else {
+                w6 = K_avx512(ctx->w[22]);
+                Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(ctx->kw[22]));
+        }
+        if ((dep >> 23) & 1) {
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        } else {
+                w7 = K_avx512(ctx->w[23]);
+                Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(ctx->kw[23]));
+        }
+        if ((dep >> 24) & 1) {
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        } else {
+                w8 = K_avx512(ctx->w[24]);
+                Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(ctx->kw[24]));
+        }
+        if ((dep >> 25) & 1) {
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        } else {
+                w9 = K_avx512(ctx->w[25]);
+                Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(ctx->kw[25]));
+        }
+        if ((dep >> 26) & 1) {
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        } else {
+                w10 = K_avx512(ctx->w[26]);
+                Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(ctx->kw[26]));
+        }
+        if ((dep >> 27) & 1) {
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        } else {
+                w11 = K_avx512(ctx->w[27]);
+                Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(ctx->kw[27]));
+        }
+        if ((dep >> 28) & 1) {
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        } else {
+                w12 = K_avx512(ctx->w[28]);
+                Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(ctx->kw[28]));
+        }
+        if ((dep >> 29) & 1) {
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        } else {
+                w13 = K_avx512(ctx->w[29]);
+                Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(ctx->kw[29]));
+        }
+        if ((dep >> 30) & 1) {
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        } else {
+                w14 = K_avx512(ctx->w[30]);
+                Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(ctx->kw[30]));
+        }
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+        Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+        Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+        Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+        Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+        Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+        Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+        Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+        Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+
+        if (ctx->twice) {
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-1538233109), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add5_avx512(K_avx512(-1090935817), w14, sigma1_avx512(w12), w7, sigma0_avx512(w15)));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add5_avx512(K_avx512(-965641998), w15, sigma1_avx512(w13), w8, sigma0_avx512(w0)));
+
+                w0 = Add_avx512(a, K_avx512(ctx->midstate[0]));
+                w1 = Add_avx512(b, K_avx512(ctx->midstate[1]));
+                w2 = Add_avx512(c, K_avx512(ctx->midstate[2]));
+                w3 = Add_avx512(d, K_avx512(ctx->midstate[3]));
+                w4 = Add_avx512(e, K_avx512(ctx->midstate[4]));
+                w5 = Add_avx512(f, K_avx512(ctx->midstate[5]));
+                w6 = Add_avx512(g, K_avx512(ctx->midstate[6]));
+                w7 = Add_avx512(h, K_avx512(ctx->midstate[7]));
+
+                a = K_avx512(1779033703);
+                b = K_avx512(-1150833019);
+                c = K_avx512(1013904242);
+                d = K_avx512(-1521486534);
+                e = K_avx512(1359893119);
+                f = K_avx512(-1694144372);
+                g = K_avx512(528734635);
+                h = K_avx512(1541459225);
+
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1116352408), w0));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(1899447441), w1));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1245643825), w2));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-373957723), w3));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(961987163), w4));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1508970993), w5));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-1841331548), w6));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1424204075), w7));
+                Round_avx512(a, b, c, &d, e, f, g, &h, K_avx512(1476897432));
+                Round_avx512(h, a, b, &c, d, e, f, &g, K_avx512(310598401));
+                Round_avx512(g, h, a, &b, c, d, e, &f, K_avx512(607225278));
+                Round_avx512(f, g, h, &a, b, c, d, &e, K_avx512(1426881987));
+                Round_avx512(e, f, g, &h, a, b, c, &d, K_avx512(1925078388));
+                Round_avx512(d, e, f, &g, h, a, b, &c, K_avx512(-2132889090));
+                Round_avx512(c, d, e, &f, g, h, a, &b, K_avx512(-1680079193));
+                Round_avx512(b, c, d, &e, f, g, h, &a, K_avx512(-1046744460));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-459576895), Inc_avx512(&w0, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-272742522), Inc3_avx512(&w1, K_avx512(10485760), sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(264347078), Inc3_avx512(&w2, sigma1_avx512(w0), sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(604807628), Inc3_avx512(&w3, sigma1_avx512(w1), sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(770255983), Inc3_avx512(&w4, sigma1_avx512(w2), sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1249150122), Inc3_avx512(&w5, sigma1_avx512(w3), sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1555081692), Inc4_avx512(&w6, sigma1_avx512(w4), K_avx512(256), sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1996064986), Inc4_avx512(&w7, sigma1_avx512(w5), w0, K_avx512(285220864))));
+                w8 = Add3_avx512(K_avx512(-2147483648), sigma1_avx512(w6), w1);
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1740746414), w8));
+                w9 = Add_avx512(sigma1_avx512(w7), w2);
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1473132947), w9));
+                w10 = Add_avx512(sigma1_avx512(w8), w3);
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1341970488), w10));
+                w11 = Add_avx512(sigma1_avx512(w9), w4);
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1084653625), w11));
+                w12 = Add_avx512(sigma1_avx512(w10), w5);
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-958395405), w12));
+                w13 = Add_avx512(sigma1_avx512(w11), w6);
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-710438585), w13));
+                w14 = Add3_avx512(sigma1_avx512(w12), w7, K_avx512(4194338));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(113926993), w14));
+                w15 = Add4_avx512(K_avx512(256), sigma1_avx512(w13), w8, sigma0_avx512(w0));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(338241895), w15));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(666307205), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(773529912), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(1294757372), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(1396182291), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(1695183700), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1986661051), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-2117940946), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(-1838011259), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(-1564481375), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(-1474664885), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-1035236496), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-949202525), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-778901479), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(-694614492), Inc4_avx512(&w13, sigma1_avx512(w11), w6, sigma0_avx512(w14))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(-200395387), Inc4_avx512(&w14, sigma1_avx512(w12), w7, sigma0_avx512(w15))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(275423344), Inc4_avx512(&w15, sigma1_avx512(w13), w8, sigma0_avx512(w0))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(430227734), Inc4_avx512(&w0, sigma1_avx512(w14), w9, sigma0_avx512(w1))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(506948616), Inc4_avx512(&w1, sigma1_avx512(w15), w10, sigma0_avx512(w2))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(659060556), Inc4_avx512(&w2, sigma1_avx512(w0), w11, sigma0_avx512(w3))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(883997877), Inc4_avx512(&w3, sigma1_avx512(w1), w12, sigma0_avx512(w4))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(958139571), Inc4_avx512(&w4, sigma1_avx512(w2), w13, sigma0_avx512(w5))));
+                Round_avx512(d, e, f, &g, h, a, b, &c, Add_avx512(K_avx512(1322822218), Inc4_avx512(&w5, sigma1_avx512(w3), w14, sigma0_avx512(w6))));
+                Round_avx512(c, d, e, &f, g, h, a, &b, Add_avx512(K_avx512(1537002063), Inc4_avx512(&w6, sigma1_avx512(w4), w15, sigma0_avx512(w7))));
+                Round_avx512(b, c, d, &e, f, g, h, &a, Add_avx512(K_avx512(1747873779), Inc4_avx512(&w7, sigma1_avx512(w5), w0, sigma0_avx512(w8))));
+                Round_avx512(a, b, c, &d, e, f, g, &h, Add_avx512(K_avx512(1955562222), Inc4_avx512(&w8, sigma1_avx512(w6), w1, sigma0_avx512(w9))));
+                Round_avx512(h, a, b, &c, d, e, f, &g, Add_avx512(K_avx512(2024104815), Inc4_avx512(&w9, sigma1_avx512(w7), w2, sigma0_avx512(w10))));
+                Round_avx512(g, h, a, &b, c, d, e, &f, Add_avx512(K_avx512(-2067236844), Inc4_avx512(&w10, sigma1_avx512(w8), w3, sigma0_avx512(w11))));
+                Round_avx512(f, g, h, &a, b, c, d, &e, Add_avx512(K_avx512(-1933114872), Inc4_avx512(&w11, sigma1_avx512(w9), w4, sigma0_avx512(w12))));
+                Round_avx512(e, f, g, &h, a, b, c, &d, Add_avx512(K_avx512(-1866530822), Inc4_avx512(&w12, sigma1_avx512(w10), w5, sigma0_avx512(w13))));
+                h = Add_avx512(h, K_avx512(1541459225));
+        } else {
+                h = Add_avx512(h, K_avx512(ctx->midstate[7]));
+        }
+
+        /* h is now the last word of the hash, whose bytes are the most
+         * significant when the hash is read as a little-endian number. */
+        return (uint32_t)_mm512_cmple_epu32_mask(Bswap_avx512(h), K_avx512(ctx->target));
+}
+
+#else
+/* -Wempty-translation-unit
+ * ISO C requires a translation unit to contain at least one declaration
+ */
+typedef int avx512_make_iso_compilers_happy;
+#endif
+
+/* End of File
+ */
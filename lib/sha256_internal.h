@@ -11,21 +11,136 @@
 
 #include <sha2/sha256.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Backend-specific entry points, for benchmarks and tests.  Backends are
+ * numbered as for sha256_backend_count(), and must be supported by the host
+ * before they are used. */
+extern void sha256_update_backend(size_t backend, struct sha256_ctx* ctx, const void *data, size_t len);
+extern void sha256_done_backend(size_t backend, struct sha256* hash, struct sha256_ctx* ctx);
+extern void sha256_double64_backend(size_t backend, struct sha256 out[], const struct sha256 in[], size_t blocks);
+extern size_t sha256_double64_meets_target_backend(size_t backend, unsigned char bitmap[], const struct sha256 in[], size_t blocks, const struct sha256* target);
+extern void sha256_midstate_backend(size_t backend, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t blocks);
+extern void sha256_merkle_root_backend(size_t backend, struct sha256* root, struct sha256 hashes[], size_t count);
+extern size_t sha256_check_headers_backend(size_t backend, unsigned char bitmap[], struct sha256 hashes[], const unsigned char headers[], size_t count);
+extern size_t sha256_grind_backend(size_t backend, uint32_t nonces[], size_t max_nonces, const uint32_t midstate[8], const unsigned char tail[64], size_t nonce_offset, uint32_t start, uint64_t count, const struct sha256* target, int twice);
+extern void sha256_pbkdf2_iterate_backend(size_t backend, uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t count, size_t iterations);
+extern void sha256_midstate_final64_backend(size_t backend, struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t count);
+
+/* The inner loop of PBKDF2-HMAC-SHA256, in count independent lanes.  Lane j
+ * has the words of its running XOR at f + 8*j, its last HMAC output at u + 8*j,
+ * and the midstates of its key (see struct hmac_sha256_key) at inner + 8*j and
+ * outer + 8*j.  Each iteration replaces u with its HMAC under the key, and
+ * XORs the result into f. */
+extern void sha256_pbkdf2_iterate(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t count, size_t iterations);
+
+/* Finish the SHA256 of count 128-byte messages which share their first block,
+ * from the midstate after it.  The second block of message i is at in + 64*i,
+ * and each hash is the two compressions of that block and of the padding, in
+ * the lanes of the multi-buffer kernels. */
+extern void sha256_midstate_final64(struct sha256 out[], const uint32_t midstate[8], const unsigned char in[], size_t count);
+
+/* The precomputed parts of a nonce search (see sha256_grind()), for the
+ * grinding kernels.  The message schedule words which do not depend on the
+ * nonce are in w, and with the round constants added in kw.  Bit t of dep is
+ * set for each word which does, starting with the nonce's own word, w[word].
+ * The state after the rounds before that word, which are the same for every
+ * nonce, is in state, rotated left by word places to match the round at which
+ * the kernels begin.  target is the most significant word of the target, and
+ * the kernels return the mask of lanes, for nonces nonce + i, whose hash has a
+ * most significant word no greater. */
+struct sha256_grind {
+        uint32_t midstate[8];
+        uint32_t state[8];
+        uint32_t w[64];
+        uint32_t kw[64];
+        uint64_t dep;
+        uint32_t target;
+        unsigned word;
+        int twice;
+};
+
+/* The portable kernels of sha256_vec.c need the vector extension of GCC and
+ * Clang, and are only built for targets with a SIMD unit for the compiler to
+ * map it onto, rather than to scalar code slower than the standard backend. */
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ALTIVEC__) || defined(__VSX__) || defined(__loongarch_sx) || defined(__mips_msa) || defined(__VX__) || defined(__riscv_vector) || defined(__wasm_simd128__))
+#define SHA256_VEC
+#endif
+
+#if defined(SHA256_VEC)
+extern void transform_sha256multi_vec_4way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256d64_vec_4way(struct sha256 out[4], const struct sha256 in[8]);
+extern void transform_sha256d80_vec_4way(struct sha256 out[4], const unsigned char in[320]);
+extern void transform_sha256d32_vec_4way(struct sha256 out[4], const struct sha256 in[4]);
+extern uint32_t transform_sha256d64below_vec_4way(const struct sha256 in[8], const uint32_t target[4]);
+extern uint32_t transform_sha256d80below_vec_4way(const unsigned char in[320], const uint32_t target[4]);
+
+extern void transform_sha256multi_vec_8way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256d64_vec_8way(struct sha256 out[8], const struct sha256 in[16]);
+extern void transform_sha256d80_vec_8way(struct sha256 out[8], const unsigned char in[640]);
+extern void transform_sha256d32_vec_8way(struct sha256 out[8], const struct sha256 in[8]);
+extern uint32_t transform_sha256d64below_vec_8way(const struct sha256 in[16], const uint32_t target[8]);
+extern uint32_t transform_sha256d80below_vec_8way(const unsigned char in[640], const uint32_t target[8]);
+#endif
+
 #if defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
 extern void transform_sha256_sse4(uint32_t* s, const unsigned char* chunk, size_t blocks);
 
 extern void transform_sha256multi_sse41_4way(struct sha256* out, const uint32_t* s, const unsigned char* in);
 extern void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in[8]);
+extern void transform_sha256d80_sse41_4way(struct sha256 out[4], const unsigned char in[320]);
+extern void transform_sha256d32_sse41_4way(struct sha256 out[4], const struct sha256 in[4]);
+extern uint32_t transform_sha256d64below_sse41_4way(const struct sha256 in[8], const uint32_t target[4]);
+extern uint32_t transform_sha256d80below_sse41_4way(const unsigned char in[320], const uint32_t target[4]);
+extern void transform_sha256mb_sse41_4way(uint32_t* s, const unsigned char* const in[4], size_t blocks);
+extern void transform_sha256pbkdf2_sse41_4way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations);
+extern uint32_t transform_sha256grind_sse41_4way(const struct sha256_grind* ctx, uint32_t nonce);
 
 extern void transform_sha256multi_avx2_8way(struct sha256* out, const uint32_t* s, const unsigned char* in);
 extern void transform_sha256d64_avx2_8way(struct sha256 out[8], const struct sha256 in[16]);
+extern void transform_sha256d80_avx2_8way(struct sha256 out[8], const unsigned char in[640]);
+extern void transform_sha256d32_avx2_8way(struct sha256 out[8], const struct sha256 in[8]);
+extern uint32_t transform_sha256d64below_avx2_8way(const struct sha256 in[16], const uint32_t target[8]);
+extern uint32_t transform_sha256d80below_avx2_8way(const unsigned char in[640], const uint32_t target[8]);
+extern void transform_sha256mb_avx2_8way(uint32_t* s, const unsigned char* const in[8], size_t blocks);
+extern void transform_sha256pbkdf2_avx2_8way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations);
+extern uint32_t transform_sha256grind_avx2_8way(const struct sha256_grind* ctx, uint32_t nonce);
+
+extern void transform_sha256_avx2_rorx(uint32_t* s, const unsigned char* chunk, size_t blocks);
+
+extern void transform_sha256multi_avx512_16way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256d64_avx512_16way(struct sha256 out[16], const struct sha256 in[32]);
+extern void transform_sha256d80_avx512_16way(struct sha256 out[16], const unsigned char in[1280]);
+extern void transform_sha256d32_avx512_16way(struct sha256 out[16], const struct sha256 in[16]);
+extern uint32_t transform_sha256d64below_avx512_16way(const struct sha256 in[32], const uint32_t target[16]);
+extern uint32_t transform_sha256d80below_avx512_16way(const unsigned char in[1280], const uint32_t target[16]);
+extern void transform_sha256mb_avx512_16way(uint32_t* s, const unsigned char* const in[16], size_t blocks);
+extern void transform_sha256pbkdf2_avx512_16way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations);
+extern uint32_t transform_sha256grind_avx512_16way(const struct sha256_grind* ctx, uint32_t nonce);
 
 extern void transform_sha256_shani(uint32_t* s, const unsigned char* chunk, size_t blocks);
+extern void transform_sha256multi_shani_2way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256multi_shani_4way(struct sha256* out, const uint32_t* s, const unsigned char* in);
 extern void transform_sha256d64_shani_2way(struct sha256 out[2], const struct sha256 in[4]);
+extern void transform_sha256pbkdf2_shani_2way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations);
 #endif
 #if defined(__arm__) || defined(__aarch32__) || defined(__arm64__) || defined(__aarch64__) || defined(_M_ARM)
 extern void transform_sha256_armv8(uint32_t* s, const unsigned char* chunk, size_t blocks);
+extern void transform_sha256multi_armv8_2way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256multi_armv8_4way(struct sha256* out, const uint32_t* s, const unsigned char* in);
 extern void transform_sha256d64_armv8_2way(struct sha256 out[2], const struct sha256 in[4]);
+extern void transform_sha256d64_armv8_4way(struct sha256 out[4], const struct sha256 in[8]);
+#endif
+#if defined(__aarch64__)
+extern void transform_sha256multi_neon_4way(struct sha256* out, const uint32_t* s, const unsigned char* in);
+extern void transform_sha256d64_neon_4way(struct sha256 out[4], const struct sha256 in[8]);
+extern uint32_t transform_sha256d64below_neon_4way(const struct sha256 in[8], const uint32_t target[4]);
+#endif
+
+#ifdef __cplusplus
+}
 #endif
 
 #endif /* SHA2__SHA256_INTERNAL_H */
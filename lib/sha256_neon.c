@@ -0,0 +1,496 @@
+/* Copyright (c) 2018-2019 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* The 4-way kernels of sha256_sse41.c, for AArch64 cores with Advanced SIMD
+ * but without the SHA2 instructions, such as the Cortex-A72 of the Raspberry
+ * Pi 4.  Message j of each kernel is in lane j, rather than in lane 3-j as on
+ * x86, since the lanes are read and written one word at a time anyway. */
+
+#if defined(__aarch64__)
+
+#include <sha2/sha256.h>
+#include "sha256_internal.h"
+
+#include <stdint.h> /* for uint32_t */
+#include <arm_neon.h> /* for Advanced SIMD intrinsics */
+
+#include "common.h"
+
+/* As in sha256_sse41.c, most of the following are macros rather than
+ * inlines, to keep the code compatible with C89.  The shift counts of the
+ * NEON intrinsics must be constant expressions, so Rotr_neon() is a macro
+ * even though it references x twice, and must not be passed an expression
+ * with side effects. */
+
+#define K_neon(x) vdupq_n_u32((uint32_t)(x))
+
+#define Add_neon(x, y) vaddq_u32((x), (y))
+#define Add3_neon(x, y, z) Add_neon(Add_neon((x), (y)), (z))
+#define Add4_neon(x, y, z, w) Add_neon(Add_neon((x), (y)), Add_neon((z), (w)))
+#define Add5_neon(x, y, z, w, v) Add_neon(Add3_neon((x), (y), (z)), Add_neon((w), (v)))
+static inline __attribute__((always_inline)) uint32x4_t Inc_neon(uint32x4_t *x, uint32x4_t y) { *x = Add_neon(*x, y); return *x; }
+static inline __attribute__((always_inline)) uint32x4_t Inc3_neon(uint32x4_t *x, uint32x4_t y, uint32x4_t z) { *x = Add3_neon(*x, y, z); return *x; }
+static inline __attribute__((always_inline)) uint32x4_t Inc4_neon(uint32x4_t *x, uint32x4_t y, uint32x4_t z, uint32x4_t w) { *x = Add4_neon(*x, y, z, w); return *x; }
+#define Xor_neon(x, y) veorq_u32((x), (y))
+#define Xor3_neon(x, y, z) Xor_neon(Xor_neon((x), (y)), (z))
+#define ShR_neon(x, n) vshrq_n_u32((x), (n))
+/* The right shift is inserted into the left shift by a single SRI. */
+#define Rotr_neon(x, n) vsriq_n_u32(vshlq_n_u32((x), 32 - (n)), (x), (n))
+
+/* Ch and Maj are both bitwise selects: Ch(x, y, z) takes y where x is set
+ * and z elsewhere, and Maj(x, y, z) takes z where x and y differ and y (or
+ * x) where they agree. */
+static inline __attribute__((always_inline)) uint32x4_t Ch_neon(uint32x4_t x, uint32x4_t y, uint32x4_t z) { return vbslq_u32(x, y, z); }
+static inline __attribute__((always_inline)) uint32x4_t Maj_neon(uint32x4_t x, uint32x4_t y, uint32x4_t z) { return vbslq_u32(Xor_neon(x, y), z, y); }
+static inline __attribute__((always_inline)) uint32x4_t Sigma0_neon(uint32x4_t x) { return Xor3_neon(Rotr_neon(x, 2), Rotr_neon(x, 13), Rotr_neon(x, 22)); }
+static inline __attribute__((always_inline)) uint32x4_t Sigma1_neon(uint32x4_t x) { return Xor3_neon(Rotr_neon(x, 6), Rotr_neon(x, 11), Rotr_neon(x, 25)); }
+static inline __attribute__((always_inline)) uint32x4_t sigma0_neon(uint32x4_t x) { return Xor3_neon(Rotr_neon(x, 7), Rotr_neon(x, 18), ShR_neon(x, 3)); }
+static inline __attribute__((always_inline)) uint32x4_t sigma1_neon(uint32x4_t x) { return Xor3_neon(Rotr_neon(x, 17), Rotr_neon(x, 19), ShR_neon(x, 10)); }
+
+/** One round of SHA-256. */
+static inline __attribute__((always_inline)) void Round_neon(uint32x4_t a, uint32x4_t b, uint32x4_t c, uint32x4_t *d, uint32x4_t e, uint32x4_t f, uint32x4_t g, uint32x4_t *h, uint32x4_t k)
+{
+        uint32x4_t t1 = Add4_neon(*h, Sigma1_neon(e), Ch_neon(e, f, g), k);
+        uint32x4_t t2 = Add_neon(Sigma0_neon(a), Maj_neon(a, b, c));
+        *d = Add_neon(*d, t1);
+        *h = Add_neon(t1, t2);
+}
+
+static inline __attribute__((always_inline)) uint32x4_t Read4_neon(const unsigned char* chunk) {
+        uint32x4_t v = vdupq_n_u32(ReadBE32(chunk + 0));
+        v = vsetq_lane_u32(ReadBE32(chunk + 64), v, 1);
+        v = vsetq_lane_u32(ReadBE32(chunk + 128), v, 2);
+        return vsetq_lane_u32(ReadBE32(chunk + 192), v, 3);
+}
+
+static inline __attribute__((always_inline)) void Write4_neon(unsigned char *out, uint32x4_t v) {
+        WriteBE32(out + 0, vgetq_lane_u32(v, 0));
+        WriteBE32(out + 32, vgetq_lane_u32(v, 1));
+        WriteBE32(out + 64, vgetq_lane_u32(v, 2));
+        WriteBE32(out + 96, vgetq_lane_u32(v, 3));
+}
+
+void transform_sha256multi_neon_4way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        /* Transform 1 */
+        uint32x4_t a = K_neon(s[0]);
+        uint32x4_t b = K_neon(s[1]);
+        uint32x4_t c = K_neon(s[2]);
+        uint32x4_t d = K_neon(s[3]);
+        uint32x4_t e = K_neon(s[4]);
+        uint32x4_t f = K_neon(s[5]);
+        uint32x4_t g = K_neon(s[6]);
+        uint32x4_t h = K_neon(s[7]);
+
+        uint32x4_t w0 = Read4_neon(in + 0),
+                w1 = Read4_neon(in + 4),
+                w2 = Read4_neon(in + 8),
+                w3 = Read4_neon(in + 12),
+                w4 = Read4_neon(in + 16),
+                w5 = Read4_neon(in + 20),
+                w6 = Read4_neon(in + 24),
+                w7 = Read4_neon(in + 28),
+                w8 = Read4_neon(in + 32),
+                w9 = Read4_neon(in + 36),
+                w10 = Read4_neon(in + 40),
+                w11 = Read4_neon(in + 44),
+                w12 = Read4_neon(in + 48),
+                w13 = Read4_neon(in + 52),
+                w14 = Read4_neon(in + 56),
+                w15 = Read4_neon(in + 60);
+
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1116352408), w0));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(1899447441), w1));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1245643825), w2));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-373957723), w3));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(961987163), w4));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1508970993), w5));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1841331548), w6));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1424204075), w7));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-670586216), w8));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(310598401), w9));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(607225278), w10));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(1426881987), w11));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(1925078388), w12));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-2132889090), w13));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1680079193), w14));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1046744716), w15));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-459576895), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-272742522), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(264347078), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(604807628), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(770255983), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1249150122), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1555081692), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1996064986), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1740746414), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1473132947), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1341970488), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1084653625), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-958395405), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-710438585), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(113926993), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(338241895), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(666307205), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(773529912), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(1294757372), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(1396182291), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(1695183700), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1986661051), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-2117940946), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1838011259), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1564481375), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1474664885), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1035236496), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-949202525), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-778901479), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-694614492), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-200395387), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(275423344), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(430227734), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(506948616), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(659060556), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(883997877), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(958139571), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1322822218), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1537002063), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1747873779), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1955562222), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(2024104815), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-2067236844), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1933114872), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-1866530822), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-1538233109), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1090935817), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-965641998), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+
+        /* Output */
+        Write4_neon(&out->u8[0], Add_neon(a, K_neon(s[0])));
+        Write4_neon(&out->u8[4], Add_neon(b, K_neon(s[1])));
+        Write4_neon(&out->u8[8], Add_neon(c, K_neon(s[2])));
+        Write4_neon(&out->u8[12], Add_neon(d, K_neon(s[3])));
+        Write4_neon(&out->u8[16], Add_neon(e, K_neon(s[4])));
+        Write4_neon(&out->u8[20], Add_neon(f, K_neon(s[5])));
+        Write4_neon(&out->u8[24], Add_neon(g, K_neon(s[6])));
+        Write4_neon(&out->u8[28], Add_neon(h, K_neon(s[7])));
+}
+
+/** The SHA256 of 32-byte messages, whose words are w0 to w7, as the second
+ * hash of a double SHA256.  With top set, only the last word of each hash is
+ * computed, and it is returned without writing out. */
+static inline __attribute__((always_inline)) uint32x4_t sha256d32_neon_4way(struct sha256 out[4], uint32x4_t w0, uint32x4_t w1, uint32x4_t w2, uint32x4_t w3, uint32x4_t w4, uint32x4_t w5, uint32x4_t w6, uint32x4_t w7, int top)
+{
+        uint32x4_t a, b, c, d, e, f, g, h;
+        uint32x4_t w8, w9, w10, w11, w12, w13, w14, w15;
+
+        a = K_neon(1779033703);
+        b = K_neon(-1150833019);
+        c = K_neon(1013904242);
+        d = K_neon(-1521486534);
+        e = K_neon(1359893119);
+        f = K_neon(-1694144372);
+        g = K_neon(528734635);
+        h = K_neon(1541459225);
+
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1116352408), w0));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(1899447441), w1));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1245643825), w2));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-373957723), w3));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(961987163), w4));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1508970993), w5));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1841331548), w6));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1424204075), w7));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(1476897432));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(310598401));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(607225278));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(1426881987));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(1925078388));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(-2132889090));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-1680079193));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-1046744460));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-459576895), Inc_neon(&w0, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-272742522), Inc3_neon(&w1, K_neon(10485760), sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(264347078), Inc3_neon(&w2, sigma1_neon(w0), sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(604807628), Inc3_neon(&w3, sigma1_neon(w1), sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(770255983), Inc3_neon(&w4, sigma1_neon(w2), sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1249150122), Inc3_neon(&w5, sigma1_neon(w3), sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1555081692), Inc4_neon(&w6, sigma1_neon(w4), K_neon(256), sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1996064986), Inc4_neon(&w7, sigma1_neon(w5), w0, K_neon(285220864))));
+        w8 = Add3_neon(K_neon(-2147483648), sigma1_neon(w6), w1);
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1740746414), w8));
+        w9 = Add_neon(sigma1_neon(w7), w2);
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1473132947), w9));
+        w10 = Add_neon(sigma1_neon(w8), w3);
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1341970488), w10));
+        w11 = Add_neon(sigma1_neon(w9), w4);
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1084653625), w11));
+        w12 = Add_neon(sigma1_neon(w10), w5);
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-958395405), w12));
+        w13 = Add_neon(sigma1_neon(w11), w6);
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-710438585), w13));
+        w14 = Add3_neon(sigma1_neon(w12), w7, K_neon(4194338));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(113926993), w14));
+        w15 = Add4_neon(K_neon(256), sigma1_neon(w13), w8, sigma0_neon(w0));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(338241895), w15));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(666307205), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(773529912), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(1294757372), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(1396182291), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(1695183700), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1986661051), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-2117940946), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1838011259), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1564481375), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1474664885), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1035236496), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-949202525), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-778901479), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-694614492), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-200395387), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(275423344), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(430227734), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(506948616), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(659060556), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(883997877), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(958139571), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1322822218), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1537002063), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1747873779), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1955562222), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(2024104815), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-2067236844), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1933114872), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-1866530822), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        /* The rounds which remain only move h into place as the last word
+         * of the state, so it is already final. */
+        if (top) return Add_neon(h, K_neon(1541459225));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-1538233109), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add5_neon(K_neon(-1090935817), w14, sigma1_neon(w12), w7, sigma0_neon(w15)));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add5_neon(K_neon(-965641998), w15, sigma1_neon(w13), w8, sigma0_neon(w0)));
+
+        /* Output */
+        Write4_neon(&out->u8[0], Add_neon(a, K_neon(1779033703)));
+        Write4_neon(&out->u8[4], Add_neon(b, K_neon(-1150833019)));
+        Write4_neon(&out->u8[8], Add_neon(c, K_neon(1013904242)));
+        Write4_neon(&out->u8[12], Add_neon(d, K_neon(-1521486534)));
+        Write4_neon(&out->u8[16], Add_neon(e, K_neon(1359893119)));
+        Write4_neon(&out->u8[20], Add_neon(f, K_neon(-1694144372)));
+        Write4_neon(&out->u8[24], Add_neon(g, K_neon(528734635)));
+        Write4_neon(&out->u8[28], Add_neon(h, K_neon(1541459225)));
+        return h;
+}
+
+/** The double SHA256 of 64-byte blocks, with top as for sha256d32_neon_4way(). */
+static inline __attribute__((always_inline)) uint32x4_t sha256d64_neon_4way(struct sha256 out[4], const struct sha256 in[8], int top)
+{
+        /* Transform 1 */
+        uint32x4_t a = K_neon(1779033703);
+        uint32x4_t b = K_neon(-1150833019);
+        uint32x4_t c = K_neon(1013904242);
+        uint32x4_t d = K_neon(-1521486534);
+        uint32x4_t e = K_neon(1359893119);
+        uint32x4_t f = K_neon(-1694144372);
+        uint32x4_t g = K_neon(528734635);
+        uint32x4_t h = K_neon(1541459225);
+
+        uint32x4_t w0 = Read4_neon(&in[0].u8[0]),
+                w1 = Read4_neon(&in[0].u8[4]),
+                w2 = Read4_neon(&in[0].u8[8]),
+                w3 = Read4_neon(&in[0].u8[12]),
+                w4 = Read4_neon(&in[0].u8[16]),
+                w5 = Read4_neon(&in[0].u8[20]),
+                w6 = Read4_neon(&in[0].u8[24]),
+                w7 = Read4_neon(&in[0].u8[28]),
+                w8 = Read4_neon(&in[1].u8[0]),
+                w9 = Read4_neon(&in[1].u8[4]),
+                w10 = Read4_neon(&in[1].u8[8]),
+                w11 = Read4_neon(&in[1].u8[12]),
+                w12 = Read4_neon(&in[1].u8[16]),
+                w13 = Read4_neon(&in[1].u8[20]),
+                w14 = Read4_neon(&in[1].u8[24]),
+                w15 = Read4_neon(&in[1].u8[28]);
+
+        uint32x4_t t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1116352408), w0));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(1899447441), w1));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1245643825), w2));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-373957723), w3));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(961987163), w4));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1508970993), w5));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1841331548), w6));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1424204075), w7));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-670586216), w8));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(310598401), w9));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(607225278), w10));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(1426881987), w11));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(1925078388), w12));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-2132889090), w13));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1680079193), w14));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1046744716), w15));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-459576895), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-272742522), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(264347078), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(604807628), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(770255983), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1249150122), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1555081692), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1996064986), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1740746414), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1473132947), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1341970488), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1084653625), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-958395405), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-710438585), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(113926993), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(338241895), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(666307205), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(773529912), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(1294757372), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(1396182291), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(1695183700), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1986661051), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-2117940946), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-1838011259), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(-1564481375), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(-1474664885), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-1035236496), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-949202525), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-778901479), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-694614492), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-200395387), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(275423344), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(430227734), Inc4_neon(&w0, sigma1_neon(w14), w9, sigma0_neon(w1))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(506948616), Inc4_neon(&w1, sigma1_neon(w15), w10, sigma0_neon(w2))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(659060556), Inc4_neon(&w2, sigma1_neon(w0), w11, sigma0_neon(w3))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(883997877), Inc4_neon(&w3, sigma1_neon(w1), w12, sigma0_neon(w4))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(958139571), Inc4_neon(&w4, sigma1_neon(w2), w13, sigma0_neon(w5))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(1322822218), Inc4_neon(&w5, sigma1_neon(w3), w14, sigma0_neon(w6))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(1537002063), Inc4_neon(&w6, sigma1_neon(w4), w15, sigma0_neon(w7))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(1747873779), Inc4_neon(&w7, sigma1_neon(w5), w0, sigma0_neon(w8))));
+        Round_neon(a, b, c, &d, e, f, g, &h, Add_neon(K_neon(1955562222), Inc4_neon(&w8, sigma1_neon(w6), w1, sigma0_neon(w9))));
+        Round_neon(h, a, b, &c, d, e, f, &g, Add_neon(K_neon(2024104815), Inc4_neon(&w9, sigma1_neon(w7), w2, sigma0_neon(w10))));
+        Round_neon(g, h, a, &b, c, d, e, &f, Add_neon(K_neon(-2067236844), Inc4_neon(&w10, sigma1_neon(w8), w3, sigma0_neon(w11))));
+        Round_neon(f, g, h, &a, b, c, d, &e, Add_neon(K_neon(-1933114872), Inc4_neon(&w11, sigma1_neon(w9), w4, sigma0_neon(w12))));
+        Round_neon(e, f, g, &h, a, b, c, &d, Add_neon(K_neon(-1866530822), Inc4_neon(&w12, sigma1_neon(w10), w5, sigma0_neon(w13))));
+        Round_neon(d, e, f, &g, h, a, b, &c, Add_neon(K_neon(-1538233109), Inc4_neon(&w13, sigma1_neon(w11), w6, sigma0_neon(w14))));
+        Round_neon(c, d, e, &f, g, h, a, &b, Add_neon(K_neon(-1090935817), Inc4_neon(&w14, sigma1_neon(w12), w7, sigma0_neon(w15))));
+        Round_neon(b, c, d, &e, f, g, h, &a, Add_neon(K_neon(-965641998), Inc4_neon(&w15, sigma1_neon(w13), w8, sigma0_neon(w0))));
+
+        t0 = a = Add_neon(a, K_neon(1779033703));
+        t1 = b = Add_neon(b, K_neon(-1150833019));
+        t2 = c = Add_neon(c, K_neon(1013904242));
+        t3 = d = Add_neon(d, K_neon(-1521486534));
+        t4 = e = Add_neon(e, K_neon(1359893119));
+        t5 = f = Add_neon(f, K_neon(-1694144372));
+        t6 = g = Add_neon(g, K_neon(528734635));
+        t7 = h = Add_neon(h, K_neon(1541459225));
+
+        /* Transform 2 */
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(-1031131240));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(1899447441));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(-1245643825));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(-373957723));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(961987163));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(1508970993));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-1841331548));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-1424204075));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(-670586216));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(310598401));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(607225278));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(1426881987));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(1925078388));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(-2132889090));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-1680079193));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-1046744204));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(1687906753));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(-251771002));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(266464710));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(604828244));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(1340683375));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(1825146046));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(1639530782));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(385452282));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(-221884078));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(-1467065747));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(-1340474267));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(-1176920377));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(-1710083645));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(-418452832));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-38722773));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-952811856));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(812235477));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(-879268513));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(1510936975));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(-601952515));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(171292297));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(-569673212));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(1492437661));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-513975530));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(8339078));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(923306368));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(-1526207950));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(1873515831));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(390095120));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(227333873));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-844481683));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(-1061437897));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(-2090779686));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(-615996573));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(184740145));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(1875991719));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(1377499850));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(825459761));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(1859394197));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(1833138320));
+        Round_neon(a, b, c, &d, e, f, g, &h, K_neon(-1013149198));
+        Round_neon(h, a, b, &c, d, e, f, &g, K_neon(-1630753859));
+        Round_neon(g, h, a, &b, c, d, e, &f, K_neon(-1245077274));
+        Round_neon(f, g, h, &a, b, c, d, &e, K_neon(1395635772));
+        Round_neon(e, f, g, &h, a, b, c, &d, K_neon(-758693434));
+        Round_neon(d, e, f, &g, h, a, b, &c, K_neon(119766691));
+        Round_neon(c, d, e, &f, g, h, a, &b, K_neon(-1533719704));
+        Round_neon(b, c, d, &e, f, g, h, &a, K_neon(1276714358));
+
+        w0 = Add_neon(t0, a);
+        w1 = Add_neon(t1, b);
+        w2 = Add_neon(t2, c);
+        w3 = Add_neon(t3, d);
+        w4 = Add_neon(t4, e);
+        w5 = Add_neon(t5, f);
+        w6 = Add_neon(t6, g);
+        w7 = Add_neon(t7, h);
+
+        return sha256d32_neon_4way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d64_neon_4way(struct sha256 out[4], const struct sha256 in[8])
+{
+        sha256d64_neon_4way(out, in, 0);
+}
+
+/* The lanes whose hash, read as a little-endian number as by Bitcoin, has a
+ * most significant word no greater than target[i] for message i.  The
+ * comparison sets every bit of the lanes which pass, and each keeps only its
+ * own bit of the mask before they are summed. */
+uint32_t transform_sha256d64below_neon_4way(const struct sha256 in[8], const uint32_t target[4])
+{
+        static const uint32_t BITS[4] = {1, 2, 4, 8};
+        uint32x4_t h = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(sha256d64_neon_4way(NULL, in, !0))));
+        return vaddvq_u32(vandq_u32(vcleq_u32(h, vld1q_u32(target)), vld1q_u32(BITS)));
+}
+
+#else
+/* -Wempty-translation-unit
+ * ISO C requires a translation unit to contain at least one declaration
+ */
+typedef int neon_make_iso_compilers_happy;
+#endif
+
+/* End of File
+ */
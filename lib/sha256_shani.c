@@ -187,6 +187,292 @@ void transform_sha256_shani(uint32_t* s, const unsigned char* chunk, size_t bloc
         memcpy(s + 4, &m, sizeof(m));
 }
 
+void transform_sha256multi_shani_2way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        __m128i am0, am1, am2, am3, as0, as1;
+        __m128i bm0, bm1, bm2, bm3, bs0, bs1;
+        __m128i so0, so1, m;
+
+        /* Load midstate (see transform_sha256_shani about the copying) */
+        memcpy(&m, s, sizeof(m));
+        so0 = _mm_loadu_si128(&m);
+        memcpy(&m, s + 4, sizeof(m));
+        so1 = _mm_loadu_si128(&m);
+        Shuffle(&so0, &so1);
+        as0 = bs0 = so0;
+        as1 = bs1 = so1;
+
+        /* Load data and transform */
+        am0 = Load(in + 0);
+        bm0 = Load(in + 64);
+        QuadRound2(&as0, &as1, am0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&bs0, &bs1, bm0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        am1 = Load(in + 16);
+        bm1 = Load(in + 80);
+        QuadRound2(&as0, &as1, am1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        QuadRound2(&bs0, &bs1, bm1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        ShiftMessageA(&am0, am1);
+        ShiftMessageA(&bm0, bm1);
+        am2 = Load(in + 32);
+        bm2 = Load(in + 96);
+        QuadRound2(&as0, &as1, am2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        QuadRound2(&bs0, &bs1, bm2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        ShiftMessageA(&am1, am2);
+        ShiftMessageA(&bm1, bm2);
+        am3 = Load(in + 48);
+        bm3 = Load(in + 112);
+        QuadRound2(&as0, &as1, am3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        QuadRound2(&bs0, &bs1, bm3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        QuadRound2(&bs0, &bs1, bm1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        ShiftMessageC(&am0, am1, &am2);
+        ShiftMessageC(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        QuadRound2(&bs0, &bs1, bm2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        ShiftMessageC(&am1, am2, &am3);
+        ShiftMessageC(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+        QuadRound2(&bs0, &bs1, bm3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+
+        /* Combine with midstate */
+        as0 = _mm_add_epi32(as0, so0);
+        as1 = _mm_add_epi32(as1, so1);
+        bs0 = _mm_add_epi32(bs0, so0);
+        bs1 = _mm_add_epi32(bs1, so1);
+
+        /* Extract hash into out */
+        Unshuffle(&as0, &as1);
+        Unshuffle(&bs0, &bs1);
+        Save(&out[0].u8[0], as0);
+        Save(&out[0].u8[16], as1);
+        Save(&out[1].u8[0], bs0);
+        Save(&out[1].u8[16], bs1);
+}
+
+void transform_sha256multi_shani_4way(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        __m128i am0, am1, am2, am3, as0, as1;
+        __m128i bm0, bm1, bm2, bm3, bs0, bs1;
+        __m128i cm0, cm1, cm2, cm3, cs0, cs1;
+        __m128i dm0, dm1, dm2, dm3, ds0, ds1;
+        __m128i so0, so1, m;
+
+        /* Load midstate (see transform_sha256_shani about the copying) */
+        memcpy(&m, s, sizeof(m));
+        so0 = _mm_loadu_si128(&m);
+        memcpy(&m, s + 4, sizeof(m));
+        so1 = _mm_loadu_si128(&m);
+        Shuffle(&so0, &so1);
+        as0 = bs0 = cs0 = ds0 = so0;
+        as1 = bs1 = cs1 = ds1 = so1;
+
+        /* Load data and transform */
+        am0 = Load(in + 0);
+        bm0 = Load(in + 64);
+        cm0 = Load(in + 128);
+        dm0 = Load(in + 192);
+        QuadRound2(&as0, &as1, am0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&bs0, &bs1, bm0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&cs0, &cs1, cm0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&ds0, &ds1, dm0, 0xe9b5dba5b5c0fbcfull, 0x71374491428a2f98ull);
+        am1 = Load(in + 16);
+        bm1 = Load(in + 80);
+        cm1 = Load(in + 144);
+        dm1 = Load(in + 208);
+        QuadRound2(&as0, &as1, am1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        QuadRound2(&bs0, &bs1, bm1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        QuadRound2(&cs0, &cs1, cm1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        QuadRound2(&ds0, &ds1, dm1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        ShiftMessageA(&am0, am1);
+        ShiftMessageA(&bm0, bm1);
+        ShiftMessageA(&cm0, cm1);
+        ShiftMessageA(&dm0, dm1);
+        am2 = Load(in + 32);
+        bm2 = Load(in + 96);
+        cm2 = Load(in + 160);
+        dm2 = Load(in + 224);
+        QuadRound2(&as0, &as1, am2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        QuadRound2(&bs0, &bs1, bm2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        QuadRound2(&cs0, &cs1, cm2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        QuadRound2(&ds0, &ds1, dm2, 0x550c7dc3243185beull, 0x12835b01d807aa98ull);
+        ShiftMessageA(&am1, am2);
+        ShiftMessageA(&bm1, bm2);
+        ShiftMessageA(&cm1, cm2);
+        ShiftMessageA(&dm1, dm2);
+        am3 = Load(in + 48);
+        bm3 = Load(in + 112);
+        cm3 = Load(in + 176);
+        dm3 = Load(in + 240);
+        QuadRound2(&as0, &as1, am3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        QuadRound2(&bs0, &bs1, bm3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        QuadRound2(&cs0, &cs1, cm3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        QuadRound2(&ds0, &ds1, dm3, 0xc19bf1749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        ShiftMessageB(&cm2, cm3, &cm0);
+        ShiftMessageB(&dm2, dm3, &dm0);
+        QuadRound2(&as0, &as1, am0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        QuadRound2(&cs0, &cs1, cm0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        QuadRound2(&ds0, &ds1, dm0, 0x240ca1cc0fc19dc6ull, 0xefbe4786E49b69c1ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        ShiftMessageB(&cm3, cm0, &cm1);
+        ShiftMessageB(&dm3, dm0, &dm1);
+        QuadRound2(&as0, &as1, am1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        QuadRound2(&bs0, &bs1, bm1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        QuadRound2(&cs0, &cs1, cm1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        QuadRound2(&ds0, &ds1, dm1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        ShiftMessageB(&cm0, cm1, &cm2);
+        ShiftMessageB(&dm0, dm1, &dm2);
+        QuadRound2(&as0, &as1, am2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        QuadRound2(&cs0, &cs1, cm2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        QuadRound2(&ds0, &ds1, dm2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        ShiftMessageB(&cm1, cm2, &cm3);
+        ShiftMessageB(&dm1, dm2, &dm3);
+        QuadRound2(&as0, &as1, am3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        QuadRound2(&cs0, &cs1, cm3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        QuadRound2(&ds0, &ds1, dm3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        ShiftMessageB(&cm2, cm3, &cm0);
+        ShiftMessageB(&dm2, dm3, &dm0);
+        QuadRound2(&as0, &as1, am0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        QuadRound2(&cs0, &cs1, cm0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        QuadRound2(&ds0, &ds1, dm0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        ShiftMessageB(&cm3, cm0, &cm1);
+        ShiftMessageB(&dm3, dm0, &dm1);
+        QuadRound2(&as0, &as1, am1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        QuadRound2(&cs0, &cs1, cm1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        QuadRound2(&ds0, &ds1, dm1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        ShiftMessageB(&cm0, cm1, &cm2);
+        ShiftMessageB(&dm0, dm1, &dm2);
+        QuadRound2(&as0, &as1, am2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        QuadRound2(&cs0, &cs1, cm2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        QuadRound2(&ds0, &ds1, dm2, 0xc76c51A3c24b8b70ull, 0xa81a664ba2bfe8a1ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        ShiftMessageB(&cm1, cm2, &cm3);
+        ShiftMessageB(&dm1, dm2, &dm3);
+        QuadRound2(&as0, &as1, am3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        QuadRound2(&cs0, &cs1, cm3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        QuadRound2(&ds0, &ds1, dm3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        ShiftMessageB(&cm2, cm3, &cm0);
+        ShiftMessageB(&dm2, dm3, &dm0);
+        QuadRound2(&as0, &as1, am0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        QuadRound2(&cs0, &cs1, cm0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        QuadRound2(&ds0, &ds1, dm0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        ShiftMessageB(&cm3, cm0, &cm1);
+        ShiftMessageB(&dm3, dm0, &dm1);
+        QuadRound2(&as0, &as1, am1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        QuadRound2(&cs0, &cs1, cm1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        QuadRound2(&ds0, &ds1, dm1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        ShiftMessageC(&am0, am1, &am2);
+        ShiftMessageC(&bm0, bm1, &bm2);
+        ShiftMessageC(&cm0, cm1, &cm2);
+        ShiftMessageC(&dm0, dm1, &dm2);
+        QuadRound2(&as0, &as1, am2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        QuadRound2(&bs0, &bs1, bm2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        QuadRound2(&cs0, &cs1, cm2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        QuadRound2(&ds0, &ds1, dm2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        ShiftMessageC(&am1, am2, &am3);
+        ShiftMessageC(&bm1, bm2, &bm3);
+        ShiftMessageC(&cm1, cm2, &cm3);
+        ShiftMessageC(&dm1, dm2, &dm3);
+        QuadRound2(&as0, &as1, am3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+        QuadRound2(&bs0, &bs1, bm3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+        QuadRound2(&cs0, &cs1, cm3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+        QuadRound2(&ds0, &ds1, dm3, 0xc67178f2bef9A3f7ull, 0xa4506ceb90befffaull);
+
+        /* Combine with midstate */
+        as0 = _mm_add_epi32(as0, so0);
+        as1 = _mm_add_epi32(as1, so1);
+        bs0 = _mm_add_epi32(bs0, so0);
+        bs1 = _mm_add_epi32(bs1, so1);
+        cs0 = _mm_add_epi32(cs0, so0);
+        cs1 = _mm_add_epi32(cs1, so1);
+        ds0 = _mm_add_epi32(ds0, so0);
+        ds1 = _mm_add_epi32(ds1, so1);
+
+        /* Extract hash into out */
+        Unshuffle(&as0, &as1);
+        Unshuffle(&bs0, &bs1);
+        Unshuffle(&cs0, &cs1);
+        Unshuffle(&ds0, &ds1);
+        Save(&out[0].u8[0], as0);
+        Save(&out[0].u8[16], as1);
+        Save(&out[1].u8[0], bs0);
+        Save(&out[1].u8[16], bs1);
+        Save(&out[2].u8[0], cs0);
+        Save(&out[2].u8[16], cs1);
+        Save(&out[3].u8[0], ds0);
+        Save(&out[3].u8[16], ds1);
+}
+
+/* There is deliberately no kernel which interleaves these two SHA-NI lanes
+ * with vector lanes.  Kept to xmm registers, so that the legacy-encoded SHA-NI
+ * instructions pay no SSE/AVX transition penalty, two SHA-NI lanes with four
+ * SSE4.1 lanes ran at 1.8M double64 hashes/s on an Intel core with SHA-NI,
+ * against 7.2M/s for this kernel alone: the time of the two streams added up,
+ * with no overlap for any lane ratio to exploit. */
 void transform_sha256d64_shani_2way(struct sha256 out[2], const struct sha256 in[4])
 {
         __m128i am0, am1, am2, am3, as0, as1, aso0, aso1;
@@ -397,6 +683,116 @@ void transform_sha256d64_shani_2way(struct sha256 out[2], const struct sha256 in
         Save(&out[1].u8[16], bs1);
 }
 
+/** Compress two 32-byte messages, held as words in m[0..1] and m[2..3], from
+ * the shuffled states in s[0..1] and s[2..3], and replace the messages with the
+ * resulting hashes.  This is transform 3 of the double-SHA256 kernel above,
+ * with the message length changed to the 96 bytes of an HMAC's inner or outer
+ * hash of a 32-byte message. */
+static inline __attribute__((always_inline)) void Hmac32_shani_2way(__m128i* m, const __m128i* s)
+{
+        __m128i am0 = m[0], am1 = m[1], am2, am3, as0 = s[0], as1 = s[1];
+        __m128i bm0 = m[2], bm1 = m[3], bm2, bm3, bs0 = s[2], bs1 = s[3];
+
+        QuadRound2(&as0, &as1, am0, 0xe9b5dba5B5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&bs0, &bs1, bm0, 0xe9b5dba5B5c0fbcfull, 0x71374491428a2f98ull);
+        QuadRound2(&as0, &as1, am1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        QuadRound2(&bs0, &bs1, bm1, 0xab1c5ed5923f82a4ull, 0x59f111f13956c25bull);
+        ShiftMessageA(&am0, am1);
+        ShiftMessageA(&bm0, bm1);
+        bm2 = am2 = _mm_set_epi64x(0x0ull, 0x80000000ull);
+        QuadRound(&as0, &as1, 0x550c7dc3243185beull, 0x12835b015807aa98ull);
+        QuadRound(&bs0, &bs1, 0x550c7dc3243185beull, 0x12835b015807aa98ull);
+        ShiftMessageA(&am1, am2);
+        ShiftMessageA(&bm1, bm2);
+        bm3 = am3 = _mm_set_epi64x(0x30000000000ull, 0x0ull);
+        QuadRound(&as0, &as1, 0xc19bf4749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        QuadRound(&bs0, &bs1, 0xc19bf4749bdc06a7ull, 0x80deb1fe72be5d74ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x240ca1cc0fc19dc6ull, 0xefbe4786e49b69c1ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x240ca1cc0fc19dc6ull, 0xefbe4786e49b69c1ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        QuadRound2(&bs0, &bs1, bm1, 0x76f988da5cb0a9dcull, 0x4a7484aa2de92c6full);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xbf597fc7b00327c8ull, 0xa831c66d983e5152ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x1429296706ca6351ull, 0xd5a79147c6e00bf3ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x53380d134d2c6dfcull, 0x2e1b213827b70a85ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x92722c8581c2c92eull, 0x766a0abb650a7354ull);
+        ShiftMessageB(&am0, am1, &am2);
+        ShiftMessageB(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0xc76c51a3c24b8b70ull, 0xa81a664ba2bfe8A1ull);
+        QuadRound2(&bs0, &bs1, bm2, 0xc76c51a3c24b8b70ull, 0xa81a664ba2bfe8A1ull);
+        ShiftMessageB(&am1, am2, &am3);
+        ShiftMessageB(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        QuadRound2(&bs0, &bs1, bm3, 0x106aa070f40e3585ull, 0xd6990624d192e819ull);
+        ShiftMessageB(&am2, am3, &am0);
+        ShiftMessageB(&bm2, bm3, &bm0);
+        QuadRound2(&as0, &as1, am0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        QuadRound2(&bs0, &bs1, bm0, 0x34b0bcb52748774cull, 0x1e376c0819a4c116ull);
+        ShiftMessageB(&am3, am0, &am1);
+        ShiftMessageB(&bm3, bm0, &bm1);
+        QuadRound2(&as0, &as1, am1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        QuadRound2(&bs0, &bs1, bm1, 0x682e6ff35b9cca4full, 0x4ed8aa4a391c0cb3ull);
+        ShiftMessageC(&am0, am1, &am2);
+        ShiftMessageC(&bm0, bm1, &bm2);
+        QuadRound2(&as0, &as1, am2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        QuadRound2(&bs0, &bs1, bm2, 0x8cc7020884c87814ull, 0x78a5636f748f82eeull);
+        ShiftMessageC(&am1, am2, &am3);
+        ShiftMessageC(&bm1, bm2, &bm3);
+        QuadRound2(&as0, &as1, am3, 0xc67178f2bef9a3f7ull, 0xa4506ceb90befffaull);
+        QuadRound2(&bs0, &bs1, bm3, 0xc67178f2bef9a3f7ull, 0xa4506ceb90befffaull);
+        as0 = _mm_add_epi32(as0, s[0]);
+        as1 = _mm_add_epi32(as1, s[1]);
+        bs0 = _mm_add_epi32(bs0, s[2]);
+        bs1 = _mm_add_epi32(bs1, s[3]);
+        Unshuffle(&as0, &as1);
+        Unshuffle(&bs0, &bs1);
+        m[0] = as0;
+        m[1] = as1;
+        m[2] = bs0;
+        m[3] = bs1;
+}
+
+void transform_sha256pbkdf2_shani_2way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        __m128i si[4], so[4], w[4], x[4];
+        int i;
+
+        /* See the comment in transform_sha256_shani about the use of memcpy
+         * for unaligned vector access. */
+        memcpy(si, inner, sizeof(si));
+        memcpy(so, outer, sizeof(so));
+        memcpy(w, u, sizeof(w));
+        memcpy(x, f, sizeof(x));
+        Shuffle(&si[0], &si[1]);
+        Shuffle(&si[2], &si[3]);
+        Shuffle(&so[0], &so[1]);
+        Shuffle(&so[2], &so[3]);
+        for (; iterations; --iterations) {
+                Hmac32_shani_2way(w, si);
+                Hmac32_shani_2way(w, so);
+                for (i = 0; i < 4; ++i) {
+                        x[i] = _mm_xor_si128(x[i], w[i]);
+                }
+        }
+        memcpy(u, w, sizeof(w));
+        memcpy(f, x, sizeof(x));
+}
+
 #else
 /* -Wempty-translation-unit
  * ISO C requires a translation unit to contain at least one declaration
@@ -12,6 +12,7 @@
 #include "sha256_internal.h"
 
 #include <stdint.h> /* for uint32_t */
+#include <string.h> /* for memcpy */
 #include <immintrin.h> /* for assembly intrinsics */
 
 #include "common.h"
@@ -185,7 +186,113 @@ void transform_sha256multi_sse41_4way(struct sha256* out, const uint32_t* s, con
         Write4_sse41(&out->u8[28], Add_sse41(h, K_sse41(s[7])));
 }
 
-void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in[8])
+/** The SHA256 of 32-byte messages, whose words are w0 to w7, as the second
+ * hash of a double SHA256.  With top set, only the last word of each hash is
+ * computed, and it is returned without writing out. */
+static inline __attribute__((always_inline)) __m128i sha256d32_sse41_4way(struct sha256 out[4], __m128i w0, __m128i w1, __m128i w2, __m128i w3, __m128i w4, __m128i w5, __m128i w6, __m128i w7, int top)
+{
+        __m128i a, b, c, d, e, f, g, h;
+        __m128i w8, w9, w10, w11, w12, w13, w14, w15;
+
+        a = K_sse41(1779033703);
+        b = K_sse41(-1150833019);
+        c = K_sse41(1013904242);
+        d = K_sse41(-1521486534);
+        e = K_sse41(1359893119);
+        f = K_sse41(-1694144372);
+        g = K_sse41(528734635);
+        h = K_sse41(1541459225);
+
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(961987163), w4));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1508970993), w5));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1841331548), w6));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1424204075), w7));
+        Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(1476897432));
+        Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(310598401));
+        Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(607225278));
+        Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(1426881987));
+        Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(1925078388));
+        Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(-2132889090));
+        Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(-1680079193));
+        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1046744460));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc_sse41(&w0, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc3_sse41(&w1, K_sse41(10485760), sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc3_sse41(&w2, sigma1_sse41(w0), sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc3_sse41(&w3, sigma1_sse41(w1), sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc3_sse41(&w4, sigma1_sse41(w2), sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc3_sse41(&w5, sigma1_sse41(w3), sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), K_sse41(256), sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, K_sse41(285220864))));
+        w8 = Add3_sse41(K_sse41(-2147483648), sigma1_sse41(w6), w1);
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), w8));
+        w9 = Add_sse41(sigma1_sse41(w7), w2);
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), w9));
+        w10 = Add_sse41(sigma1_sse41(w8), w3);
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), w10));
+        w11 = Add_sse41(sigma1_sse41(w9), w4);
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), w11));
+        w12 = Add_sse41(sigma1_sse41(w10), w5);
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), w12));
+        w13 = Add_sse41(sigma1_sse41(w11), w6);
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), w13));
+        w14 = Add3_sse41(sigma1_sse41(w12), w7, K_sse41(4194338));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), w14));
+        w15 = Add4_sse41(K_sse41(256), sigma1_sse41(w13), w8, sigma0_sse41(w0));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), w15));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        /* The rounds which remain only move h into place as the last word
+         * of the state, so it is already final. */
+        if (top) return Add_sse41(h, K_sse41(1541459225));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-1538233109), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add5_sse41(K_sse41(-1090935817), w14, sigma1_sse41(w12), w7, sigma0_sse41(w15)));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add5_sse41(K_sse41(-965641998), w15, sigma1_sse41(w13), w8, sigma0_sse41(w0)));
+
+        /* Output */
+        Write4_sse41(&out->u8[0], Add_sse41(a, K_sse41(1779033703)));
+        Write4_sse41(&out->u8[4], Add_sse41(b, K_sse41(-1150833019)));
+        Write4_sse41(&out->u8[8], Add_sse41(c, K_sse41(1013904242)));
+        Write4_sse41(&out->u8[12], Add_sse41(d, K_sse41(-1521486534)));
+        Write4_sse41(&out->u8[16], Add_sse41(e, K_sse41(1359893119)));
+        Write4_sse41(&out->u8[20], Add_sse41(f, K_sse41(-1694144372)));
+        Write4_sse41(&out->u8[24], Add_sse41(g, K_sse41(528734635)));
+        Write4_sse41(&out->u8[28], Add_sse41(h, K_sse41(1541459225)));
+        return h;
+}
+
+/** The double SHA256 of 64-byte blocks, with top as for sha256d32_sse41_4way(). */
+static inline __attribute__((always_inline)) __m128i sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in[8], int top)
 {
         /* Transform 1 */
         __m128i a = K_sse41(1779033703);
@@ -365,15 +472,422 @@ void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in
         w6 = Add_sse41(t6, g);
         w7 = Add_sse41(t7, h);
 
-        /* Transform 3 */
-        a = K_sse41(1779033703);
-        b = K_sse41(-1150833019);
-        c = K_sse41(1013904242);
-        d = K_sse41(-1521486534);
-        e = K_sse41(1359893119);
-        f = K_sse41(-1694144372);
-        g = K_sse41(528734635);
-        h = K_sse41(1541459225);
+        return sha256d32_sse41_4way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in[8])
+{
+        sha256d64_sse41_4way(out, in, 0);
+}
+
+/* Read4_sse41(), for blocks at the 80-byte stride of block headers. */
+static inline __attribute__((always_inline)) __m128i ReadHeader4_sse41(const unsigned char* chunk) {
+        return _mm_shuffle_epi8(
+                _mm_set_epi32(
+                        ReadLE32(chunk + 0),
+                        ReadLE32(chunk + 80),
+                        ReadLE32(chunk + 160),
+                        ReadLE32(chunk + 240)),
+                _mm_set_epi32(202182159, 134810123, 67438087, 66051));
+}
+
+/** The double SHA256 of block headers, or only the last word of each hash as
+ * for sha256d64_sse41_4way(). */
+static inline __attribute__((always_inline)) __m128i sha256d80_sse41_4way(struct sha256 out[4], const unsigned char in[320], int top)
+{
+        /* Transform 1 */
+        __m128i a = K_sse41(1779033703);
+        __m128i b = K_sse41(-1150833019);
+        __m128i c = K_sse41(1013904242);
+        __m128i d = K_sse41(-1521486534);
+        __m128i e = K_sse41(1359893119);
+        __m128i f = K_sse41(-1694144372);
+        __m128i g = K_sse41(528734635);
+        __m128i h = K_sse41(1541459225);
+
+        __m128i w0 = ReadHeader4_sse41(&in[0]),
+                w1 = ReadHeader4_sse41(&in[4]),
+                w2 = ReadHeader4_sse41(&in[8]),
+                w3 = ReadHeader4_sse41(&in[12]),
+                w4 = ReadHeader4_sse41(&in[16]),
+                w5 = ReadHeader4_sse41(&in[20]),
+                w6 = ReadHeader4_sse41(&in[24]),
+                w7 = ReadHeader4_sse41(&in[28]),
+                w8 = ReadHeader4_sse41(&in[32]),
+                w9 = ReadHeader4_sse41(&in[36]),
+                w10 = ReadHeader4_sse41(&in[40]),
+                w11 = ReadHeader4_sse41(&in[44]),
+                w12 = ReadHeader4_sse41(&in[48]),
+                w13 = ReadHeader4_sse41(&in[52]),
+                w14 = ReadHeader4_sse41(&in[56]),
+                w15 = ReadHeader4_sse41(&in[60]);
+
+        __m128i t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(961987163), w4));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1508970993), w5));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1841331548), w6));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1424204075), w7));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-670586216), w8));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(310598401), w9));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(607225278), w10));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1426881987), w11));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1925078388), w12));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-2132889090), w13));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1680079193), w14));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1046744716), w15));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-1538233109), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1090935817), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-965641998), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+
+        t0 = a = Add_sse41(a, K_sse41(1779033703));
+        t1 = b = Add_sse41(b, K_sse41(-1150833019));
+        t2 = c = Add_sse41(c, K_sse41(1013904242));
+        t3 = d = Add_sse41(d, K_sse41(-1521486534));
+        t4 = e = Add_sse41(e, K_sse41(1359893119));
+        t5 = f = Add_sse41(f, K_sse41(-1694144372));
+        t6 = g = Add_sse41(g, K_sse41(528734635));
+        t7 = h = Add_sse41(h, K_sse41(1541459225));
+
+        /* Transform 2 */
+        w0 = ReadHeader4_sse41(&in[64]);
+        w1 = ReadHeader4_sse41(&in[68]);
+        w2 = ReadHeader4_sse41(&in[72]);
+        w3 = ReadHeader4_sse41(&in[76]);
+
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+        Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(-1185496485));
+        Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(1508970993));
+        Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(-1841331548));
+        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1424204075));
+        Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(-670586216));
+        Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(310598401));
+        Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(607225278));
+        Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(1426881987));
+        Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(1925078388));
+        Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(-2132889090));
+        Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(-1680079193));
+        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1046744076));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc_sse41(&w0, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc3_sse41(&w1, K_sse41(17825792), sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc3_sse41(&w2, sigma1_sse41(w0), sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc3_sse41(&w3, sigma1_sse41(w1), K_sse41(285220864))));
+        w4 = Add_sse41(K_sse41(-2147483648), sigma1_sse41(w2));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), w4));
+        w5 = sigma1_sse41(w3);
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), w5));
+        w6 = Add_sse41(sigma1_sse41(w4), K_sse41(640));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), w6));
+        w7 = Add_sse41(sigma1_sse41(w5), w0);
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), w7));
+        w8 = Add_sse41(sigma1_sse41(w6), w1);
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), w8));
+        w9 = Add_sse41(sigma1_sse41(w7), w2);
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), w9));
+        w10 = Add_sse41(sigma1_sse41(w8), w3);
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), w10));
+        w11 = Add_sse41(sigma1_sse41(w9), w4);
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), w11));
+        w12 = Add_sse41(sigma1_sse41(w10), w5);
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), w12));
+        w13 = Add_sse41(sigma1_sse41(w11), w6);
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), w13));
+        w14 = Add3_sse41(sigma1_sse41(w12), w7, K_sse41(10485845));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), w14));
+        w15 = Add4_sse41(K_sse41(640), sigma1_sse41(w13), w8, sigma0_sse41(w0));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), w15));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-1538233109), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1090935817), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-965641998), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+
+        w0 = Add_sse41(t0, a);
+        w1 = Add_sse41(t1, b);
+        w2 = Add_sse41(t2, c);
+        w3 = Add_sse41(t3, d);
+        w4 = Add_sse41(t4, e);
+        w5 = Add_sse41(t5, f);
+        w6 = Add_sse41(t6, g);
+        w7 = Add_sse41(t7, h);
+
+        return sha256d32_sse41_4way(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void transform_sha256d80_sse41_4way(struct sha256 out[4], const unsigned char in[320])
+{
+        sha256d80_sse41_4way(out, in, 0);
+}
+
+/* Read4_sse41(), for messages at the 32-byte stride of hashes. */
+static inline __attribute__((always_inline)) __m128i ReadHash4_sse41(const unsigned char* chunk) {
+        return _mm_shuffle_epi8(
+                _mm_set_epi32(
+                        ReadLE32(chunk + 0),
+                        ReadLE32(chunk + 32),
+                        ReadLE32(chunk + 64),
+                        ReadLE32(chunk + 96)),
+                _mm_set_epi32(202182159, 134810123, 67438087, 66051));
+}
+
+void transform_sha256d32_sse41_4way(struct sha256 out[4], const struct sha256 in[4])
+{
+        sha256d32_sse41_4way(out,
+                ReadHash4_sse41(&in->u8[0]),
+                ReadHash4_sse41(&in->u8[4]),
+                ReadHash4_sse41(&in->u8[8]),
+                ReadHash4_sse41(&in->u8[12]),
+                ReadHash4_sse41(&in->u8[16]),
+                ReadHash4_sse41(&in->u8[20]),
+                ReadHash4_sse41(&in->u8[24]),
+                ReadHash4_sse41(&in->u8[28]),
+                0);
+}
+
+static inline __attribute__((always_inline)) __m128i ReadLanes4_sse41(const unsigned char* const in[4], size_t offset)
+{
+        return _mm_shuffle_epi8(
+                _mm_setr_epi32(
+                        ReadLE32(in[0] + offset),
+                        ReadLE32(in[1] + offset),
+                        ReadLE32(in[2] + offset),
+                        ReadLE32(in[3] + offset)),
+                _mm_set_epi32(202182159, 134810123, 67438087, 66051));
+}
+
+void transform_sha256mb_sse41_4way(uint32_t* s, const unsigned char* const in[4], size_t blocks)
+{
+        __m128i a, b, c, d, e, f, g, h;
+        __m128i t0, t1, t2, t3, t4, t5, t6, t7;
+        __m128i w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
+        size_t offset = 0;
+
+        /* Load the transposed state.  See the comment in sha256_shani.c about
+         * the use of memcpy for unaligned vector access. */
+        memcpy(&a, s + 0, sizeof(a));
+        memcpy(&b, s + 4, sizeof(b));
+        memcpy(&c, s + 8, sizeof(c));
+        memcpy(&d, s + 12, sizeof(d));
+        memcpy(&e, s + 16, sizeof(e));
+        memcpy(&f, s + 20, sizeof(f));
+        memcpy(&g, s + 24, sizeof(g));
+        memcpy(&h, s + 28, sizeof(h));
+
+        for (; blocks; --blocks, offset += 64) {
+                t0 = a;
+                t1 = b;
+                t2 = c;
+                t3 = d;
+                t4 = e;
+                t5 = f;
+                t6 = g;
+                t7 = h;
+
+                w0 = ReadLanes4_sse41(in, offset + 0);
+                w1 = ReadLanes4_sse41(in, offset + 4);
+                w2 = ReadLanes4_sse41(in, offset + 8);
+                w3 = ReadLanes4_sse41(in, offset + 12);
+                w4 = ReadLanes4_sse41(in, offset + 16);
+                w5 = ReadLanes4_sse41(in, offset + 20);
+                w6 = ReadLanes4_sse41(in, offset + 24);
+                w7 = ReadLanes4_sse41(in, offset + 28);
+                w8 = ReadLanes4_sse41(in, offset + 32);
+                w9 = ReadLanes4_sse41(in, offset + 36);
+                w10 = ReadLanes4_sse41(in, offset + 40);
+                w11 = ReadLanes4_sse41(in, offset + 44);
+                w12 = ReadLanes4_sse41(in, offset + 48);
+                w13 = ReadLanes4_sse41(in, offset + 52);
+                w14 = ReadLanes4_sse41(in, offset + 56);
+                w15 = ReadLanes4_sse41(in, offset + 60);
+
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(961987163), w4));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1508970993), w5));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1841331548), w6));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1424204075), w7));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-670586216), w8));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(310598401), w9));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(607225278), w10));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1426881987), w11));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1925078388), w12));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-2132889090), w13));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1680079193), w14));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1046744716), w15));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-1538233109), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1090935817), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-965641998), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+
+                a = Add_sse41(a, t0);
+                b = Add_sse41(b, t1);
+                c = Add_sse41(c, t2);
+                d = Add_sse41(d, t3);
+                e = Add_sse41(e, t4);
+                f = Add_sse41(f, t5);
+                g = Add_sse41(g, t6);
+                h = Add_sse41(h, t7);
+        }
+
+        /* Store the transposed state. */
+        memcpy(s + 0, &a, sizeof(a));
+        memcpy(s + 4, &b, sizeof(b));
+        memcpy(s + 8, &c, sizeof(c));
+        memcpy(s + 12, &d, sizeof(d));
+        memcpy(s + 16, &e, sizeof(e));
+        memcpy(s + 20, &f, sizeof(f));
+        memcpy(s + 24, &g, sizeof(g));
+        memcpy(s + 28, &h, sizeof(h));
+}
+
+/** Load word i of each of the lanes of a lane-major state. */
+static inline __attribute__((always_inline)) __m128i Gather4_sse41(const uint32_t* s, int i)
+{
+        return _mm_setr_epi32(s[i], s[8 + i], s[16 + i], s[24 + i]);
+}
+
+/** Store word i of each lane into a lane-major state. */
+static inline __attribute__((always_inline)) void Scatter4_sse41(uint32_t* s, int i, __m128i v)
+{
+        uint32_t t[4];
+        int j;
+        memcpy(t, &v, sizeof(t));
+        for (j = 0; j < 4; ++j) {
+                s[8 * j + i] = t[j];
+        }
+}
+
+/** The 4-lane counterpart of Hmac32_avx2() in sha256_avx2.c. */
+static inline __attribute__((always_inline)) void Hmac32_sse41(__m128i* out, const __m128i* s, const __m128i* in)
+{
+        __m128i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        __m128i w0 = in[0], w1 = in[1], w2 = in[2], w3 = in[3], w4 = in[4], w5 = in[5], w6 = in[6], w7 = in[7];
+        __m128i w8, w9, w10, w11, w12, w13, w14, w15;
 
         Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
         Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
@@ -390,14 +904,14 @@ void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in
         Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(1925078388));
         Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(-2132889090));
         Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(-1680079193));
-        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1046744460));
+        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1046743948));
         Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc_sse41(&w0, sigma0_sse41(w1))));
-        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc3_sse41(&w1, K_sse41(10485760), sigma0_sse41(w2))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc3_sse41(&w1, K_sse41(31457280), sigma0_sse41(w2))));
         Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc3_sse41(&w2, sigma1_sse41(w0), sigma0_sse41(w3))));
         Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc3_sse41(&w3, sigma1_sse41(w1), sigma0_sse41(w4))));
         Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc3_sse41(&w4, sigma1_sse41(w2), sigma0_sse41(w5))));
         Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc3_sse41(&w5, sigma1_sse41(w3), sigma0_sse41(w6))));
-        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), K_sse41(256), sigma0_sse41(w7))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), K_sse41(768), sigma0_sse41(w7))));
         Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, K_sse41(285220864))));
         w8 = Add3_sse41(K_sse41(-2147483648), sigma1_sse41(w6), w1);
         Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), w8));
@@ -411,9 +925,9 @@ void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in
         Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), w12));
         w13 = Add_sse41(sigma1_sse41(w11), w6);
         Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), w13));
-        w14 = Add3_sse41(sigma1_sse41(w12), w7, K_sse41(4194338));
+        w14 = Add3_sse41(sigma1_sse41(w12), w7, K_sse41(12583014));
         Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), w14));
-        w15 = Add4_sse41(K_sse41(256), sigma1_sse41(w13), w8, sigma0_sse41(w0));
+        w15 = Add4_sse41(K_sse41(768), sigma1_sse41(w13), w8, sigma0_sse41(w0));
         Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), w15));
         Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
         Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
@@ -448,15 +962,441 @@ void transform_sha256d64_sse41_4way(struct sha256 out[4], const struct sha256 in
         Round_sse41(c, d, e, &f, g, h, a, &b, Add5_sse41(K_sse41(-1090935817), w14, sigma1_sse41(w12), w7, sigma0_sse41(w15)));
         Round_sse41(b, c, d, &e, f, g, h, &a, Add5_sse41(K_sse41(-965641998), w15, sigma1_sse41(w13), w8, sigma0_sse41(w0)));
 
-        /* Output */
-        Write4_sse41(&out->u8[0], Add_sse41(a, K_sse41(1779033703)));
-        Write4_sse41(&out->u8[4], Add_sse41(b, K_sse41(-1150833019)));
-        Write4_sse41(&out->u8[8], Add_sse41(c, K_sse41(1013904242)));
-        Write4_sse41(&out->u8[12], Add_sse41(d, K_sse41(-1521486534)));
-        Write4_sse41(&out->u8[16], Add_sse41(e, K_sse41(1359893119)));
-        Write4_sse41(&out->u8[20], Add_sse41(f, K_sse41(-1694144372)));
-        Write4_sse41(&out->u8[24], Add_sse41(g, K_sse41(528734635)));
-        Write4_sse41(&out->u8[28], Add_sse41(h, K_sse41(1541459225)));
+        out[0] = Add_sse41(s[0], a);
+        out[1] = Add_sse41(s[1], b);
+        out[2] = Add_sse41(s[2], c);
+        out[3] = Add_sse41(s[3], d);
+        out[4] = Add_sse41(s[4], e);
+        out[5] = Add_sse41(s[5], f);
+        out[6] = Add_sse41(s[6], g);
+        out[7] = Add_sse41(s[7], h);
+}
+
+void transform_sha256pbkdf2_sse41_4way(uint32_t* f, uint32_t* u, const uint32_t* inner, const uint32_t* outer, size_t iterations)
+{
+        __m128i si[8], so[8], w[8], x[8];
+        int i;
+
+        for (i = 0; i < 8; ++i) {
+                si[i] = Gather4_sse41(inner, i);
+                so[i] = Gather4_sse41(outer, i);
+                w[i] = Gather4_sse41(u, i);
+                x[i] = Gather4_sse41(f, i);
+        }
+        for (; iterations; --iterations) {
+                Hmac32_sse41(w, si, w);
+                Hmac32_sse41(w, so, w);
+                for (i = 0; i < 8; ++i) {
+                        x[i] = _mm_xor_si128(x[i], w[i]);
+                }
+        }
+        for (i = 0; i < 8; ++i) {
+                Scatter4_sse41(u, i, w[i]);
+                Scatter4_sse41(f, i, x[i]);
+        }
+}
+
+/** The lanes of v which are no greater than t, as unsigned numbers. */
+static inline __attribute__((always_inline)) uint32_t LessEqual4_sse41(__m128i v, __m128i t) {
+        return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_max_epu32(v, t), t)));
+}
+
+/* The lanes whose hash, read as a little-endian number as by Bitcoin, has a
+ * most significant word no greater than target[i] for message i.  A pshufb
+ * which reverses all sixteen bytes swaps the bytes of each word and puts
+ * message i in lane i in one go. */
+uint32_t transform_sha256d64below_sse41_4way(const struct sha256 in[8], const uint32_t target[4])
+{
+        return LessEqual4_sse41(_mm_shuffle_epi8(sha256d64_sse41_4way(NULL, in, !0), _mm_set_epi32(66051, 67438087, 134810123, 202182159)), _mm_loadu_si128((const __m128i*)target));
+}
+
+uint32_t transform_sha256d80below_sse41_4way(const unsigned char in[320], const uint32_t target[4])
+{
+        return LessEqual4_sse41(_mm_shuffle_epi8(sha256d80_sse41_4way(NULL, in, !0), _mm_set_epi32(66051, 67438087, 134810123, 202182159)), _mm_loadu_si128((const __m128i*)target));
+}
+
+uint32_t transform_sha256grind_sse41_4way(const struct sha256_grind* ctx, uint32_t nonce)
+{
+        const uint64_t dep = ctx->dep;
+        __m128i n = _mm_shuffle_epi8(Add_sse41(K_sse41(nonce), _mm_setr_epi32(0, 1, 2, 3)), _mm_set_epi32(202182159, 134810123, 67438087, 66051));
+        __m128i a = K_sse41(ctx->state[0]);
+        __m128i b = K_sse41(ctx->state[1]);
+        __m128i c = K_sse41(ctx->state[2]);
+        __m128i d = K_sse41(ctx->state[3]);
+        __m128i e = K_sse41(ctx->state[4]);
+        __m128i f = K_sse41(ctx->state[5]);
+        __m128i g = K_sse41(ctx->state[6]);
+        __m128i h = K_sse41(ctx->state[7]);
+
+        __m128i w0 = K_sse41(ctx->w[0]),
+                w1 = K_sse41(ctx->w[1]),
+                w2 = K_sse41(ctx->w[2]),
+                w3 = K_sse41(ctx->w[3]),
+                w4 = K_sse41(ctx->w[4]),
+                w5 = K_sse41(ctx->w[5]),
+                w6 = K_sse41(ctx->w[6]),
+                w7 = K_sse41(ctx->w[7]),
+                w8 = K_sse41(ctx->w[8]),
+                w9 = K_sse41(ctx->w[9]),
+                w10 = K_sse41(ctx->w[10]),
+                w11 = K_sse41(ctx->w[11]),
+                w12 = K_sse41(ctx->w[12]),
+                w13 = K_sse41(ctx->w[13]),
+                w14 = K_sse41(ctx->w[14]),
+                w15 = K_sse41(ctx->w[15]);
+
+        /* Enter at the round which first reads the nonce, with the
+         * state rotated to match. */
+        switch (ctx->word) {
+        case 0:
+                if ((dep >> 0) & 1) {
+                        w0 = n;
+                        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+                } else {
+                        Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(ctx->kw[0]));
+                }
+                /* FALLTHROUGH */
+        case 1:
+                if ((dep >> 1) & 1) {
+                        w1 = n;
+                        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+                } else {
+                        Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(ctx->kw[1]));
+                }
+                /* FALLTHROUGH */
+        case 2:
+                if ((dep >> 2) & 1) {
+                        w2 = n;
+                        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+                } else {
+                        Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(ctx->kw[2]));
+                }
+                /* FALLTHROUGH */
+        case 3:
+                if ((dep >> 3) & 1) {
+                        w3 = n;
+                        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+                } else {
+                        Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(ctx->kw[3]));
+                }
+                /* FALLTHROUGH */
+        case 4:
+                if ((dep >> 4) & 1) {
+                        w4 = n;
+                        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(961987163), w4));
+                } else {
+                        Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(ctx->kw[4]));
+                }
+                /* FALLTHROUGH */
+        case 5:
+                if ((dep >> 5) & 1) {
+                        w5 = n;
+                        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1508970993), w5));
+                } else {
+                        Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(ctx->kw[5]));
+                }
+                /* FALLTHROUGH */
+        case 6:
+                if ((dep >> 6) & 1) {
+                        w6 = n;
+                        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1841331548), w6));
+                } else {
+                        Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(ctx->kw[6]));
+                }
+                /* FALLTHROUGH */
+        case 7:
+                if ((dep >> 7) & 1) {
+                        w7 = n;
+                        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1424204075), w7));
+                } else {
+                        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(ctx->kw[7]));
+                }
+                /* FALLTHROUGH */
+        case 8:
+                if ((dep >> 8) & 1) {
+                        w8 = n;
+                        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-670586216), w8));
+                } else {
+                        Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(ctx->kw[8]));
+                }
+                /* FALLTHROUGH */
+        case 9:
+                if ((dep >> 9) & 1) {
+                        w9 = n;
+                        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(310598401), w9));
+                } else {
+                        Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(ctx->kw[9]));
+                }
+                /* FALLTHROUGH */
+        case 10:
+                if ((dep >> 10) & 1) {
+                        w10 = n;
+                        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(607225278), w10));
+                } else {
+                        Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(ctx->kw[10]));
+                }
+                /* FALLTHROUGH */
+        case 11:
+                if ((dep >> 11) & 1) {
+                        w11 = n;
+                        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1426881987), w11));
+                } else {
+                        Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(ctx->kw[11]));
+                }
+                /* FALLTHROUGH */
+        case 12:
+                if ((dep >> 12) & 1) {
+                        w12 = n;
+                        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1925078388), w12));
+                } else {
+                        Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(ctx->kw[12]));
+                }
+                /* FALLTHROUGH */
+        case 13:
+                if ((dep >> 13) & 1) {
+                        w13 = n;
+                        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-2132889090), w13));
+                } else {
+                        Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(ctx->kw[13]));
+                }
+                /* FALLTHROUGH */
+        case 14:
+                if ((dep >> 14) & 1) {
+                        w14 = n;
+                        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1680079193), w14));
+                } else {
+                        Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(ctx->kw[14]));
+                }
+                /* FALLTHROUGH */
+        case 15:
+                if ((dep >> 15) & 1) {
+                        w15 = n;
+                        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1046744716), w15));
+                } else {
+                        Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(ctx->kw[15]));
+                }
+        }
+        if ((dep >> 16) & 1) {
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        } else {
+                w0 = K_sse41(ctx->w[16]);
+                Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(ctx->kw[16]));
+        }
+        if ((dep >> 17) & 1) {
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        } else {
+                w1 = K_sse41(ctx->w[17]);
+                Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(ctx->kw[17]));
+        }
+        if ((dep >> 18) & 1) {
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        } else {
+                w2 = K_sse41(ctx->w[18]);
+                Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(ctx->kw[18]));
+        }
+        if ((dep >> 19) & 1) {
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        } else {
+                w3 = K_sse41(ctx->w[19]);
+                Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(ctx->kw[19]));
+        }
+        if ((dep >> 20) & 1) {
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        } else {
+                w4 = K_sse41(ctx->w[20]);
+                Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(ctx->kw[20]));
+        }
+        if ((dep >> 21) & 1) {
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        } else {
+                w5 = K_sse41(ctx->w[21]);
+                Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(ctx->kw[21]));
+        }
+        if ((dep >> 22) & 1) {
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        } else {
+                w6 = K_sse41(ctx->w[22]);
+                Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(ctx->kw[22]));
+        }
+        if ((dep >> 23) & 1) {
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        } else {
+                w7 = K_sse41(ctx->w[23]);
+                Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(ctx->kw[23]));
+        }
+        if ((dep >> 24) & 1) {
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        } else {
+                w8 = K_sse41(ctx->w[24]);
+                Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(ctx->kw[24]));
+        }
+        if ((dep >> 25) & 1) {
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        } else {
+                w9 = K_sse41(ctx->w[25]);
+                Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(ctx->kw[25]));
+        }
+        if ((dep >> 26) & 1) {
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        } else {
+                w10 = K_sse41(ctx->w[26]);
+                Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(ctx->kw[26]));
+        }
+        if ((dep >> 27) & 1) {
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        } else {
+                w11 = K_sse41(ctx->w[27]);
+                Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(ctx->kw[27]));
+        }
+        if ((dep >> 28) & 1) {
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        } else {
+                w12 = K_sse41(ctx->w[28]);
+                Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(ctx->kw[28]));
+        }
+        if ((dep >> 29) & 1) {
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        } else {
+                w13 = K_sse41(ctx->w[29]);
+                Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(ctx->kw[29]));
+        }
+        if ((dep >> 30) & 1) {
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        } else {
+                w14 = K_sse41(ctx->w[30]);
+                Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(ctx->kw[30]));
+        }
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+        Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+        Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+        Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+        Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+        Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+        Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+        Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+        Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+
+        if (ctx->twice) {
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-1538233109), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add5_sse41(K_sse41(-1090935817), w14, sigma1_sse41(w12), w7, sigma0_sse41(w15)));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add5_sse41(K_sse41(-965641998), w15, sigma1_sse41(w13), w8, sigma0_sse41(w0)));
+
+                w0 = Add_sse41(a, K_sse41(ctx->midstate[0]));
+                w1 = Add_sse41(b, K_sse41(ctx->midstate[1]));
+                w2 = Add_sse41(c, K_sse41(ctx->midstate[2]));
+                w3 = Add_sse41(d, K_sse41(ctx->midstate[3]));
+                w4 = Add_sse41(e, K_sse41(ctx->midstate[4]));
+                w5 = Add_sse41(f, K_sse41(ctx->midstate[5]));
+                w6 = Add_sse41(g, K_sse41(ctx->midstate[6]));
+                w7 = Add_sse41(h, K_sse41(ctx->midstate[7]));
+
+                a = K_sse41(1779033703);
+                b = K_sse41(-1150833019);
+                c = K_sse41(1013904242);
+                d = K_sse41(-1521486534);
+                e = K_sse41(1359893119);
+                f = K_sse41(-1694144372);
+                g = K_sse41(528734635);
+                h = K_sse41(1541459225);
+
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1116352408), w0));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(1899447441), w1));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1245643825), w2));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-373957723), w3));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(961987163), w4));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1508970993), w5));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-1841331548), w6));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1424204075), w7));
+                Round_sse41(a, b, c, &d, e, f, g, &h, K_sse41(1476897432));
+                Round_sse41(h, a, b, &c, d, e, f, &g, K_sse41(310598401));
+                Round_sse41(g, h, a, &b, c, d, e, &f, K_sse41(607225278));
+                Round_sse41(f, g, h, &a, b, c, d, &e, K_sse41(1426881987));
+                Round_sse41(e, f, g, &h, a, b, c, &d, K_sse41(1925078388));
+                Round_sse41(d, e, f, &g, h, a, b, &c, K_sse41(-2132889090));
+                Round_sse41(c, d, e, &f, g, h, a, &b, K_sse41(-1680079193));
+                Round_sse41(b, c, d, &e, f, g, h, &a, K_sse41(-1046744460));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-459576895), Inc_sse41(&w0, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-272742522), Inc3_sse41(&w1, K_sse41(10485760), sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(264347078), Inc3_sse41(&w2, sigma1_sse41(w0), sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(604807628), Inc3_sse41(&w3, sigma1_sse41(w1), sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(770255983), Inc3_sse41(&w4, sigma1_sse41(w2), sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1249150122), Inc3_sse41(&w5, sigma1_sse41(w3), sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1555081692), Inc4_sse41(&w6, sigma1_sse41(w4), K_sse41(256), sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1996064986), Inc4_sse41(&w7, sigma1_sse41(w5), w0, K_sse41(285220864))));
+                w8 = Add3_sse41(K_sse41(-2147483648), sigma1_sse41(w6), w1);
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1740746414), w8));
+                w9 = Add_sse41(sigma1_sse41(w7), w2);
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1473132947), w9));
+                w10 = Add_sse41(sigma1_sse41(w8), w3);
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1341970488), w10));
+                w11 = Add_sse41(sigma1_sse41(w9), w4);
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1084653625), w11));
+                w12 = Add_sse41(sigma1_sse41(w10), w5);
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-958395405), w12));
+                w13 = Add_sse41(sigma1_sse41(w11), w6);
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-710438585), w13));
+                w14 = Add3_sse41(sigma1_sse41(w12), w7, K_sse41(4194338));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(113926993), w14));
+                w15 = Add4_sse41(K_sse41(256), sigma1_sse41(w13), w8, sigma0_sse41(w0));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(338241895), w15));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(666307205), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(773529912), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(1294757372), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(1396182291), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(1695183700), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1986661051), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-2117940946), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(-1838011259), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(-1564481375), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(-1474664885), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-1035236496), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-949202525), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-778901479), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(-694614492), Inc4_sse41(&w13, sigma1_sse41(w11), w6, sigma0_sse41(w14))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(-200395387), Inc4_sse41(&w14, sigma1_sse41(w12), w7, sigma0_sse41(w15))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(275423344), Inc4_sse41(&w15, sigma1_sse41(w13), w8, sigma0_sse41(w0))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(430227734), Inc4_sse41(&w0, sigma1_sse41(w14), w9, sigma0_sse41(w1))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(506948616), Inc4_sse41(&w1, sigma1_sse41(w15), w10, sigma0_sse41(w2))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(659060556), Inc4_sse41(&w2, sigma1_sse41(w0), w11, sigma0_sse41(w3))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(883997877), Inc4_sse41(&w3, sigma1_sse41(w1), w12, sigma0_sse41(w4))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(958139571), Inc4_sse41(&w4, sigma1_sse41(w2), w13, sigma0_sse41(w5))));
+                Round_sse41(d, e, f, &g, h, a, b, &c, Add_sse41(K_sse41(1322822218), Inc4_sse41(&w5, sigma1_sse41(w3), w14, sigma0_sse41(w6))));
+                Round_sse41(c, d, e, &f, g, h, a, &b, Add_sse41(K_sse41(1537002063), Inc4_sse41(&w6, sigma1_sse41(w4), w15, sigma0_sse41(w7))));
+                Round_sse41(b, c, d, &e, f, g, h, &a, Add_sse41(K_sse41(1747873779), Inc4_sse41(&w7, sigma1_sse41(w5), w0, sigma0_sse41(w8))));
+                Round_sse41(a, b, c, &d, e, f, g, &h, Add_sse41(K_sse41(1955562222), Inc4_sse41(&w8, sigma1_sse41(w6), w1, sigma0_sse41(w9))));
+                Round_sse41(h, a, b, &c, d, e, f, &g, Add_sse41(K_sse41(2024104815), Inc4_sse41(&w9, sigma1_sse41(w7), w2, sigma0_sse41(w10))));
+                Round_sse41(g, h, a, &b, c, d, e, &f, Add_sse41(K_sse41(-2067236844), Inc4_sse41(&w10, sigma1_sse41(w8), w3, sigma0_sse41(w11))));
+                Round_sse41(f, g, h, &a, b, c, d, &e, Add_sse41(K_sse41(-1933114872), Inc4_sse41(&w11, sigma1_sse41(w9), w4, sigma0_sse41(w12))));
+                Round_sse41(e, f, g, &h, a, b, c, &d, Add_sse41(K_sse41(-1866530822), Inc4_sse41(&w12, sigma1_sse41(w10), w5, sigma0_sse41(w13))));
+                h = Add_sse41(h, K_sse41(1541459225));
+        } else {
+                h = Add_sse41(h, K_sse41(ctx->midstate[7]));
+        }
+
+        /* h is now the last word of the hash, whose bytes are the most
+         * significant when the hash is read as a little-endian number. */
+        return LessEqual4_sse41(_mm_shuffle_epi8(h, _mm_set_epi32(202182159, 134810123, 67438087, 66051)), K_sse41(ctx->target));
 }
 
 #else
@@ -0,0 +1,72 @@
+/* Copyright (c) 2018-2019 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* The multi-lane kernels of sha256_sse41.c and sha256_avx2.c, written once
+ * with the generic vector extension of GCC and Clang instead of intrinsics,
+ * for the targets which have SIMD but no kernels of their own, such as POWER
+ * (AltiVec and VSX), LoongArch (LSX), RISC-V (V), s390x and WebAssembly.  The
+ * kernels are in sha256_vec_impl.h, which is built here for 4 and for 8
+ * lanes.  Where the vector unit holds fewer than 8, the compiler splits each
+ * operation on the wider type.  It also chooses the instructions, so the
+ * kernels are only built where SHA256_VEC says that it has a vector unit to
+ * choose them from. */
+
+#include <sha2/sha256.h>
+#include "sha256_internal.h"
+
+#if defined(SHA256_VEC)
+
+#include <stdint.h> /* for uint32_t */
+
+#include "common.h"
+
+/* As in sha256_sse41.c, most of the following are macros rather than
+ * inlines, to keep the code compatible with C89.  They act on vectors of
+ * any lane count. */
+
+#define Add_vec(x, y) ((x) + (y))
+#define Add3_vec(x, y, z) Add_vec(Add_vec((x), (y)), (z))
+#define Add4_vec(x, y, z, w) Add_vec(Add_vec((x), (y)), Add_vec((z), (w)))
+#define Add5_vec(x, y, z, w, v) Add_vec(Add3_vec((x), (y), (z)), Add_vec((w), (v)))
+#define Xor_vec(x, y) ((x) ^ (y))
+#define Xor3_vec(x, y, z) Xor_vec(Xor_vec((x), (y)), (z))
+#define Or_vec(x, y) ((x) | (y))
+#define And_vec(x, y) ((x) & (y))
+#define ShR_vec(x, n) ((x) >> (n))
+#define ShL_vec(x, n) ((x) << (n))
+
+/* The helpers pass vectors by value, which GCC warns may change the ABI
+ * where they are wider than the vector registers, as the 8-lane ones are on
+ * SSE2.  They are always inlined, so there is no call to change. */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/* The name of the SHA256_VEC_LANES-way version of a kernel or helper, such
+ * as transform_sha256d64_vec_4way. */
+#define VEC_PASTE2(name, lanes) name##_##lanes##way
+#define VEC_PASTE(name, lanes) VEC_PASTE2(name, lanes)
+#define VEC_WAY(name) VEC_PASTE(name, SHA256_VEC_LANES)
+
+#define SHA256_VEC_LANES 4
+#include "sha256_vec_impl.h"
+#undef SHA256_VEC_LANES
+
+#define SHA256_VEC_LANES 8
+#include "sha256_vec_impl.h"
+#undef SHA256_VEC_LANES
+
+#else
+/* -Wempty-translation-unit
+ * ISO C requires a translation unit to contain at least one declaration
+ */
+typedef int vec_make_iso_compilers_happy;
+#endif
+
+/* End of File
+ */
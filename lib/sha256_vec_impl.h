@@ -0,0 +1,766 @@
+/* Copyright (c) 2018-2019 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/* The kernels of sha256_vec.c for SHA256_VEC_LANES lanes, which are named
+ * with VEC_WAY().  sha256_vec.c includes this file once for each lane count,
+ * so there is no include guard.  Message j is in lane j. */
+
+/* The helpers are static, and take the names of the lane count too. */
+#define vec_u32 VEC_WAY(vec_u32)
+#define K_vec VEC_WAY(K_vec)
+#define Inc_vec VEC_WAY(Inc_vec)
+#define Inc3_vec VEC_WAY(Inc3_vec)
+#define Inc4_vec VEC_WAY(Inc4_vec)
+#define Ch_vec VEC_WAY(Ch_vec)
+#define Maj_vec VEC_WAY(Maj_vec)
+#define Sigma0_vec VEC_WAY(Sigma0_vec)
+#define Sigma1_vec VEC_WAY(Sigma1_vec)
+#define sigma0_vec VEC_WAY(sigma0_vec)
+#define sigma1_vec VEC_WAY(sigma1_vec)
+#define Round_vec VEC_WAY(Round_vec)
+#define ReadStride_vec VEC_WAY(ReadStride_vec)
+#define Write_vec VEC_WAY(Write_vec)
+#define sha256d32_vec VEC_WAY(sha256d32_vec)
+#define sha256d64_vec VEC_WAY(sha256d64_vec)
+#define sha256d80_vec VEC_WAY(sha256d80_vec)
+#define LessEqual_vec VEC_WAY(LessEqual_vec)
+#define ByteSwap_vec VEC_WAY(ByteSwap_vec)
+
+/* SHA256_VEC_LANES 32-bit lanes.  Arithmetic and bitwise operators on the
+ * type act on each lane, and a shift by a scalar shifts every lane by it. */
+typedef uint32_t vec_u32 __attribute__((vector_size(4 * SHA256_VEC_LANES)));
+
+static inline __attribute__((always_inline)) vec_u32 K_vec(uint32_t x) {
+        vec_u32 v;
+        int j;
+        for (j = 0; j < SHA256_VEC_LANES; ++j) {
+                v[j] = x;
+        }
+        return v;
+}
+
+static inline __attribute__((always_inline)) vec_u32 Inc_vec(vec_u32 *x, vec_u32 y) { *x = Add_vec(*x, y); return *x; }
+static inline __attribute__((always_inline)) vec_u32 Inc3_vec(vec_u32 *x, vec_u32 y, vec_u32 z) { *x = Add3_vec(*x, y, z); return *x; }
+static inline __attribute__((always_inline)) vec_u32 Inc4_vec(vec_u32 *x, vec_u32 y, vec_u32 z, vec_u32 w) { *x = Add4_vec(*x, y, z, w); return *x; }
+
+/* The rotations are left as a pair of shifts for the compiler to match,
+ * since only some of the targets have a vector rotate. */
+static inline __attribute__((always_inline)) vec_u32 Ch_vec(vec_u32 x, vec_u32 y, vec_u32 z) { return Xor_vec(z, And_vec(x, Xor_vec(y, z))); }
+static inline __attribute__((always_inline)) vec_u32 Maj_vec(vec_u32 x, vec_u32 y, vec_u32 z) { return Or_vec(And_vec(x, y), And_vec(z, Or_vec(x, y))); }
+static inline __attribute__((always_inline)) vec_u32 Sigma0_vec(vec_u32 x) { return Xor3_vec(Or_vec(ShR_vec(x, 2), ShL_vec(x, 30)), Or_vec(ShR_vec(x, 13), ShL_vec(x, 19)), Or_vec(ShR_vec(x, 22), ShL_vec(x, 10))); }
+static inline __attribute__((always_inline)) vec_u32 Sigma1_vec(vec_u32 x) { return Xor3_vec(Or_vec(ShR_vec(x, 6), ShL_vec(x, 26)), Or_vec(ShR_vec(x, 11), ShL_vec(x, 21)), Or_vec(ShR_vec(x, 25), ShL_vec(x, 7))); }
+static inline __attribute__((always_inline)) vec_u32 sigma0_vec(vec_u32 x) { return Xor3_vec(Or_vec(ShR_vec(x, 7), ShL_vec(x, 25)), Or_vec(ShR_vec(x, 18), ShL_vec(x, 14)), ShR_vec(x, 3)); }
+static inline __attribute__((always_inline)) vec_u32 sigma1_vec(vec_u32 x) { return Xor3_vec(Or_vec(ShR_vec(x, 17), ShL_vec(x, 15)), Or_vec(ShR_vec(x, 19), ShL_vec(x, 13)), ShR_vec(x, 10)); }
+
+/** One round of SHA-256. */
+static inline __attribute__((always_inline)) void Round_vec(vec_u32 a, vec_u32 b, vec_u32 c, vec_u32 *d, vec_u32 e, vec_u32 f, vec_u32 g, vec_u32 *h, vec_u32 k)
+{
+        vec_u32 t1 = Add4_vec(*h, Sigma1_vec(e), Ch_vec(e, f, g), k);
+        vec_u32 t2 = Add_vec(Sigma0_vec(a), Maj_vec(a, b, c));
+        *d = Add_vec(*d, t1);
+        *h = Add_vec(t1, t2);
+}
+
+/** Word i of each message, at the given stride. */
+static inline __attribute__((always_inline)) vec_u32 ReadStride_vec(const unsigned char* chunk, size_t stride) {
+        vec_u32 v;
+        int j;
+        for (j = 0; j < SHA256_VEC_LANES; ++j) {
+                v[j] = ReadBE32(chunk + j * stride);
+        }
+        return v;
+}
+
+#define Read_vec(chunk) ReadStride_vec((chunk), 64)
+
+static inline __attribute__((always_inline)) void Write_vec(unsigned char *out, vec_u32 v) {
+        int j;
+        for (j = 0; j < SHA256_VEC_LANES; ++j) {
+                WriteBE32(out + 32 * j, v[j]);
+        }
+}
+
+void VEC_WAY(transform_sha256multi_vec)(struct sha256* out, const uint32_t* s, const unsigned char* in)
+{
+        /* Transform 1 */
+        vec_u32 a = K_vec(s[0]);
+        vec_u32 b = K_vec(s[1]);
+        vec_u32 c = K_vec(s[2]);
+        vec_u32 d = K_vec(s[3]);
+        vec_u32 e = K_vec(s[4]);
+        vec_u32 f = K_vec(s[5]);
+        vec_u32 g = K_vec(s[6]);
+        vec_u32 h = K_vec(s[7]);
+
+        vec_u32 w0 = Read_vec(in + 0),
+                w1 = Read_vec(in + 4),
+                w2 = Read_vec(in + 8),
+                w3 = Read_vec(in + 12),
+                w4 = Read_vec(in + 16),
+                w5 = Read_vec(in + 20),
+                w6 = Read_vec(in + 24),
+                w7 = Read_vec(in + 28),
+                w8 = Read_vec(in + 32),
+                w9 = Read_vec(in + 36),
+                w10 = Read_vec(in + 40),
+                w11 = Read_vec(in + 44),
+                w12 = Read_vec(in + 48),
+                w13 = Read_vec(in + 52),
+                w14 = Read_vec(in + 56),
+                w15 = Read_vec(in + 60);
+
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1116352408), w0));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(1899447441), w1));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1245643825), w2));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-373957723), w3));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(961987163), w4));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1508970993), w5));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1841331548), w6));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1424204075), w7));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-670586216), w8));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(310598401), w9));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(607225278), w10));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1426881987), w11));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1925078388), w12));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-2132889090), w13));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1680079193), w14));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1046744716), w15));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-459576895), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-272742522), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(264347078), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(604807628), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(770255983), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1249150122), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1555081692), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1996064986), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1740746414), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1473132947), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1341970488), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1084653625), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-958395405), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-710438585), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(113926993), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(338241895), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(666307205), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(773529912), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(1294757372), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1396182291), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1695183700), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1986661051), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-2117940946), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1838011259), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1564481375), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1474664885), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1035236496), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-949202525), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-778901479), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-694614492), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-200395387), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(275423344), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(430227734), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(506948616), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(659060556), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(883997877), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(958139571), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1322822218), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1537002063), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1747873779), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1955562222), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(2024104815), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-2067236844), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1933114872), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-1866530822), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-1538233109), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1090935817), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-965641998), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+
+        /* Output */
+        Write_vec(&out->u8[0], Add_vec(a, K_vec(s[0])));
+        Write_vec(&out->u8[4], Add_vec(b, K_vec(s[1])));
+        Write_vec(&out->u8[8], Add_vec(c, K_vec(s[2])));
+        Write_vec(&out->u8[12], Add_vec(d, K_vec(s[3])));
+        Write_vec(&out->u8[16], Add_vec(e, K_vec(s[4])));
+        Write_vec(&out->u8[20], Add_vec(f, K_vec(s[5])));
+        Write_vec(&out->u8[24], Add_vec(g, K_vec(s[6])));
+        Write_vec(&out->u8[28], Add_vec(h, K_vec(s[7])));
+}
+
+/** The SHA256 of 32-byte messages, whose words are w0 to w7, as the second
+ * hash of a double SHA256.  With top set, only the last word of each hash is
+ * computed, and it is returned without writing out. */
+static inline __attribute__((always_inline)) vec_u32 sha256d32_vec(struct sha256 out[SHA256_VEC_LANES], vec_u32 w0, vec_u32 w1, vec_u32 w2, vec_u32 w3, vec_u32 w4, vec_u32 w5, vec_u32 w6, vec_u32 w7, int top)
+{
+        vec_u32 a, b, c, d, e, f, g, h;
+        vec_u32 w8, w9, w10, w11, w12, w13, w14, w15;
+
+        a = K_vec(1779033703);
+        b = K_vec(-1150833019);
+        c = K_vec(1013904242);
+        d = K_vec(-1521486534);
+        e = K_vec(1359893119);
+        f = K_vec(-1694144372);
+        g = K_vec(528734635);
+        h = K_vec(1541459225);
+
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1116352408), w0));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(1899447441), w1));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1245643825), w2));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-373957723), w3));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(961987163), w4));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1508970993), w5));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1841331548), w6));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1424204075), w7));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(1476897432));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(310598401));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(607225278));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1426881987));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(1925078388));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(-2132889090));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1680079193));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1046744460));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-459576895), Inc_vec(&w0, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-272742522), Inc3_vec(&w1, K_vec(10485760), sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(264347078), Inc3_vec(&w2, sigma1_vec(w0), sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(604807628), Inc3_vec(&w3, sigma1_vec(w1), sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(770255983), Inc3_vec(&w4, sigma1_vec(w2), sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1249150122), Inc3_vec(&w5, sigma1_vec(w3), sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1555081692), Inc4_vec(&w6, sigma1_vec(w4), K_vec(256), sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1996064986), Inc4_vec(&w7, sigma1_vec(w5), w0, K_vec(285220864))));
+        w8 = Add3_vec(K_vec(-2147483648), sigma1_vec(w6), w1);
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1740746414), w8));
+        w9 = Add_vec(sigma1_vec(w7), w2);
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1473132947), w9));
+        w10 = Add_vec(sigma1_vec(w8), w3);
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1341970488), w10));
+        w11 = Add_vec(sigma1_vec(w9), w4);
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1084653625), w11));
+        w12 = Add_vec(sigma1_vec(w10), w5);
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-958395405), w12));
+        w13 = Add_vec(sigma1_vec(w11), w6);
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-710438585), w13));
+        w14 = Add3_vec(sigma1_vec(w12), w7, K_vec(4194338));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(113926993), w14));
+        w15 = Add4_vec(K_vec(256), sigma1_vec(w13), w8, sigma0_vec(w0));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(338241895), w15));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(666307205), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(773529912), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(1294757372), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1396182291), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1695183700), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1986661051), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-2117940946), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1838011259), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1564481375), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1474664885), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1035236496), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-949202525), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-778901479), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-694614492), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-200395387), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(275423344), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(430227734), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(506948616), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(659060556), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(883997877), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(958139571), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1322822218), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1537002063), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1747873779), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1955562222), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(2024104815), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-2067236844), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1933114872), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-1866530822), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        /* The rounds which remain only move h into place as the last word
+         * of the state, so it is already final. */
+        if (top) return Add_vec(h, K_vec(1541459225));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-1538233109), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add5_vec(K_vec(-1090935817), w14, sigma1_vec(w12), w7, sigma0_vec(w15)));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add5_vec(K_vec(-965641998), w15, sigma1_vec(w13), w8, sigma0_vec(w0)));
+
+        /* Output */
+        Write_vec(&out->u8[0], Add_vec(a, K_vec(1779033703)));
+        Write_vec(&out->u8[4], Add_vec(b, K_vec(-1150833019)));
+        Write_vec(&out->u8[8], Add_vec(c, K_vec(1013904242)));
+        Write_vec(&out->u8[12], Add_vec(d, K_vec(-1521486534)));
+        Write_vec(&out->u8[16], Add_vec(e, K_vec(1359893119)));
+        Write_vec(&out->u8[20], Add_vec(f, K_vec(-1694144372)));
+        Write_vec(&out->u8[24], Add_vec(g, K_vec(528734635)));
+        Write_vec(&out->u8[28], Add_vec(h, K_vec(1541459225)));
+        return h;
+}
+
+/** The double SHA256 of 64-byte blocks, with top as for sha256d32_vec(). */
+static inline __attribute__((always_inline)) vec_u32 sha256d64_vec(struct sha256 out[SHA256_VEC_LANES], const struct sha256 in[2 * SHA256_VEC_LANES], int top)
+{
+        /* Transform 1 */
+        vec_u32 a = K_vec(1779033703);
+        vec_u32 b = K_vec(-1150833019);
+        vec_u32 c = K_vec(1013904242);
+        vec_u32 d = K_vec(-1521486534);
+        vec_u32 e = K_vec(1359893119);
+        vec_u32 f = K_vec(-1694144372);
+        vec_u32 g = K_vec(528734635);
+        vec_u32 h = K_vec(1541459225);
+
+        vec_u32 w0 = Read_vec(&in[0].u8[0]),
+                w1 = Read_vec(&in[0].u8[4]),
+                w2 = Read_vec(&in[0].u8[8]),
+                w3 = Read_vec(&in[0].u8[12]),
+                w4 = Read_vec(&in[0].u8[16]),
+                w5 = Read_vec(&in[0].u8[20]),
+                w6 = Read_vec(&in[0].u8[24]),
+                w7 = Read_vec(&in[0].u8[28]),
+                w8 = Read_vec(&in[1].u8[0]),
+                w9 = Read_vec(&in[1].u8[4]),
+                w10 = Read_vec(&in[1].u8[8]),
+                w11 = Read_vec(&in[1].u8[12]),
+                w12 = Read_vec(&in[1].u8[16]),
+                w13 = Read_vec(&in[1].u8[20]),
+                w14 = Read_vec(&in[1].u8[24]),
+                w15 = Read_vec(&in[1].u8[28]);
+
+        vec_u32 t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1116352408), w0));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(1899447441), w1));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1245643825), w2));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-373957723), w3));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(961987163), w4));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1508970993), w5));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1841331548), w6));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1424204075), w7));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-670586216), w8));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(310598401), w9));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(607225278), w10));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1426881987), w11));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1925078388), w12));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-2132889090), w13));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1680079193), w14));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1046744716), w15));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-459576895), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-272742522), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(264347078), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(604807628), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(770255983), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1249150122), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1555081692), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1996064986), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1740746414), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1473132947), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1341970488), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1084653625), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-958395405), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-710438585), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(113926993), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(338241895), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(666307205), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(773529912), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(1294757372), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1396182291), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1695183700), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1986661051), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-2117940946), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1838011259), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1564481375), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1474664885), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1035236496), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-949202525), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-778901479), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-694614492), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-200395387), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(275423344), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(430227734), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(506948616), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(659060556), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(883997877), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(958139571), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1322822218), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1537002063), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1747873779), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1955562222), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(2024104815), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-2067236844), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1933114872), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-1866530822), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-1538233109), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1090935817), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-965641998), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+
+        t0 = a = Add_vec(a, K_vec(1779033703));
+        t1 = b = Add_vec(b, K_vec(-1150833019));
+        t2 = c = Add_vec(c, K_vec(1013904242));
+        t3 = d = Add_vec(d, K_vec(-1521486534));
+        t4 = e = Add_vec(e, K_vec(1359893119));
+        t5 = f = Add_vec(f, K_vec(-1694144372));
+        t6 = g = Add_vec(g, K_vec(528734635));
+        t7 = h = Add_vec(h, K_vec(1541459225));
+
+        /* Transform 2 */
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-1031131240));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(1899447441));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(-1245643825));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(-373957723));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(961987163));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(1508970993));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1841331548));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1424204075));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-670586216));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(310598401));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(607225278));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1426881987));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(1925078388));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(-2132889090));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1680079193));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1046744204));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(1687906753));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(-251771002));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(266464710));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(604828244));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(1340683375));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(1825146046));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(1639530782));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(385452282));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-221884078));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(-1467065747));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(-1340474267));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(-1176920377));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(-1710083645));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(-418452832));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-38722773));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-952811856));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(812235477));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(-879268513));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(1510936975));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(-601952515));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(171292297));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(-569673212));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(1492437661));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-513975530));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(8339078));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(923306368));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(-1526207950));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1873515831));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(390095120));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(227333873));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-844481683));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1061437897));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-2090779686));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(-615996573));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(184740145));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1875991719));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(1377499850));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(825459761));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(1859394197));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(1833138320));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-1013149198));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(-1630753859));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(-1245077274));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1395635772));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(-758693434));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(119766691));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1533719704));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(1276714358));
+
+        w0 = Add_vec(t0, a);
+        w1 = Add_vec(t1, b);
+        w2 = Add_vec(t2, c);
+        w3 = Add_vec(t3, d);
+        w4 = Add_vec(t4, e);
+        w5 = Add_vec(t5, f);
+        w6 = Add_vec(t6, g);
+        w7 = Add_vec(t7, h);
+
+        return sha256d32_vec(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void VEC_WAY(transform_sha256d64_vec)(struct sha256 out[SHA256_VEC_LANES], const struct sha256 in[2 * SHA256_VEC_LANES])
+{
+        sha256d64_vec(out, in, 0);
+}
+
+
+/* Read_vec(), for blocks at the 80-byte stride of block headers. */
+#define ReadHeader_vec(chunk) ReadStride_vec((chunk), 80)
+
+/** The double SHA256 of block headers, or only the last word of each hash as
+ * for sha256d64_vec(). */
+static inline __attribute__((always_inline)) vec_u32 sha256d80_vec(struct sha256 out[SHA256_VEC_LANES], const unsigned char in[80 * SHA256_VEC_LANES], int top)
+{
+        /* Transform 1 */
+        vec_u32 a = K_vec(1779033703);
+        vec_u32 b = K_vec(-1150833019);
+        vec_u32 c = K_vec(1013904242);
+        vec_u32 d = K_vec(-1521486534);
+        vec_u32 e = K_vec(1359893119);
+        vec_u32 f = K_vec(-1694144372);
+        vec_u32 g = K_vec(528734635);
+        vec_u32 h = K_vec(1541459225);
+
+        vec_u32 w0 = ReadHeader_vec(&in[0]),
+                w1 = ReadHeader_vec(&in[4]),
+                w2 = ReadHeader_vec(&in[8]),
+                w3 = ReadHeader_vec(&in[12]),
+                w4 = ReadHeader_vec(&in[16]),
+                w5 = ReadHeader_vec(&in[20]),
+                w6 = ReadHeader_vec(&in[24]),
+                w7 = ReadHeader_vec(&in[28]),
+                w8 = ReadHeader_vec(&in[32]),
+                w9 = ReadHeader_vec(&in[36]),
+                w10 = ReadHeader_vec(&in[40]),
+                w11 = ReadHeader_vec(&in[44]),
+                w12 = ReadHeader_vec(&in[48]),
+                w13 = ReadHeader_vec(&in[52]),
+                w14 = ReadHeader_vec(&in[56]),
+                w15 = ReadHeader_vec(&in[60]);
+
+        vec_u32 t0, t1, t2, t3, t4, t5, t6, t7;
+
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1116352408), w0));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(1899447441), w1));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1245643825), w2));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-373957723), w3));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(961987163), w4));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1508970993), w5));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1841331548), w6));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1424204075), w7));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-670586216), w8));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(310598401), w9));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(607225278), w10));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1426881987), w11));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1925078388), w12));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-2132889090), w13));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1680079193), w14));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1046744716), w15));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-459576895), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-272742522), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(264347078), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(604807628), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(770255983), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1249150122), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1555081692), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1996064986), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1740746414), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1473132947), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1341970488), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1084653625), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-958395405), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-710438585), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(113926993), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(338241895), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(666307205), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(773529912), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(1294757372), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1396182291), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1695183700), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1986661051), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-2117940946), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1838011259), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1564481375), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1474664885), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1035236496), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-949202525), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-778901479), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-694614492), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-200395387), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(275423344), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(430227734), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(506948616), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(659060556), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(883997877), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(958139571), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1322822218), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1537002063), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1747873779), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1955562222), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(2024104815), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-2067236844), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1933114872), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-1866530822), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-1538233109), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1090935817), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-965641998), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+
+        t0 = a = Add_vec(a, K_vec(1779033703));
+        t1 = b = Add_vec(b, K_vec(-1150833019));
+        t2 = c = Add_vec(c, K_vec(1013904242));
+        t3 = d = Add_vec(d, K_vec(-1521486534));
+        t4 = e = Add_vec(e, K_vec(1359893119));
+        t5 = f = Add_vec(f, K_vec(-1694144372));
+        t6 = g = Add_vec(g, K_vec(528734635));
+        t7 = h = Add_vec(h, K_vec(1541459225));
+
+        /* Transform 2 */
+        w0 = ReadHeader_vec(&in[64]);
+        w1 = ReadHeader_vec(&in[68]);
+        w2 = ReadHeader_vec(&in[72]);
+        w3 = ReadHeader_vec(&in[76]);
+
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1116352408), w0));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(1899447441), w1));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1245643825), w2));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-373957723), w3));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(-1185496485));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(1508970993));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1841331548));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1424204075));
+        Round_vec(a, b, c, &d, e, f, g, &h, K_vec(-670586216));
+        Round_vec(h, a, b, &c, d, e, f, &g, K_vec(310598401));
+        Round_vec(g, h, a, &b, c, d, e, &f, K_vec(607225278));
+        Round_vec(f, g, h, &a, b, c, d, &e, K_vec(1426881987));
+        Round_vec(e, f, g, &h, a, b, c, &d, K_vec(1925078388));
+        Round_vec(d, e, f, &g, h, a, b, &c, K_vec(-2132889090));
+        Round_vec(c, d, e, &f, g, h, a, &b, K_vec(-1680079193));
+        Round_vec(b, c, d, &e, f, g, h, &a, K_vec(-1046744076));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-459576895), Inc_vec(&w0, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-272742522), Inc3_vec(&w1, K_vec(17825792), sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(264347078), Inc3_vec(&w2, sigma1_vec(w0), sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(604807628), Inc3_vec(&w3, sigma1_vec(w1), K_vec(285220864))));
+        w4 = Add_vec(K_vec(-2147483648), sigma1_vec(w2));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(770255983), w4));
+        w5 = sigma1_vec(w3);
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1249150122), w5));
+        w6 = Add_vec(sigma1_vec(w4), K_vec(640));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1555081692), w6));
+        w7 = Add_vec(sigma1_vec(w5), w0);
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1996064986), w7));
+        w8 = Add_vec(sigma1_vec(w6), w1);
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1740746414), w8));
+        w9 = Add_vec(sigma1_vec(w7), w2);
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1473132947), w9));
+        w10 = Add_vec(sigma1_vec(w8), w3);
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1341970488), w10));
+        w11 = Add_vec(sigma1_vec(w9), w4);
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1084653625), w11));
+        w12 = Add_vec(sigma1_vec(w10), w5);
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-958395405), w12));
+        w13 = Add_vec(sigma1_vec(w11), w6);
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-710438585), w13));
+        w14 = Add3_vec(sigma1_vec(w12), w7, K_vec(10485845));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(113926993), w14));
+        w15 = Add4_vec(K_vec(640), sigma1_vec(w13), w8, sigma0_vec(w0));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(338241895), w15));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(666307205), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(773529912), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(1294757372), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(1396182291), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(1695183700), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1986661051), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-2117940946), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-1838011259), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(-1564481375), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(-1474664885), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-1035236496), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-949202525), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-778901479), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-694614492), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-200395387), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(275423344), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(430227734), Inc4_vec(&w0, sigma1_vec(w14), w9, sigma0_vec(w1))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(506948616), Inc4_vec(&w1, sigma1_vec(w15), w10, sigma0_vec(w2))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(659060556), Inc4_vec(&w2, sigma1_vec(w0), w11, sigma0_vec(w3))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(883997877), Inc4_vec(&w3, sigma1_vec(w1), w12, sigma0_vec(w4))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(958139571), Inc4_vec(&w4, sigma1_vec(w2), w13, sigma0_vec(w5))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(1322822218), Inc4_vec(&w5, sigma1_vec(w3), w14, sigma0_vec(w6))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(1537002063), Inc4_vec(&w6, sigma1_vec(w4), w15, sigma0_vec(w7))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(1747873779), Inc4_vec(&w7, sigma1_vec(w5), w0, sigma0_vec(w8))));
+        Round_vec(a, b, c, &d, e, f, g, &h, Add_vec(K_vec(1955562222), Inc4_vec(&w8, sigma1_vec(w6), w1, sigma0_vec(w9))));
+        Round_vec(h, a, b, &c, d, e, f, &g, Add_vec(K_vec(2024104815), Inc4_vec(&w9, sigma1_vec(w7), w2, sigma0_vec(w10))));
+        Round_vec(g, h, a, &b, c, d, e, &f, Add_vec(K_vec(-2067236844), Inc4_vec(&w10, sigma1_vec(w8), w3, sigma0_vec(w11))));
+        Round_vec(f, g, h, &a, b, c, d, &e, Add_vec(K_vec(-1933114872), Inc4_vec(&w11, sigma1_vec(w9), w4, sigma0_vec(w12))));
+        Round_vec(e, f, g, &h, a, b, c, &d, Add_vec(K_vec(-1866530822), Inc4_vec(&w12, sigma1_vec(w10), w5, sigma0_vec(w13))));
+        Round_vec(d, e, f, &g, h, a, b, &c, Add_vec(K_vec(-1538233109), Inc4_vec(&w13, sigma1_vec(w11), w6, sigma0_vec(w14))));
+        Round_vec(c, d, e, &f, g, h, a, &b, Add_vec(K_vec(-1090935817), Inc4_vec(&w14, sigma1_vec(w12), w7, sigma0_vec(w15))));
+        Round_vec(b, c, d, &e, f, g, h, &a, Add_vec(K_vec(-965641998), Inc4_vec(&w15, sigma1_vec(w13), w8, sigma0_vec(w0))));
+
+        w0 = Add_vec(t0, a);
+        w1 = Add_vec(t1, b);
+        w2 = Add_vec(t2, c);
+        w3 = Add_vec(t3, d);
+        w4 = Add_vec(t4, e);
+        w5 = Add_vec(t5, f);
+        w6 = Add_vec(t6, g);
+        w7 = Add_vec(t7, h);
+
+        return sha256d32_vec(out, w0, w1, w2, w3, w4, w5, w6, w7, top);
+}
+
+void VEC_WAY(transform_sha256d80_vec)(struct sha256 out[SHA256_VEC_LANES], const unsigned char in[80 * SHA256_VEC_LANES])
+{
+        sha256d80_vec(out, in, 0);
+}
+
+
+/* Read_vec(), for messages at the 32-byte stride of hashes. */
+#define ReadHash_vec(chunk) ReadStride_vec((chunk), 32)
+
+void VEC_WAY(transform_sha256d32_vec)(struct sha256 out[SHA256_VEC_LANES], const struct sha256 in[SHA256_VEC_LANES])
+{
+        sha256d32_vec(out,
+                ReadHash_vec(&in->u8[0]),
+                ReadHash_vec(&in->u8[4]),
+                ReadHash_vec(&in->u8[8]),
+                ReadHash_vec(&in->u8[12]),
+                ReadHash_vec(&in->u8[16]),
+                ReadHash_vec(&in->u8[20]),
+                ReadHash_vec(&in->u8[24]),
+                ReadHash_vec(&in->u8[28]),
+                0);
+}
+
+/** The lanes of v which are no greater than t, as unsigned numbers. */
+static inline __attribute__((always_inline)) uint32_t LessEqual_vec(vec_u32 v, const uint32_t t[SHA256_VEC_LANES]) {
+        uint32_t mask = 0;
+        int j;
+        for (j = 0; j < SHA256_VEC_LANES; ++j) {
+                mask |= (uint32_t)(v[j] <= t[j]) << j;
+        }
+        return mask;
+}
+
+/* The last word of each hash is compared as a little-endian number, as by
+ * Bitcoin, so its bytes are swapped before the comparison. */
+static inline __attribute__((always_inline)) vec_u32 ByteSwap_vec(vec_u32 v) {
+        return Or_vec(Or_vec(ShL_vec(v, 24), And_vec(ShL_vec(v, 8), K_vec(0xff0000))), Or_vec(And_vec(ShR_vec(v, 8), K_vec(0xff00)), ShR_vec(v, 24)));
+}
+
+uint32_t VEC_WAY(transform_sha256d64below_vec)(const struct sha256 in[2 * SHA256_VEC_LANES], const uint32_t target[SHA256_VEC_LANES])
+{
+        return LessEqual_vec(ByteSwap_vec(sha256d64_vec(NULL, in, !0)), target);
+}
+
+uint32_t VEC_WAY(transform_sha256d80below_vec)(const unsigned char in[80 * SHA256_VEC_LANES], const uint32_t target[SHA256_VEC_LANES])
+{
+        return LessEqual_vec(ByteSwap_vec(sha256d80_vec(NULL, in, !0)), target);
+}
+
+#undef vec_u32
+#undef K_vec
+#undef Inc_vec
+#undef Inc3_vec
+#undef Inc4_vec
+#undef Ch_vec
+#undef Maj_vec
+#undef Sigma0_vec
+#undef Sigma1_vec
+#undef sigma0_vec
+#undef sigma1_vec
+#undef Round_vec
+#undef ReadStride_vec
+#undef Write_vec
+#undef sha256d32_vec
+#undef sha256d64_vec
+#undef sha256d80_vec
+#undef LessEqual_vec
+#undef ByteSwap_vec
+#undef Read_vec
+#undef ReadHeader_vec
+#undef ReadHash_vec
+
+/* End of File
+ */
@@ -0,0 +1,429 @@
+/* Copyright (c) 2014-2019 The Bitcoin Core developers
+ * Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sha2/sha512.h>
+#include "common.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "compat/cpuid.h"
+
+#if defined(__linux__) && defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#if !defined(HWCAP_SHA512)
+#define HWCAP_SHA512 (1 << 21)
+#endif
+#endif
+
+#if defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#endif
+
+#include "sha512_internal.h"
+
+static inline __attribute__((always_inline)) uint64_t Ch_noasm(uint64_t x, uint64_t y, uint64_t z) { return z ^ (x & (y ^ z)); }
+static inline __attribute__((always_inline)) uint64_t Maj_noasm(uint64_t x, uint64_t y, uint64_t z) { return (x & y) | (z & (x | y)); }
+static inline __attribute__((always_inline)) uint64_t Sigma0_noasm(uint64_t x) { return (x >> 28 | x << 36) ^ (x >> 34 | x << 30) ^ (x >> 39 | x << 25); }
+static inline __attribute__((always_inline)) uint64_t Sigma1_noasm(uint64_t x) { return (x >> 14 | x << 50) ^ (x >> 18 | x << 46) ^ (x >> 41 | x << 23); }
+static inline __attribute__((always_inline)) uint64_t sigma0_noasm(uint64_t x) { return (x >> 1 | x << 63) ^ (x >> 8 | x << 56) ^ (x >> 7); }
+static inline __attribute__((always_inline)) uint64_t sigma1_noasm(uint64_t x) { return (x >> 19 | x << 45) ^ (x >> 61 | x << 3) ^ (x >> 6); }
+
+/** One round of SHA-512. */
+static inline __attribute__((always_inline)) void Round_noasm(uint64_t a, uint64_t b, uint64_t c, uint64_t* d, uint64_t e, uint64_t f, uint64_t g, uint64_t* h, uint64_t k)
+{
+        uint64_t t1 = *h + Sigma1_noasm(e) + Ch_noasm(e, f, g) + k;
+        uint64_t t2 = Sigma0_noasm(a) + Maj_noasm(a, b, c);
+        *d += t1;
+        *h = t1 + t2;
+}
+
+static const uint64_t K[80] = {
+        0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+        0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+        0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+        0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+        0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+        0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+        0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+        0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+        0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+        0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+        0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+        0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+        0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+        0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+        0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+        0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+        0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+        0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+        0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+        0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull
+};
+
+/** Perform a number of SHA-512 transformations, processing 128-byte chunks. */
+static void transform_sha512_noasm(uint64_t* s, const unsigned char* chunk, size_t blocks)
+{
+        while (blocks--) {
+                uint64_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+                uint64_t w[16];
+                int i, j;
+
+                for (i = 0; i < 16; ++i) {
+                        w[i] = ReadBE64(chunk + 8 * i);
+                }
+
+                /* The message schedule is kept in a ring of 16 words, and
+                 * extended eight words at a time ahead of the rounds which
+                 * consume them. */
+                for (i = 0; i < 80; i += 8) {
+                        if (i >= 16) {
+                                for (j = i; j < i + 8; ++j) {
+                                        w[j & 15] += sigma1_noasm(w[(j - 2) & 15]) + w[(j - 7) & 15] + sigma0_noasm(w[(j - 15) & 15]);
+                                }
+                        }
+                        Round_noasm(a, b, c, &d, e, f, g, &h, K[i + 0] + w[(i + 0) & 15]);
+                        Round_noasm(h, a, b, &c, d, e, f, &g, K[i + 1] + w[(i + 1) & 15]);
+                        Round_noasm(g, h, a, &b, c, d, e, &f, K[i + 2] + w[(i + 2) & 15]);
+                        Round_noasm(f, g, h, &a, b, c, d, &e, K[i + 3] + w[(i + 3) & 15]);
+                        Round_noasm(e, f, g, &h, a, b, c, &d, K[i + 4] + w[(i + 4) & 15]);
+                        Round_noasm(d, e, f, &g, h, a, b, &c, K[i + 5] + w[(i + 5) & 15]);
+                        Round_noasm(c, d, e, &f, g, h, a, &b, K[i + 6] + w[(i + 6) & 15]);
+                        Round_noasm(b, c, d, &e, f, g, h, &a, K[i + 7] + w[(i + 7) & 15]);
+                }
+
+                s[0] += a;
+                s[1] += b;
+                s[2] += c;
+                s[3] += d;
+                s[4] += e;
+                s[5] += f;
+                s[6] += g;
+                s[7] += h;
+                chunk += 128;
+        }
+}
+
+typedef void (*transform512_t)(uint64_t*, const unsigned char*, size_t);
+
+/** The SHA-512 implementation used by a backend. */
+struct sha512_dispatch {
+        transform512_t transform;
+        const char* name;
+        const char* id;
+};
+
+/** The SHA-512 backends, in increasing order of preference. */
+enum sha512_backend {
+        SHA512_BACKEND_NOASM,
+#if defined(__x86_64__) || defined(__amd64__)
+        SHA512_BACKEND_AVX2,
+#endif
+#if defined(__aarch64__) && defined(ENABLE_ARM_SHA512)
+        SHA512_BACKEND_ARMV8,
+#endif
+        SHA512_BACKEND_COUNT
+};
+
+static const struct sha512_dispatch dispatch_tables[SHA512_BACKEND_COUNT] = {
+        { transform_sha512_noasm, "standard", "noasm" },
+#if defined(__x86_64__) || defined(__amd64__)
+        { transform_sha512_avx2, "avx2(1way)", "avx2" },
+#endif
+#if defined(__aarch64__) && defined(ENABLE_ARM_SHA512)
+        { transform_sha512_armv8, "armv8.2(1way)", "armv8" },
+#endif
+};
+
+/* The backend is selected and published exactly as for SHA256; see the
+ * comments in sha256.c.  A SHA-512 compression is long enough that the
+ * acquire load is immaterial, so the public entry points are not bound with
+ * indirect functions. */
+#define DISPATCH_NONE 0
+#define DISPATCH_BUSY 1
+#define DISPATCH_DONE 2
+static int dispatch_state = DISPATCH_NONE;
+static const struct sha512_dispatch* dispatch = NULL;
+
+static const struct sha512_dispatch* sha512_dispatch_init(void);
+
+/** Return the published dispatch table, running detection on first use. */
+static inline __attribute__((always_inline)) const struct sha512_dispatch* get_dispatch(void)
+{
+        const struct sha512_dispatch* d = __atomic_load_n(&dispatch, __ATOMIC_ACQUIRE);
+        if (__builtin_expect(d == NULL, 0)) {
+                d = sha512_dispatch_init();
+        }
+        return d;
+}
+
+#ifndef NDEBUG
+static int self_test(const struct sha512_dispatch* d) {
+        /* Input state (equal to the initial SHA512 state) */
+        static const uint64_t init[8] = {
+                0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+                0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull
+        };
+        /* Some random input data to test with */
+        static const unsigned char data[641] = "-" /* Intentionally not aligned */
+                "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+                "eiusmod tempor incididunt ut labore et dolore magna aliqua. Et m"
+                "olestie ac feugiat sed lectus vestibulum mattis ullamcorper. Mor"
+                "bi blandit cursus risus at ultrices mi tempus imperdiet nulla. N"
+                "unc congue nisi vita suscipit tellus mauris. Imperdiet proin fer"
+                "mentum leo vel orci. Massa tempor nec feugiat nisl pretium fusce"
+                " id velit. Telus in metus vulputate eu scelerisque felis. Mi tem"
+                "pus imperdiet nulla malesuada pellentesque. Tristique magna sit.";
+        /* Expected output state for hashing the i*128 first input bytes above (excluding SHA512 padding). */
+        static const uint64_t result[6][8] = {
+                {0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+                 0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull},
+                {0x1e3927161d49a355ull, 0xdc3b6f3cafd39169ull, 0xfa97663f6bf286d3ull, 0x2c75a11055b8ecf4ull,
+                 0xaa906433796ab46aull, 0x80bf61bb9dd1fbe6ull, 0x6d28b1ba0b6f48d1ull, 0x7cff6a79d5f4263dull},
+                {0x813bdebe11ecb2c1ull, 0xbe7007f568901d56ull, 0x728f9d4292ee201full, 0x274d883d3a5de8c8ull,
+                 0x845934259c4f0056ull, 0x930cb8928d28957aull, 0x2dc983db1df2fcccull, 0xd84c11e568460cf7ull},
+                {0xa468a9ebc6073902ull, 0x9d1093538d319ae9ull, 0x52b1169e10a64384ull, 0xbe1d219cdc6d8a58ull,
+                 0xcb81af82f7dec7e4ull, 0xd71eb9588e7ef64bull, 0xd0e2552f5a60ec41ull, 0x485c83be73d104ecull},
+                {0xf1f843bdbd3fd9b3ull, 0x2f50a214ec1a1281ull, 0xff6175f56d18a912ull, 0xf077aaa6fb554a22ull,
+                 0xfac350e4cf2e225bull, 0xc8ef2fd76cb13b95ull, 0x7f2ac5c43b7787ffull, 0x8ef501252b802fd8ull},
+                {0x34d6762313e5e9b8ull, 0xb97ecc766ed39773ull, 0x96d1678cce66ffb5ull, 0xfb62108e822cb980ull,
+                 0xe3b6f037b1dfa8f2ull, 0xc328c1f36afa36f3ull, 0x24206a1c14c4a882ull, 0xc0a29c1b6b3196f4ull},
+        };
+
+        int i;
+
+        /* Test transform() for 0 through 5 transformations. */
+        for (i = 0; i <= 5; ++i) {
+                uint64_t state[8];
+                memcpy(state, init, 8 * sizeof(uint64_t));
+                d->transform(state, data + 1, i);
+                if (memcmp(state, result[i], 8 * sizeof(uint64_t))) return 0;
+        }
+
+        return !0;
+}
+#endif /* NDEBUG */
+
+#if (defined(__x86_64__) || defined(__amd64__))
+/** Check whether the OS has enabled AVX registers. */
+static int AVXEnabled(void)
+{
+        uint32_t a, d;
+        __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+        return (a & 6) == 6;
+}
+#endif
+
+/** Return a bitmask of the backends which the host supports. */
+static unsigned sha512_supported_backends(unsigned long hwcap)
+{
+        unsigned ret = 1u << SHA512_BACKEND_NOASM;
+#if defined(__x86_64__) || defined(__amd64__)
+        uint32_t eax=0, ebx=0, ecx=0, edx=0;
+        int have_avx2 = 0;
+
+        (void)hwcap;
+
+        GetCPUID(1, 0, &eax, &ebx, &ecx, &edx);
+        /* XSAVE and AVX */
+        if (((ecx >> 27) & 1) && ((ecx >> 28) & 1) && AVXEnabled()) {
+                GetCPUID(7, 0, &eax, &ebx, &ecx, &edx);
+                have_avx2 = (ebx >> 5) & 1;
+        }
+        if (have_avx2) {
+                ret |= 1u << SHA512_BACKEND_AVX2;
+        }
+
+#elif defined(__aarch64__) && defined(ENABLE_ARM_SHA512)
+        int have_arm_sha512 = 0;
+
+#if defined(__linux__)
+        if (hwcap & HWCAP_SHA512) {
+                have_arm_sha512 = !0;
+        }
+#else
+        (void)hwcap;
+#endif
+
+#if defined(__APPLE__)
+        int val = 0;
+        size_t len = sizeof(val);
+        if (sysctlbyname("hw.optional.armv8_2_sha512", &val, &len, NULL, 0) == 0 && val) {
+                have_arm_sha512 = !0;
+        }
+#endif
+
+        if (have_arm_sha512) {
+                ret |= 1u << SHA512_BACKEND_ARMV8;
+        }
+#else
+        (void)hwcap;
+#endif
+
+        return ret;
+}
+
+/** Choose the best backend for the host, which is the supported backend
+ * listed last in enum sha512_backend. */
+static enum sha512_backend sha512_select_backend(unsigned long hwcap)
+{
+        unsigned supported = sha512_supported_backends(hwcap);
+        int backend = SHA512_BACKEND_COUNT - 1;
+        while (!((supported >> backend) & 1)) {
+                --backend;
+        }
+        return (enum sha512_backend)backend;
+}
+
+/** The hardware capabilities argument to sha512_select_backend(). */
+static unsigned long sha512_hwcap(void)
+{
+#if defined(__linux__) && defined(__aarch64__)
+        return getauxval(AT_HWCAP);
+#else
+        return 0;
+#endif
+}
+
+static const struct sha512_dispatch* sha512_dispatch_init(void)
+{
+        const struct sha512_dispatch* d = &dispatch_tables[sha512_select_backend(sha512_hwcap())];
+        int expected = DISPATCH_NONE;
+        if (__atomic_compare_exchange_n(&dispatch_state, &expected, DISPATCH_BUSY, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                assert(self_test(d));
+                __atomic_store_n(&dispatch, d, __ATOMIC_RELEASE);
+                __atomic_store_n(&dispatch_state, DISPATCH_DONE, __ATOMIC_RELAXED);
+        }
+        return d;
+}
+
+const char* sha512_auto_detect(void)
+{
+        return get_dispatch()->name;
+}
+
+/* SHA-512 */
+
+void sha512_init(struct sha512_ctx* ctx)
+{
+        static const struct sha512_ctx init = SHA512_INIT;
+        assert(ctx);
+        *ctx = init;
+}
+
+void sha384_init(struct sha512_ctx* ctx)
+{
+        static const struct sha512_ctx init = SHA384_INIT;
+        assert(ctx);
+        *ctx = init;
+}
+
+void sha512_256_init(struct sha512_ctx* ctx)
+{
+        static const struct sha512_ctx init = SHA512_256_INIT;
+        assert(ctx);
+        *ctx = init;
+}
+
+static inline __attribute__((always_inline)) void sha512_update_impl(const struct sha512_dispatch* d, struct sha512_ctx* ctx, const void *_data, size_t len)
+{
+        const unsigned char* data = (const unsigned char*)_data;
+        const unsigned char* end = data + len;
+        size_t bufsize = ctx->bytes % 128;
+        if (bufsize && bufsize + len >= 128) {
+                /* Fill the buffer, and process it. */
+                memcpy(ctx->buf.u8 + bufsize, data, 128 - bufsize);
+                ctx->bytes += 128 - bufsize;
+                data += 128 - bufsize;
+                d->transform(ctx->s, ctx->buf.u8, 1);
+                bufsize = 0;
+        }
+        if (end - data >= 128) {
+                size_t blocks = (end - data) / 128;
+                d->transform(ctx->s, data, blocks);
+                data += 128 * blocks;
+                ctx->bytes += 128 * blocks;
+        }
+        if (end > data) {
+                /* Fill the buffer with what remains. */
+                memcpy(ctx->buf.u8 + bufsize, data, end - data);
+                ctx->bytes += end - data;
+        }
+}
+
+/** Pad the message and write the first words of the final state to out. */
+static inline __attribute__((always_inline)) void sha512_done_impl(const struct sha512_dispatch* d, unsigned char* out, size_t words, struct sha512_ctx* ctx)
+{
+        static const unsigned char pad[128] = {0x80};
+        unsigned char sizedesc[16];
+        size_t i;
+        /* The message length is a 128-bit big-endian number of bits. */
+        WriteBE64(sizedesc, (uint64_t)ctx->bytes >> 61);
+        WriteBE64(sizedesc + 8, (uint64_t)ctx->bytes << 3);
+        sha512_update_impl(d, ctx, pad, 1 + ((239 - (ctx->bytes % 128)) % 128));
+        sha512_update_impl(d, ctx, sizedesc, 16);
+        for (i = 0; i < words; ++i) {
+                WriteBE64(out + 8 * i, ctx->s[i]);
+        }
+}
+
+void sha512_update(struct sha512_ctx* ctx, const void *data, size_t len)
+{
+        sha512_update_impl(get_dispatch(), ctx, data, len);
+}
+
+void sha512_done(struct sha512* hash, struct sha512_ctx* ctx)
+{
+        sha512_done_impl(get_dispatch(), hash->u8, 8, ctx);
+}
+
+void sha384_done(struct sha384* hash, struct sha512_ctx* ctx)
+{
+        sha512_done_impl(get_dispatch(), hash->u8, 6, ctx);
+}
+
+void sha512_256_done(struct sha512_256* hash, struct sha512_ctx* ctx)
+{
+        sha512_done_impl(get_dispatch(), hash->u8, 4, ctx);
+}
+
+/* Backend-specific entry points, for benchmarks and tests. */
+
+size_t sha512_backend_count(void)
+{
+        return SHA512_BACKEND_COUNT;
+}
+
+const char* sha512_backend_id(size_t backend)
+{
+        assert(backend < SHA512_BACKEND_COUNT);
+        return dispatch_tables[backend].id;
+}
+
+int sha512_backend_supported(size_t backend)
+{
+        assert(backend < SHA512_BACKEND_COUNT);
+        return (sha512_supported_backends(sha512_hwcap()) >> backend) & 1;
+}
+
+void sha512_update_backend(size_t backend, struct sha512_ctx* ctx, const void *data, size_t len)
+{
+        assert(backend < SHA512_BACKEND_COUNT);
+        sha512_update_impl(&dispatch_tables[backend], ctx, data, len);
+}
+
+void sha512_done_backend(size_t backend, struct sha512* hash, struct sha512_ctx* ctx)
+{
+        assert(backend < SHA512_BACKEND_COUNT);
+        sha512_done_impl(&dispatch_tables[backend], hash->u8, 8, ctx);
+}
+
+/* End of File
+ */
@@ -0,0 +1,39 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SHA2__SHA512_INTERNAL_H
+#define SHA2__SHA512_INTERNAL_H
+
+#include <sha2/sha512.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Backend-specific entry points, for benchmarks and tests.  These follow the
+ * same conventions as the SHA256 entry points in sha256_internal.h. */
+extern size_t sha512_backend_count(void);
+extern const char* sha512_backend_id(size_t backend);
+extern int sha512_backend_supported(size_t backend);
+extern void sha512_update_backend(size_t backend, struct sha512_ctx* ctx, const void *data, size_t len);
+extern void sha512_done_backend(size_t backend, struct sha512* hash, struct sha512_ctx* ctx);
+
+#if defined(__x86_64__) || defined(__amd64__)
+extern void transform_sha512_avx2(uint64_t* s, const unsigned char* chunk, size_t blocks);
+#endif
+#if defined(__aarch64__)
+extern void transform_sha512_armv8(uint64_t* s, const unsigned char* chunk, size_t blocks);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA2__SHA512_INTERNAL_H */
+
+/* End of File
+ */
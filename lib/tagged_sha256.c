@@ -0,0 +1,79 @@
+/* Copyright (c) 2022 Mark Friedenbach
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sha2/tagged_sha256.h>
+#include "sha256_internal.h"
+#include "common.h"
+
+#include <assert.h>
+#include <string.h>
+
+/* The midstates after SHA256(tag) || SHA256(tag), as tagged_sha256_init()
+ * computes them. */
+#define TAGGED_SHA256_CTX(s0, s1, s2, s3, s4, s5, s6, s7) \
+        { { s0, s1, s2, s3, s4, s5, s6, s7 }, { { 0 } }, 64 }
+
+const struct sha256_ctx tagged_sha256_bip340_aux = TAGGED_SHA256_CTX(
+        0x24dd3219ul, 0x4eba7e70ul, 0xca0fabb9ul, 0x0fa3166dul, 0x3afbe4b1ul, 0x4c44df97ul, 0x4aac2739ul, 0x249e850aul);
+const struct sha256_ctx tagged_sha256_bip340_nonce = TAGGED_SHA256_CTX(
+        0x46615b35ul, 0xf4bfbff7ul, 0x9f8dc671ul, 0x83627ab3ul, 0x60217180ul, 0x57358661ul, 0x21a29e54ul, 0x68b07b4cul);
+const struct sha256_ctx tagged_sha256_bip340_challenge = TAGGED_SHA256_CTX(
+        0x9cecba11ul, 0x23925381ul, 0x11679112ul, 0xd1627e0ful, 0x97c87550ul, 0x003cc765ul, 0x90f61164ul, 0x33e9b66aul);
+const struct sha256_ctx tagged_sha256_tapleaf = TAGGED_SHA256_CTX(
+        0x9ce0e4e6ul, 0x7c116c39ul, 0x38b3caf2ul, 0xc30f5089ul, 0xd3f3936cul, 0x47636e60ul, 0x7db33eeaul, 0xddc6f0c9ul);
+const struct sha256_ctx tagged_sha256_tapbranch = TAGGED_SHA256_CTX(
+        0x23a865a9ul, 0xb8a40da7ul, 0x977c1e04ul, 0xc49e246ful, 0xb5be1376ul, 0x9d24c9b7ul, 0xb583b5d4ul, 0xa8d226d2ul);
+const struct sha256_ctx tagged_sha256_taptweak = TAGGED_SHA256_CTX(
+        0xd129a2f3ul, 0x701c655dul, 0x6583b6c3ul, 0xb9419727ul, 0x95f4e232ul, 0x94fd54f4ul, 0xa2ae8d85ul, 0x47ca590bul);
+const struct sha256_ctx tagged_sha256_tapsighash = TAGGED_SHA256_CTX(
+        0xf504a425ul, 0xd7f8783bul, 0x1363868aul, 0xe3e55658ul, 0x6eee945dul, 0xbc7888ddul, 0x02a6e2c3ul, 0x1873fe9ful);
+
+void tagged_sha256_init(struct sha256_ctx* tag, const void* name, size_t len)
+{
+        struct sha256 hash;
+
+        assert(tag);
+        sha256_init(tag);
+        sha256_update(tag, name, len);
+        sha256_done(&hash, tag);
+        sha256_init(tag);
+        sha256_update(tag, &hash, 32);
+        sha256_update(tag, &hash, 32);
+}
+
+void tagged_sha256(struct sha256* hash, const struct sha256_ctx* tag, const void* data, size_t len)
+{
+        struct sha256_ctx ctx;
+        unsigned char block[64];
+
+        assert(hash && tag && tag->bytes == 64);
+        if (len > 55) {
+                ctx = *tag;
+                sha256_update(&ctx, data, len);
+                sha256_done(hash, &ctx);
+                return;
+        }
+
+        /* The message and its padding fit in a single block after the tag's
+         * block. */
+        if (len) {
+                memcpy(block, data, len);
+        }
+        block[len] = 0x80;
+        memset(block + len + 1, 0, 64 - len - 1 - 8);
+        WriteBE64(block + 56, (uint64_t)(64 + len) << 3);
+        sha256_midstate(hash, tag->s, block, 1);
+}
+
+void tagged_sha256_batch64(struct sha256 out[], const struct sha256_ctx* tag, const unsigned char in[], size_t count)
+{
+        assert(out && tag && tag->bytes == 64);
+        sha256_midstate_final64(out, tag->s, in, count);
+}
+
+/* End of File
+ */
@@ -5,18 +5,782 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+/* for getline, posix_madvise and posix_memalign */
+#define _POSIX_C_SOURCE 200809L
+
+#if defined(HAVE_CONFIG_H)
+#include <libsha2-config.h>
+#endif
+
 #include <sha2/sha256.h>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
 
-int main(int argc, char *argv[])
+#define PROGRAM_NAME "sha256sum"
+
+/* Pipes and other files which cannot be mapped are read into a page-aligned
+ * buffer of this size, which is filled completely before it is hashed so that
+ * the hasher always sees long runs of whole blocks. */
+#define READ_BUFFER_SIZE ((size_t)1 << 20)
+#define READ_BUFFER_ALIGN 4096
+
+/* Regular files are mapped and hashed a window of this size at a time, which
+ * bounds the address space used for very large files. */
+#define MAP_WINDOW_SIZE ((size_t)1 << 30)
+
+/* With --jobs, regular files up to this size are read whole and hashed in the
+ * lanes of a multi-buffer manager, while larger ones are hashed on their own
+ * as usual. */
+#define SMALL_FILE_MAX ((size_t)256 << 10)
+
+enum {
+        IGNORE_MISSING_OPTION = 256,
+        QUIET_OPTION,
+        STATUS_OPTION,
+        STRICT_OPTION,
+        TAG_OPTION,
+        HELP_OPTION,
+        VERSION_OPTION
+};
+
+static const struct option long_options[] = {
+        { "binary", no_argument, NULL, 'b' },
+        { "check", no_argument, NULL, 'c' },
+        { "ignore-missing", no_argument, NULL, IGNORE_MISSING_OPTION },
+        { "quiet", no_argument, NULL, QUIET_OPTION },
+        { "status", no_argument, NULL, STATUS_OPTION },
+        { "strict", no_argument, NULL, STRICT_OPTION },
+        { "tag", no_argument, NULL, TAG_OPTION },
+        { "text", no_argument, NULL, 't' },
+        { "warn", no_argument, NULL, 'w' },
+        { "jobs", required_argument, NULL, 'j' },
+        { "help", no_argument, NULL, HELP_OPTION },
+        { "version", no_argument, NULL, VERSION_OPTION },
+        { NULL, 0, NULL, 0 }
+};
+
+static int binary_mode = 0;
+static int bsd_tag = 0;
+static int ignore_missing = 0;
+static int quiet = 0;
+static int status_only = 0;
+static int strict = 0;
+static int warn = 0;
+static long jobs = -1;
+
+/** A file to be hashed, and the result. */
+struct work_item {
+        const char* name;
+        struct sha256 hash;
+        int err;
+        int done;
+};
+
+/** The files being hashed by a pool of threads.  Items are claimed in order,
+ * but may finish in any order. */
+struct work_queue {
+        struct work_item* items;
+        size_t count;
+        size_t next;
+        pthread_mutex_t lock;
+        pthread_cond_t cond;
+};
+
+static void usage(int status)
+{
+        if (status != EXIT_SUCCESS) {
+                fprintf(stderr, "Try '%s --help' for more information.\n", PROGRAM_NAME);
+                exit(status);
+        }
+        printf("Usage: %s [OPTION]... [FILE]...\n", PROGRAM_NAME);
+        printf("Print or check SHA256 (256-bit) checksums.\n\n");
+        printf("With no FILE, or when FILE is -, read standard input.\n\n");
+        printf("  -b, --binary          read in binary mode\n");
+        printf("  -c, --check           read SHA256 sums from the FILEs and check them\n");
+        printf("      --tag             create a BSD-style checksum\n");
+        printf("  -j, --jobs=N          hash files in N threads at a time, and in the lanes\n");
+        printf("                          of the multi-lane kernels; 0 means one per CPU\n");
+        printf("  -t, --text            read in text mode (default)\n\n");
+        printf("The following five options are useful only when verifying checksums:\n");
+        printf("      --ignore-missing  don't fail or report status for missing files\n");
+        printf("      --quiet           don't print OK for each successfully verified file\n");
+        printf("      --status          don't output anything, status code shows success\n");
+        printf("      --strict          exit non-zero for improperly formatted checksum lines\n");
+        printf("  -w, --warn            warn about improperly formatted checksum lines\n\n");
+        printf("      --help            display this help and exit\n");
+        printf("      --version         output version information and exit\n");
+        exit(status);
+}
+
+/** Hash as much of a regular file as can be mapped, a window at a time, and
+ * return the number of bytes hashed. */
+static off_t hash_mapped(int fd, off_t size, struct sha256_ctx* ctx)
+{
+        off_t offset = 0;
+        while (offset < size) {
+                size_t len = (size - offset) < (off_t)MAP_WINDOW_SIZE ? (size_t)(size - offset) : MAP_WINDOW_SIZE;
+                void* p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, offset);
+                if (p == MAP_FAILED) {
+                        break;
+                }
+                posix_madvise(p, len, POSIX_MADV_SEQUENTIAL);
+                sha256_update(ctx, p, len);
+                munmap(p, len);
+                offset += len;
+        }
+        return offset;
+}
+
+/** Hash the remainder of a file with read() into a buffer of READ_BUFFER_SIZE
+ * bytes, returning -1 on error. */
+static int hash_read(int fd, struct sha256_ctx* ctx, unsigned char* buffer)
+{
+        size_t fill;
+        ssize_t n;
+        do {
+                fill = 0;
+                while (fill < READ_BUFFER_SIZE) {
+                        n = read(fd, buffer + fill, READ_BUFFER_SIZE - fill);
+                        if (n < 0) {
+                                if (errno == EINTR) {
+                                        continue;
+                                }
+                                return -1;
+                        }
+                        if (n == 0) {
+                                break;
+                        }
+                        fill += (size_t)n;
+                }
+                sha256_update(ctx, buffer, fill);
+        } while (fill == READ_BUFFER_SIZE);
+        return 0;
+}
+
+/** Hash an open file from its current position, using a read buffer of
+ * READ_BUFFER_SIZE bytes.  Returns 0 on success, or -1 with errno set. */
+static int hash_fd(int fd, const struct stat* st, struct sha256* hash, unsigned char* buffer)
 {
-        int exit_code = 0;
         struct sha256_ctx ctx = SHA256_INIT;
-        struct sha256 hash = { 0 };
-        printf("Using SHA256 algorithm: %s\n", sha256_auto_detect());
-        sha256_update(&ctx, "a", 1);
-        sha256_done(&hash, &ctx);
+        off_t done = 0;
+
+        if (S_ISREG(st->st_mode) && st->st_size > 0) {
+                /* Standard input may be a regular file which has been
+                 * partially read already. */
+                if (lseek(fd, 0, SEEK_CUR) == 0) {
+                        done = hash_mapped(fd, st->st_size, &ctx);
+                }
+        }
+        /* Read whatever could not be mapped, including anything appended to
+         * the file since it was examined. */
+        if (done && lseek(fd, done, SEEK_SET) != done) {
+                return -1;
+        }
+        if (hash_read(fd, &ctx, buffer) < 0) {
+                return -1;
+        }
+        sha256_done(hash, &ctx);
+        return 0;
+}
+
+/** Open the named file, or standard input for "-".  Returns the descriptor,
+ * or -1 with errno set. */
+static int open_file(const char* name, struct stat* st)
+{
+        int fd = strcmp(name, "-") ? open(name, O_RDONLY) : STDIN_FILENO;
+        if (fd >= 0 && fstat(fd, st) < 0) {
+                int err = errno;
+                if (fd != STDIN_FILENO) {
+                        close(fd);
+                }
+                errno = err;
+                return -1;
+        }
+        return fd;
+}
+
+static void close_file(int fd)
+{
+        if (fd != STDIN_FILENO) {
+                close(fd);
+        }
+}
+
+/** Hash the named file, or standard input for "-".  Returns 0 on success, or
+ * -1 with errno set. */
+static int hash_file(const char* name, struct sha256* hash, unsigned char* buffer)
+{
+        struct stat st;
+        int fd, ret, err;
+        if ((fd = open_file(name, &st)) < 0) {
+                return -1;
+        }
+        ret = hash_fd(fd, &st, hash, buffer);
+        err = errno;
+        close_file(fd);
+        errno = err;
+        return ret;
+}
+
+static unsigned char* alloc_read_buffer(void)
+{
+        void* p;
+        if (posix_memalign(&p, READ_BUFFER_ALIGN, READ_BUFFER_SIZE)) {
+                fprintf(stderr, "%s: %s\n", PROGRAM_NAME, strerror(ENOMEM));
+                exit(EXIT_FAILURE);
+        }
+        return (unsigned char*)p;
+}
+
+/** Read the rest of a file into a growable buffer, returning the number of
+ * bytes read, or -1 with errno set. */
+static ssize_t read_whole(int fd, unsigned char** buf, size_t* cap, size_t hint)
+{
+        size_t len = 0;
+        ssize_t n;
+        while (1) {
+                if (len == *cap) {
+                        size_t want = *cap ? 2 * *cap : hint + 1;
+                        unsigned char* p = (unsigned char*)realloc(*buf, want);
+                        if (!p) {
+                                errno = ENOMEM;
+                                return -1;
+                        }
+                        *buf = p;
+                        *cap = want;
+                }
+                n = read(fd, *buf + len, *cap - len);
+                if (n < 0) {
+                        if (errno == EINTR) {
+                                continue;
+                        }
+                        return -1;
+                }
+                if (n == 0) {
+                        return (ssize_t)len;
+                }
+                len += (size_t)n;
+        }
+}
+
+/** Record the result of an item, waking the thread printing results. */
+static void finish_item(struct work_queue* q, struct work_item* item, int err)
+{
+        pthread_mutex_lock(&q->lock);
+        item->err = err;
+        item->done = !0;
+        pthread_cond_broadcast(&q->cond);
+        pthread_mutex_unlock(&q->lock);
+}
+
+/** Hash items from the queue until none are left.  Small files are read
+ * whole and submitted to a multi-buffer manager, so that while one file is
+ * being read the lanes hold the files read before it. */
+static void* hash_worker(void* arg)
+{
+        struct work_queue* q = (struct work_queue*)arg;
+        struct sha256_mb_mgr mgr;
+        struct sha256_mb_job job[SHA256_MB_MAX_LANES];
+        unsigned char* data[SHA256_MB_MAX_LANES];
+        size_t cap[SHA256_MB_MAX_LANES];
+        unsigned free_slot[SHA256_MB_MAX_LANES];
+        unsigned num_free, slot;
+        unsigned char* buffer = alloc_read_buffer();
+        struct sha256_mb_job* done;
+        struct work_item* item;
+        struct stat st;
+        ssize_t len;
+        size_t i;
+        int fd;
+
+        sha256_mb_init(&mgr);
+        for (slot = 0; slot < SHA256_MB_MAX_LANES; ++slot) {
+                data[slot] = NULL;
+                cap[slot] = 0;
+                free_slot[slot] = slot;
+        }
+        num_free = mgr.lanes;
+
+        while (1) {
+                pthread_mutex_lock(&q->lock);
+                i = q->next < q->count ? q->next++ : q->count;
+                pthread_mutex_unlock(&q->lock);
+                if (i == q->count) {
+                        break;
+                }
+                item = &q->items[i];
+                if ((fd = open_file(item->name, &st)) < 0) {
+                        finish_item(q, item, errno);
+                        continue;
+                }
+                if (fd == STDIN_FILENO || !S_ISREG(st.st_mode) || (size_t)st.st_size > SMALL_FILE_MAX) {
+                        int err = hash_fd(fd, &st, &item->hash, buffer) < 0 ? errno : 0;
+                        close_file(fd);
+                        finish_item(q, item, err);
+                        continue;
+                }
+                slot = free_slot[--num_free];
+                len = read_whole(fd, &data[slot], &cap[slot], (size_t)st.st_size);
+                if (len < 0) {
+                        int err = errno;
+                        close_file(fd);
+                        free_slot[num_free++] = slot;
+                        finish_item(q, item, err);
+                        continue;
+                }
+                close_file(fd);
+                job[slot].data = data[slot];
+                job[slot].len = (size_t)len;
+                job[slot].user_data = item;
+                /* The manager only returns a job once every lane is busy, so
+                 * a slot is free whenever the loop comes round again. */
+                if ((done = sha256_mb_submit(&mgr, &job[slot]))) {
+                        item = (struct work_item*)done->user_data;
+                        item->hash = done->hash;
+                        free_slot[num_free++] = (unsigned)(done - job);
+                        finish_item(q, item, 0);
+                }
+        }
+        while ((done = sha256_mb_flush(&mgr))) {
+                item = (struct work_item*)done->user_data;
+                item->hash = done->hash;
+                finish_item(q, item, 0);
+        }
+
+        for (slot = 0; slot < SHA256_MB_MAX_LANES; ++slot) {
+                free(data[slot]);
+        }
+        free(buffer);
+        return NULL;
+}
+
+/** Hash every item, calling report() on each in order as soon as it and all
+ * the items before it are finished.  Without --jobs the items are hashed one
+ * after another by the calling thread. */
+static void hash_items(struct work_item* items, size_t count, void (*report)(struct work_item*, size_t, void*), void* ctx)
+{
+        struct work_queue q;
+        pthread_t* threads;
+        long nthreads = jobs, started = 0, t;
+        size_t i;
+
+        if (jobs < 0) {
+                unsigned char* buffer = alloc_read_buffer();
+                for (i = 0; i < count; ++i) {
+                        items[i].err = hash_file(items[i].name, &items[i].hash, buffer) < 0 ? errno : 0;
+                        report(&items[i], i, ctx);
+                }
+                free(buffer);
+                return;
+        }
+
+        if (nthreads == 0) {
+                nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        if (nthreads < 1) {
+                nthreads = 1;
+        }
+        if ((size_t)nthreads > count) {
+                nthreads = (long)count;
+        }
+        q.items = items;
+        q.count = count;
+        q.next = 0;
+        pthread_mutex_init(&q.lock, NULL);
+        pthread_cond_init(&q.cond, NULL);
+        for (i = 0; i < count; ++i) {
+                items[i].done = 0;
+        }
+        threads = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+        for (t = 0; threads && t < nthreads; ++t) {
+                if (pthread_create(&threads[started], NULL, hash_worker, &q)) {
+                        break;
+                }
+                ++started;
+        }
+        if (!started) {
+                hash_worker(&q);
+        }
+
+        for (i = 0; i < count; ++i) {
+                pthread_mutex_lock(&q.lock);
+                while (!items[i].done) {
+                        pthread_cond_wait(&q.cond, &q.lock);
+                }
+                pthread_mutex_unlock(&q.lock);
+                report(&items[i], i, ctx);
+        }
+
+        for (t = 0; t < started; ++t) {
+                pthread_join(threads[t], NULL);
+        }
+        free(threads);
+        pthread_cond_destroy(&q.cond);
+        pthread_mutex_destroy(&q.lock);
+}
+
+/** Print a file name, escaping backslashes and line breaks as coreutils
+ * does. */
+static void print_name(const char* name, int escape)
+{
+        if (!escape) {
+                fputs(name, stdout);
+                return;
+        }
+        for (; *name; ++name) {
+                switch (*name) {
+                case '\\': fputs("\\\\", stdout); break;
+                case '\n': fputs("\\n", stdout); break;
+                case '\r': fputs("\\r", stdout); break;
+                default: putchar(*name); break;
+                }
+        }
+}
+
+static int needs_escape(const char* name)
+{
+        return strpbrk(name, "\\\n\r") != NULL;
+}
+
+static void print_hash(const struct sha256* hash, const char* name)
+{
+        static const char digits[] = "0123456789abcdef";
+        char hex[65];
+        int escape = needs_escape(name);
+        int i;
+        for (i = 0; i < 32; ++i) {
+                hex[2 * i] = digits[hash->u8[i] >> 4];
+                hex[2 * i + 1] = digits[hash->u8[i] & 15];
+        }
+        hex[64] = '\0';
+        if (escape) {
+                putchar('\\');
+        }
+        if (bsd_tag) {
+                fputs("SHA256 (", stdout);
+                print_name(name, escape);
+                printf(") = %s\n", hex);
+        } else {
+                printf("%s %c", hex, binary_mode ? '*' : ' ');
+                print_name(name, escape);
+                putchar('\n');
+        }
+}
+
+static int hex_value(int c)
+{
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+}
+
+/** Parse 64 hex digits into a hash, returning zero if they are invalid. */
+static int parse_hex(const char* hex, struct sha256* hash)
+{
+        int i, hi, lo;
+        for (i = 0; i < 32; ++i) {
+                hi = hex_value(hex[2 * i]);
+                lo = hi < 0 ? -1 : hex_value(hex[2 * i + 1]);
+                if (lo < 0) {
+                        return 0;
+                }
+                hash->u8[i] = (unsigned char)(hi << 4 | lo);
+        }
+        return !0;
+}
+
+/** Undo the escaping of print_name() in place, returning zero if the name
+ * contains an invalid escape sequence. */
+static int unescape_name(char* name)
+{
+        char* out = name;
+        for (; *name; ++name) {
+                if (*name != '\\') {
+                        *out++ = *name;
+                        continue;
+                }
+                switch (*++name) {
+                case '\\': *out++ = '\\'; break;
+                case 'n': *out++ = '\n'; break;
+                case 'r': *out++ = '\r'; break;
+                default: return 0;
+                }
+        }
+        *out = '\0';
+        return !0;
+}
+
+/** Split a line of a checksum file, in either the GNU or BSD format, into
+ * the expected hash and the file name.  Returns NULL if the line is not
+ * properly formatted. */
+static char* parse_line(char* line, struct sha256* hash)
+{
+        int escaped = 0;
+        char* name;
+        size_t len = strlen(line);
+        while (len && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+                line[--len] = '\0';
+        }
+        if (*line == '\\') {
+                escaped = !0;
+                ++line;
+                --len;
+        }
+        if (!strncmp(line, "SHA256 (", 8)) {
+                char* end = len >= 8 + 4 + 64 ? line + len - 64 - 4 : NULL;
+                if (!end || strncmp(end, ") = ", 4) || !parse_hex(end + 4, hash)) {
+                        return NULL;
+                }
+                *end = '\0';
+                name = line + 8;
+        } else {
+                if (len < 64 + 2 + 1 || line[64] != ' ' || (line[65] != ' ' && line[65] != '*') || !parse_hex(line, hash)) {
+                        return NULL;
+                }
+                name = line + 66;
+        }
+        if (escaped && !unescape_name(name)) {
+                return NULL;
+        }
+        return name;
+}
+
+/** The state of checking one list of checksums. */
+struct check_state {
+        struct sha256* expected;
+        unsigned long verified;
+        unsigned long bad_reads;
+        unsigned long bad_hashes;
+};
+
+static void report_check(struct work_item* item, size_t i, void* ctx)
+{
+        struct check_state* state = (struct check_state*)ctx;
+        int escape = needs_escape(item->name);
+        int ok;
+        if (item->err) {
+                if (ignore_missing && item->err == ENOENT) {
+                        return;
+                }
+                fprintf(stderr, "%s: %s: %s\n", PROGRAM_NAME, item->name, strerror(item->err));
+                ++state->bad_reads;
+                if (!status_only) {
+                        if (escape) putchar('\\');
+                        print_name(item->name, escape);
+                        printf(": FAILED open or read\n");
+                }
+                return;
+        }
+        ok = !memcmp(&state->expected[i], &item->hash, sizeof(item->hash));
+        if (ok) {
+                ++state->verified;
+        } else {
+                ++state->bad_hashes;
+        }
+        if (!status_only && (!ok || !quiet)) {
+                if (escape) putchar('\\');
+                print_name(item->name, escape);
+                printf(": %s\n", ok ? "OK" : "FAILED");
+        }
+}
+
+/** Verify the checksums listed in the named file, returning non-zero if they
+ * all match.  The whole list is parsed before any files are hashed, so that
+ * with --jobs they can be hashed in parallel. */
+static int check_file(const char* list)
+{
+        FILE* fp = strcmp(list, "-") ? fopen(list, "r") : stdin;
+        char* line = NULL;
+        size_t cap = 0;
+        unsigned long lineno = 0;
+        unsigned long bad_lines = 0;
+        const char* display = strcmp(list, "-") ? list : "standard input";
+        struct check_state state;
+        struct work_item* items = NULL;
+        size_t count = 0, alloc = 0, i;
+        int read_error;
+
+        if (!fp) {
+                fprintf(stderr, "%s: %s: %s\n", PROGRAM_NAME, list, strerror(errno));
+                return 0;
+        }
+        state.expected = NULL;
+        state.verified = 0;
+        state.bad_reads = 0;
+        state.bad_hashes = 0;
+        while (getline(&line, &cap, fp) >= 0) {
+                struct sha256 expected;
+                char* name;
+                ++lineno;
+                if (line[0] == '#') {
+                        continue;
+                }
+                if (!(name = parse_line(line, &expected))) {
+                        ++bad_lines;
+                        if (warn) {
+                                fprintf(stderr, "%s: %s: %lu: improperly formatted SHA256 checksum line\n", PROGRAM_NAME, display, lineno);
+                        }
+                        continue;
+                }
+                if (count == alloc) {
+                        alloc = alloc ? 2 * alloc : 64;
+                        items = (struct work_item*)realloc(items, alloc * sizeof(*items));
+                        state.expected = (struct sha256*)realloc(state.expected, alloc * sizeof(*state.expected));
+                        if (!items || !state.expected) {
+                                fprintf(stderr, "%s: %s\n", PROGRAM_NAME, strerror(ENOMEM));
+                                exit(EXIT_FAILURE);
+                        }
+                }
+                if (!(items[count].name = strdup(name))) {
+                        fprintf(stderr, "%s: %s\n", PROGRAM_NAME, strerror(ENOMEM));
+                        exit(EXIT_FAILURE);
+                }
+                state.expected[count] = expected;
+                ++count;
+        }
+        free(line);
+        read_error = ferror(fp);
+        if (fp != stdin) {
+                fclose(fp);
+        }
+
+        hash_items(items, count, report_check, &state);
+        for (i = 0; i < count; ++i) {
+                free((char*)items[i].name);
+        }
+        free(items);
+        free(state.expected);
+
+        if (read_error) {
+                fprintf(stderr, "%s: %s: read error\n", PROGRAM_NAME, display);
+                ++state.bad_reads;
+        }
+        if (!count) {
+                fprintf(stderr, "%s: %s: no properly formatted SHA256 checksum lines found\n", PROGRAM_NAME, display);
+                return 0;
+        }
+        if (!status_only) {
+                /* The results went to stdout, which may be buffered apart
+                 * from stderr, so print them before the summary. */
+                fflush(stdout);
+                if (bad_lines) {
+                        fprintf(stderr, "%s: WARNING: %lu line%s improperly formatted\n", PROGRAM_NAME, bad_lines, bad_lines == 1 ? " is" : "s are");
+                }
+                if (state.bad_reads) {
+                        fprintf(stderr, "%s: WARNING: %lu listed file%s could not be read\n", PROGRAM_NAME, state.bad_reads, state.bad_reads == 1 ? "" : "s");
+                }
+                if (state.bad_hashes) {
+                        fprintf(stderr, "%s: WARNING: %lu computed checksum%s did NOT match\n", PROGRAM_NAME, state.bad_hashes, state.bad_hashes == 1 ? "" : "s");
+                }
+                /* With --ignore-missing, a list whose files are all missing
+                 * verifies nothing, which is not a success. */
+                if (ignore_missing && !state.verified) {
+                        fprintf(stderr, "%s: %s: no file was verified\n", PROGRAM_NAME, display);
+                }
+        }
+        return state.verified && !state.bad_reads && !state.bad_hashes && !(strict && bad_lines);
+}
+
+static void report_hash(struct work_item* item, size_t i, void* ctx)
+{
+        int* exit_code = (int*)ctx;
+        (void)i;
+        if (item->err) {
+                fprintf(stderr, "%s: %s: %s\n", PROGRAM_NAME, item->name, strerror(item->err));
+                *exit_code = EXIT_FAILURE;
+        } else {
+                print_hash(&item->hash, item->name);
+        }
+}
+
+int main(int argc, char *argv[])
+{
+        static const char* const stdin_only[] = { "-" };
+        const char* const* files;
+        int num_files, check = 0, exit_code = EXIT_SUCCESS;
+        int c, i;
+        char* end;
+
+        while ((c = getopt_long(argc, argv, "bcj:tw", long_options, NULL)) != -1) {
+                switch (c) {
+                case 'b': binary_mode = !0; break;
+                case 'c': check = !0; break;
+                case 'j':
+                        jobs = strtol(optarg, &end, 10);
+                        if (!*optarg || *end || jobs < 0) {
+                                fprintf(stderr, "%s: invalid number of jobs: '%s'\n", PROGRAM_NAME, optarg);
+                                usage(EXIT_FAILURE);
+                        }
+                        break;
+                case 't': binary_mode = 0; break;
+                case 'w': warn = !0; break;
+                case IGNORE_MISSING_OPTION: ignore_missing = !0; break;
+                case QUIET_OPTION: quiet = !0; break;
+                case STATUS_OPTION: status_only = !0; break;
+                case STRICT_OPTION: strict = !0; break;
+                case TAG_OPTION: bsd_tag = !0; break;
+                case HELP_OPTION: usage(EXIT_SUCCESS); break;
+                case VERSION_OPTION:
+#if defined(PACKAGE_VERSION)
+                        printf("%s (libsha2) %s\n", PROGRAM_NAME, PACKAGE_VERSION);
+#else
+                        printf("%s (libsha2)\n", PROGRAM_NAME);
+#endif
+                        printf("Using SHA256 algorithm: %s\n", sha256_auto_detect());
+                        return EXIT_SUCCESS;
+                default: usage(EXIT_FAILURE); break;
+                }
+        }
+        if (check && bsd_tag) {
+                fprintf(stderr, "%s: the --tag option is meaningless when verifying checksums\n", PROGRAM_NAME);
+                usage(EXIT_FAILURE);
+        }
+        if (!check && (ignore_missing || quiet || status_only || strict || warn)) {
+                fprintf(stderr, "%s: the --ignore-missing, --quiet, --status, --strict and --warn options are meaningful only when verifying checksums\n", PROGRAM_NAME);
+                usage(EXIT_FAILURE);
+        }
+
+        if (optind < argc) {
+                files = (const char* const*)&argv[optind];
+                num_files = argc - optind;
+        } else {
+                files = stdin_only;
+                num_files = 1;
+        }
+        if (check) {
+                for (i = 0; i < num_files; ++i) {
+                        if (!check_file(files[i])) {
+                                exit_code = EXIT_FAILURE;
+                        }
+                }
+        } else {
+                struct work_item* items = (struct work_item*)malloc(num_files * sizeof(*items));
+                if (!items) {
+                        fprintf(stderr, "%s: %s\n", PROGRAM_NAME, strerror(ENOMEM));
+                        return EXIT_FAILURE;
+                }
+                for (i = 0; i < num_files; ++i) {
+                        items[i].name = files[i];
+                }
+                hash_items(items, num_files, report_hash, &exit_code);
+                free(items);
+        }
+
+        if (fflush(stdout) || ferror(stdout)) {
+                fprintf(stderr, "%s: write error\n", PROGRAM_NAME);
+                exit_code = EXIT_FAILURE;
+        }
         return exit_code;
 }
 
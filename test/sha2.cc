@@ -7,7 +7,20 @@
 
 #include <gtest/gtest.h>
 
+#include <sha2/hmac_sha256.h>
+#include <sha2/pbkdf2_sha256.h>
 #include <sha2/sha256.h>
+#include <sha2/sha512.h>
+#include <sha2/tagged_sha256.h>
+#include "sha512_internal.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST(gtest, assert_eq)
 {
@@ -114,6 +127,980 @@ TEST(sha2, self_test)
         }
 }
 
+/* Reference double-SHA256 of a 64-byte message, using the streaming API. */
+static void double64_reference(struct sha256* out, const struct sha256 in[2])
+{
+        struct sha256_ctx ctx = SHA256_INIT;
+        sha256_update(&ctx, in, 64);
+        sha256_done(out, &ctx);
+        sha256_init(&ctx);
+        sha256_update(&ctx, out, 32);
+        sha256_done(out, &ctx);
+}
+
+TEST(sha2, double64)
+{
+        /* Enough blocks to exercise every multi-lane kernel plus remainders. */
+        static const size_t max_blocks = 40;
+        struct sha256 in[2 * max_blocks];
+        struct sha256 out[max_blocks];
+        struct sha256 expected[max_blocks];
+
+        sha256_auto_detect();
+
+        for (size_t i = 0; i < 2 * max_blocks; ++i) {
+                for (size_t j = 0; j < 32; ++j) {
+                        in[i].u8[j] = (unsigned char)(i * 7 + j * 13);
+                }
+        }
+        for (size_t i = 0; i < max_blocks; ++i) {
+                double64_reference(&expected[i], &in[2 * i]);
+        }
+        for (size_t n = 0; n <= max_blocks; ++n) {
+                memset(out, 0, sizeof(out));
+                sha256_double64(out, in, n);
+                ASSERT_EQ(memcmp(out, expected, 32 * n), 0) << "blocks=" << n;
+        }
+}
+
+TEST(sha2, double64_meets_target)
+{
+        static const size_t max_blocks = 40;
+        struct sha256 in[2 * max_blocks];
+        struct sha256 hashes[max_blocks];
+        struct sha256 targets[5];
+        unsigned char bitmap[(max_blocks + 7) / 8];
+
+        sha256_auto_detect();
+
+        for (size_t i = 0; i < 2 * max_blocks; ++i) {
+                for (size_t j = 0; j < 32; ++j) {
+                        in[i].u8[j] = (unsigned char)(i * 5 + j * 17);
+                }
+        }
+        for (size_t i = 0; i < max_blocks; ++i) {
+                double64_reference(&hashes[i], &in[2 * i]);
+        }
+        /* No hash, every hash, about half, and two targets with the same most
+         * significant word as one of the hashes, which only the comparison
+         * in full tells apart: the hash itself, and one less. */
+        memset(targets, 0, sizeof(targets));
+        memset(targets[1].u8, 0xff, 32);
+        targets[2].u8[31] = 0x80;
+        targets[3] = targets[4] = hashes[37];
+        for (size_t j = 0; targets[4].u8[j]-- == 0; ++j)
+                ;
+        ASSERT_EQ(memcmp(targets[4].u8 + 28, hashes[37].u8 + 28, 4), 0);
+
+        for (size_t t = 0; t < 5; ++t) {
+                for (size_t n = 0; n <= max_blocks; ++n) {
+                        size_t expected = 0;
+                        memset(bitmap, 0xff, sizeof(bitmap));
+                        size_t passed = sha256_double64_meets_target(bitmap, in, n, &targets[t]);
+                        for (size_t i = 0; i < n; ++i) {
+                                /* Compare as little-endian numbers. */
+                                bool pass = !std::lexicographical_compare(std::rbegin(targets[t].u8), std::rend(targets[t].u8), std::rbegin(hashes[i].u8), std::rend(hashes[i].u8));
+                                ASSERT_EQ((bitmap[i / 8] >> (i % 8)) & 1, pass ? 1 : 0) << "target=" << t << " n=" << n << " i=" << i;
+                                expected += pass;
+                        }
+                        for (size_t i = n; i < 8 * ((n + 7) / 8); ++i) {
+                                ASSERT_EQ((bitmap[i / 8] >> (i % 8)) & 1, 0) << "target=" << t << " n=" << n << " i=" << i;
+                        }
+                        ASSERT_EQ(passed, expected) << "target=" << t << " n=" << n;
+                }
+        }
+        ASSERT_EQ(sha256_double64_meets_target(bitmap, in, max_blocks, &targets[0]), 0u);
+        ASSERT_EQ(sha256_double64_meets_target(bitmap, in, max_blocks, &targets[1]), max_blocks);
+        ASSERT_EQ(sha256_double64_meets_target(bitmap, in, max_blocks, &targets[3]) - sha256_double64_meets_target(bitmap, in, max_blocks, &targets[4]), 1u);
+        ASSERT_EQ((bitmap[37 / 8] >> (37 % 8)) & 1, 0);
+}
+
+TEST(sha2, double_batch)
+{
+        /* Lengths around the one- and two-block padding boundaries, and
+         * transactions several kilobytes long mixed in with short ones. */
+        static const size_t count = 100;
+        std::vector<unsigned char> data(8192 + 16);
+        std::vector<const void*> ptrs(count);
+        std::vector<size_t> lens(count);
+        std::vector<struct sha256> out(count);
+
+        sha256_auto_detect();
+
+        for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = (unsigned char)(i * 29 + 5);
+        }
+        for (size_t i = 0; i < count; ++i) {
+                ptrs[i] = data.data() + i % 13;
+                lens[i] = i < 70 ? i : i % 5 ? 60 + (i * 37) % 300 : (i * 997) % 8192;
+        }
+        for (size_t n = 0; n <= count; n += n < 20 ? 1 : 17) {
+                std::fill(out.begin(), out.end(), sha256());
+                sha256_double_batch(out.data(), ptrs.data(), lens.data(), n);
+                for (size_t i = 0; i < count; ++i) {
+                        struct sha256_ctx ctx = SHA256_INIT;
+                        struct sha256 expected = {};
+                        if (i < n) {
+                                sha256_update(&ctx, ptrs[i], lens[i]);
+                                sha256_done(&expected, &ctx);
+                                sha256_init(&ctx);
+                                sha256_update(&ctx, &expected, 32);
+                                sha256_done(&expected, &ctx);
+                        }
+                        ASSERT_EQ(memcmp(&out[i], &expected, 32), 0) << "n=" << n << " len=" << lens[i];
+                }
+        }
+}
+
+TEST(sha2, midstate)
+{
+        static const size_t max_blocks = 40;
+        unsigned char prefix[64];
+        unsigned char in[64 * max_blocks];
+        struct sha256 out[max_blocks];
+        struct sha256 expected[max_blocks];
+        struct sha256_ctx mid = SHA256_INIT;
+
+        sha256_auto_detect();
+
+        for (size_t i = 0; i < sizeof(prefix); ++i) {
+                prefix[i] = (unsigned char)(255 - i);
+        }
+        for (size_t i = 0; i < sizeof(in); ++i) {
+                in[i] = (unsigned char)(i * 31 + 5);
+        }
+        sha256_update(&mid, prefix, sizeof(prefix));
+        for (size_t i = 0; i < max_blocks; ++i) {
+                struct sha256_ctx ctx = mid;
+                sha256_update(&ctx, in + 64 * i, 64);
+                for (int j = 0; j < 8; ++j) {
+                        expected[i].u8[4 * j + 0] = (unsigned char)(ctx.s[j] >> 24);
+                        expected[i].u8[4 * j + 1] = (unsigned char)(ctx.s[j] >> 16);
+                        expected[i].u8[4 * j + 2] = (unsigned char)(ctx.s[j] >> 8);
+                        expected[i].u8[4 * j + 3] = (unsigned char)(ctx.s[j]);
+                }
+        }
+        for (size_t n = 0; n <= max_blocks; ++n) {
+                memset(out, 0, sizeof(out));
+                sha256_midstate(out, mid.s, in, n);
+                ASSERT_EQ(memcmp(out, expected, 32 * n), 0) << "blocks=" << n;
+        }
+}
+
+/* A straightforward level-by-level Merkle root, after Bitcoin Core's
+ * ComputeMerkleRoot(). */
+static struct sha256 merkle_root_reference(std::vector<struct sha256> hashes, bool* mutated)
+{
+        struct sha256 root = {};
+        *mutated = false;
+        while (hashes.size() > 1) {
+                for (size_t pos = 0; pos + 1 < hashes.size(); pos += 2) {
+                        if (!memcmp(&hashes[pos], &hashes[pos + 1], 32)) {
+                                *mutated = true;
+                        }
+                }
+                if (hashes.size() & 1) {
+                        hashes.push_back(hashes.back());
+                }
+                for (size_t i = 0; i < hashes.size() / 2; ++i) {
+                        double64_reference(&hashes[i], &hashes[2 * i]);
+                }
+                hashes.resize(hashes.size() / 2);
+        }
+        if (!hashes.empty()) {
+                root = hashes[0];
+        }
+        return root;
+}
+
+TEST(sha2, merkle_root)
+{
+        sha256_auto_detect();
+
+        for (size_t count = 0; count <= 1100; count += (count < 100 ? 1 : 97)) {
+                std::vector<struct sha256> leaves(count);
+                for (size_t i = 0; i < count; ++i) {
+                        for (size_t j = 0; j < 32; ++j) {
+                                leaves[i].u8[j] = (unsigned char)(i * 3 + j * 5 + (i >> 8));
+                        }
+                }
+                bool mutated;
+                struct sha256 expected = merkle_root_reference(leaves, &mutated);
+                ASSERT_FALSE(mutated) << "count=" << count;
+
+                std::vector<struct sha256> hashes(leaves);
+                struct sha256 root;
+                sha256_merkle_root(&root, hashes.data(), count);
+                ASSERT_EQ(memcmp(&root, &expected, 32), 0) << "count=" << count;
+
+                hashes = leaves;
+                ASSERT_EQ(sha256_merkle_root_mutated(&root, hashes.data(), count), 0) << "count=" << count;
+                ASSERT_EQ(memcmp(&root, &expected, 32), 0) << "count=" << count;
+
+                /* Duplicating the trailing leaf of an odd-length list leaves
+                 * the root unchanged, but is detected. */
+                if (count & 1 && count > 1) {
+                        hashes = leaves;
+                        hashes.push_back(leaves.back());
+                        ASSERT_NE(sha256_merkle_root_mutated(&root, hashes.data(), count + 1), 0) << "count=" << count;
+                        ASSERT_EQ(memcmp(&root, &expected, 32), 0) << "count=" << count;
+                }
+        }
+}
+
+static std::string hex(const unsigned char* p, size_t len)
+{
+        static const char digits[] = "0123456789abcdef";
+        std::string ret;
+        for (size_t i = 0; i < len; ++i) {
+                ret += digits[p[i] >> 4];
+                ret += digits[p[i] & 15];
+        }
+        return ret;
+}
+
+/* Whether a block header's hash meets the target encoded in its nBits, after
+ * Bitcoin Core's arith_uint256::SetCompact() and CheckProofOfWork(), without
+ * the check against the proof-of-work limit. */
+static bool header_meets_target_reference(const unsigned char* header, const struct sha256* hash)
+{
+        uint32_t bits = header[72] | header[73] << 8 | header[74] << 16 | (uint32_t)header[75] << 24;
+        int size = bits >> 24;
+        uint32_t word = bits & 0x007fffff;
+        unsigned char target[32] = {}; /* little-endian */
+        if (size <= 3) {
+                word >>= 8 * (3 - size);
+                target[0] = word & 0xff;
+                target[1] = (word >> 8) & 0xff;
+                target[2] = (word >> 16) & 0xff;
+        } else {
+                for (int i = 0; i < 3; ++i) {
+                        if (size - 3 + i < 32) {
+                                target[size - 3 + i] = (word >> (8 * i)) & 0xff;
+                        }
+                }
+        }
+        bool negative = word != 0 && (bits & 0x00800000) != 0;
+        bool overflow = word != 0 && (size > 34 || (word > 0xff && size > 33) || (word > 0xffff && size > 32));
+        if (negative || overflow || word == 0) {
+                return false;
+        }
+        for (int i = 31; i >= 0; --i) {
+                if (hash->u8[i] != target[i]) {
+                        return hash->u8[i] < target[i];
+                }
+        }
+        return true;
+}
+
+TEST(sha2, check_headers)
+{
+        /* The genesis block of the Bitcoin main network. */
+        static const unsigned char genesis[80] = {
+                0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x3b, 0xa3, 0xed, 0xfd, 0x7a, 0x7b, 0x12, 0xb2, 0x7a, 0xc7, 0x2c, 0x3e,
+                0x67, 0x76, 0x8f, 0x61, 0x7f, 0xc8, 0x1b, 0xc3, 0x88, 0x8a, 0x51, 0x32, 0x3a, 0x9f, 0xb8, 0xaa,
+                0x4b, 0x1e, 0x5e, 0x4a, 0x29, 0xab, 0x5f, 0x49, 0xff, 0xff, 0x00, 0x1d, 0x1d, 0xac, 0x2b, 0x7c
+        };
+        /* A mix of targets met by about half of all hashes, by none, and
+         * encodings which are negative, zero or overflow. */
+        static const uint32_t bits[] = {
+                0x207fffff, 0x207fffff, 0x1d00ffff, 0x20800001, 0x03000000, 0x01003456,
+                0x2300ffff, 0x2200ffff, 0x22000001, 0x21008000, 0x20800000, 0x207fffff
+        };
+        static const size_t max_headers = 40;
+        unsigned char headers[80 * max_headers];
+        struct sha256 hashes[max_headers];
+        unsigned char bitmap[(max_headers + 7) / 8];
+        struct sha256 hash;
+
+        sha256_auto_detect();
+
+        ASSERT_EQ(sha256_check_headers(bitmap, &hash, genesis, 1), 1u);
+        ASSERT_EQ(bitmap[0], 1);
+        ASSERT_EQ(hex(hash.u8, 32), "6fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000");
+
+        memcpy(headers, genesis, 80);
+        headers[76] ^= 1;
+        ASSERT_EQ(sha256_check_headers(bitmap, NULL, headers, 1), 0u);
+        ASSERT_EQ(bitmap[0], 0);
+
+        for (size_t i = 0; i < max_headers; ++i) {
+                for (size_t j = 0; j < 72; ++j) {
+                        headers[80 * i + j] = (unsigned char)(i * 11 + j * 7);
+                }
+                uint32_t b = bits[i % (sizeof(bits) / sizeof(bits[0]))];
+                for (size_t j = 0; j < 4; ++j) {
+                        headers[80 * i + 72 + j] = (unsigned char)(b >> (8 * j));
+                        headers[80 * i + 76 + j] = (unsigned char)(i >> (8 * j));
+                }
+        }
+        for (size_t n = 0; n <= max_headers; ++n) {
+                size_t expected = 0;
+                memset(hashes, 0, sizeof(hashes));
+                memset(bitmap, 0xff, sizeof(bitmap));
+                size_t passed = sha256_check_headers(bitmap, hashes, headers, n);
+                for (size_t i = 0; i < n; ++i) {
+                        struct sha256 single;
+                        struct sha256_ctx ctx = SHA256_INIT;
+                        sha256_update(&ctx, headers + 80 * i, 80);
+                        sha256_done(&single, &ctx);
+                        sha256_init(&ctx);
+                        sha256_update(&ctx, single.u8, 32);
+                        sha256_done(&single, &ctx);
+                        ASSERT_EQ(memcmp(&hashes[i], &single, 32), 0) << "n=" << n << " i=" << i;
+                        bool pass = header_meets_target_reference(headers + 80 * i, &single);
+                        ASSERT_EQ((bitmap[i / 8] >> (i % 8)) & 1, pass ? 1 : 0) << "n=" << n << " i=" << i;
+                        expected += pass;
+                }
+                for (size_t i = n; i < 8 * ((n + 7) / 8); ++i) {
+                        ASSERT_EQ((bitmap[i / 8] >> (i % 8)) & 1, 0) << "n=" << n << " i=" << i;
+                }
+                ASSERT_EQ(passed, expected) << "n=" << n;
+                /* Without hashes to return, only those of the headers which
+                 * may meet their target are computed in full. */
+                unsigned char bitmap2[sizeof(bitmap)];
+                memset(bitmap2, 0xff, sizeof(bitmap2));
+                ASSERT_EQ(sha256_check_headers(bitmap2, NULL, headers, n), expected) << "n=" << n;
+                ASSERT_EQ(memcmp(bitmap, bitmap2, (n + 7) / 8), 0) << "n=" << n;
+                if (n == max_headers) {
+                        ASSERT_GT(expected, 0u);
+                        ASSERT_LT(expected, n / 2);
+                }
+        }
+}
+
+TEST(sha2, grind)
+{
+        /* The genesis block of the Bitcoin main network, found among its
+         * neighbouring nonces. */
+        static const unsigned char genesis[80] = {
+                0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x3b, 0xa3, 0xed, 0xfd, 0x7a, 0x7b, 0x12, 0xb2, 0x7a, 0xc7, 0x2c, 0x3e,
+                0x67, 0x76, 0x8f, 0x61, 0x7f, 0xc8, 0x1b, 0xc3, 0x88, 0x8a, 0x51, 0x32, 0x3a, 0x9f, 0xb8, 0xaa,
+                0x4b, 0x1e, 0x5e, 0x4a, 0x29, 0xab, 0x5f, 0x49, 0xff, 0xff, 0x00, 0x1d, 0x00, 0x00, 0x00, 0x00
+        };
+        struct sha256_ctx ctx = SHA256_INIT;
+        struct sha256 target = {};
+        unsigned char tail[64] = {};
+        uint32_t nonces[64];
+
+        sha256_auto_detect();
+
+        sha256_update(&ctx, genesis, 64);
+        memcpy(tail, genesis + 64, 16);
+        tail[16] = 0x80;
+        tail[62] = 0x02;
+        tail[63] = 0x80;
+        target.u8[26] = target.u8[27] = 0xff;
+        ASSERT_EQ(sha256_grind(nonces, 64, ctx.s, tail, 12, 2083236893 - 100, 200, &target, 1), 1u);
+        ASSERT_EQ(nonces[0], 2083236893u);
+
+        /* Other messages, with the nonce in different words and wrapping
+         * around, against about one hash in 16. */
+        sha256_init(&ctx);
+        for (size_t i = 0; i < 64; ++i) {
+                tail[i] = (unsigned char)(i * 29 + 3);
+        }
+        sha256_update(&ctx, tail, 64);
+        memset(target.u8, 0xff, 32);
+        target.u8[31] = 0x0f;
+        for (int twice = 0; twice < 2; ++twice) {
+                for (size_t offset = 0; offset < 64; offset += 12) {
+                        std::vector<uint32_t> expected;
+                        for (uint32_t i = 0; i < 300; ++i) {
+                                unsigned char block[64];
+                                struct sha256 hash;
+                                uint32_t nonce = 0xffffff00u + i;
+                                memcpy(block, tail, 64);
+                                for (size_t j = 0; j < 4; ++j) {
+                                        block[offset + j] = (unsigned char)(nonce >> (8 * j));
+                                }
+                                sha256_midstate(&hash, ctx.s, block, 1);
+                                if (twice) {
+                                        struct sha256_ctx ctx2 = SHA256_INIT;
+                                        sha256_update(&ctx2, hash.u8, 32);
+                                        sha256_done(&hash, &ctx2);
+                                }
+                                /* Compare as little-endian numbers. */
+                                if (!std::lexicographical_compare(std::rbegin(target.u8), std::rend(target.u8), std::rbegin(hash.u8), std::rend(hash.u8))) {
+                                        expected.push_back(nonce);
+                                }
+                        }
+                        size_t found = sha256_grind(nonces, 64, ctx.s, tail, offset, 0xffffff00u, 300, &target, twice);
+                        ASSERT_EQ(found, expected.size()) << "twice=" << twice << " offset=" << offset;
+                        ASSERT_GT(found, 2u);
+                        ASSERT_EQ(memcmp(nonces, expected.data(), 4 * found), 0) << "twice=" << twice << " offset=" << offset;
+                        ASSERT_EQ(sha256_grind(nonces, 2, ctx.s, tail, offset, 0xffffff00u, 300, &target, twice), 2u);
+                        ASSERT_EQ(memcmp(nonces, expected.data(), 8), 0);
+                }
+        }
+}
+
+TEST(sha2, sha512)
+{
+        /* Test vectors from FIPS 180-2. */
+        static const char* const messages[3] = {
+                "",
+                "abc",
+                "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+        };
+        static const char* const expected[3][3] = {
+                {"cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e",
+                 "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b",
+                 "c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a"},
+                {"ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+                 "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7",
+                 "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23"},
+                {"8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909",
+                 "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039",
+                 "3928e184fb8690f840da3988121d31be65cb9d3ef83ee6146feac861e19b563a"},
+        };
+
+        sha512_auto_detect();
+
+        for (int i = 0; i < 3; ++i) {
+                size_t len = strlen(messages[i]);
+                struct sha512_ctx ctx;
+                struct sha512 h512;
+                struct sha384 h384;
+                struct sha512_256 h256;
+                sha512_init(&ctx);
+                sha512_update(&ctx, messages[i], len);
+                sha512_done(&h512, &ctx);
+                ASSERT_EQ(hex(h512.u8, 64), expected[i][0]);
+                sha384_init(&ctx);
+                sha512_update(&ctx, messages[i], len);
+                sha384_done(&h384, &ctx);
+                ASSERT_EQ(hex(h384.u8, 48), expected[i][1]);
+                sha512_256_init(&ctx);
+                sha512_update(&ctx, messages[i], len);
+                sha512_256_done(&h256, &ctx);
+                ASSERT_EQ(hex(h256.u8, 32), expected[i][2]);
+        }
+
+        /* The same vectors on every supported backend.  SHA-384 and
+         * SHA-512/256 differ from SHA-512 only in their initial state and
+         * in truncating the result. */
+        for (size_t b = 0; b < sha512_backend_count(); ++b) {
+                if (!sha512_backend_supported(b)) {
+                        continue;
+                }
+                for (int i = 0; i < 3; ++i) {
+                        size_t len = strlen(messages[i]);
+                        struct sha512_ctx ctx;
+                        struct sha512 hash;
+                        sha512_init(&ctx);
+                        sha512_update_backend(b, &ctx, messages[i], len);
+                        sha512_done_backend(b, &hash, &ctx);
+                        ASSERT_EQ(hex(hash.u8, 64), expected[i][0]) << sha512_backend_id(b);
+                        sha384_init(&ctx);
+                        sha512_update_backend(b, &ctx, messages[i], len);
+                        sha512_done_backend(b, &hash, &ctx);
+                        ASSERT_EQ(hex(hash.u8, 48), expected[i][1]) << sha512_backend_id(b);
+                        sha512_256_init(&ctx);
+                        sha512_update_backend(b, &ctx, messages[i], len);
+                        sha512_done_backend(b, &hash, &ctx);
+                        ASSERT_EQ(hex(hash.u8, 32), expected[i][2]) << sha512_backend_id(b);
+                }
+        }
+
+        /* One million repetitions of 'a', fed in uneven pieces so that both
+         * the buffered and the multi-block paths are taken. */
+        {
+                std::vector<unsigned char> data(1000000, 'a');
+                for (size_t b = 0; b < sha512_backend_count(); ++b) {
+                        if (!sha512_backend_supported(b)) {
+                                continue;
+                        }
+                        struct sha512_ctx ctx = SHA512_INIT;
+                        struct sha512 hash;
+                        size_t pos = 0, step = 1;
+                        while (pos < data.size()) {
+                                size_t len = std::min(step, data.size() - pos);
+                                sha512_update_backend(b, &ctx, data.data() + pos, len);
+                                pos += len;
+                                step = step * 3 + 1;
+                        }
+                        sha512_done_backend(b, &hash, &ctx);
+                        ASSERT_EQ(hex(hash.u8, 64), "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b") << sha512_backend_id(b);
+                }
+        }
+}
+
+TEST(sha2, hmac_sha256)
+{
+        /* Test vectors from RFC 4231, omitting the truncated case 5. */
+        static const struct {
+                std::string key;
+                std::string data;
+                const char* mac;
+        } cases[] = {
+                {std::string(20, '\x0b'), "Hi There",
+                 "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+                {"Jefe", "what do ya want for nothing?",
+                 "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"},
+                {std::string(20, '\xaa'), std::string(50, '\xdd'),
+                 "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe"},
+                {"\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19", std::string(50, '\xcd'),
+                 "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b"},
+                {std::string(131, '\xaa'), "Test Using Larger Than Block-Size Key - Hash Key First",
+                 "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"},
+                {std::string(131, '\xaa'), "This is a test using a larger than block-size key and a larger than block-size data. The key needs to be hashed before being used by the HMAC algorithm.",
+                 "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2"},
+        };
+
+        for (const auto& c : cases) {
+                struct hmac_sha256_key key;
+                struct hmac_sha256_ctx ctx;
+                struct sha256 mac;
+                hmac_sha256_key_init(&key, c.key.data(), c.key.size());
+                hmac_sha256(&mac, &key, c.data.data(), c.data.size());
+                ASSERT_EQ(hex(mac.u8, 32), c.mac);
+                hmac_sha256_init(&ctx, &key);
+                for (char ch : c.data) {
+                        hmac_sha256_update(&ctx, &ch, 1);
+                }
+                hmac_sha256_done(&mac, &ctx);
+                ASSERT_EQ(hex(mac.u8, 32), c.mac);
+        }
+
+        /* The one-block shortcut agrees with the general path on either side
+         * of the boundary. */
+        {
+                struct hmac_sha256_key key;
+                unsigned char data[130];
+                for (size_t i = 0; i < sizeof(data); ++i) {
+                        data[i] = (unsigned char)(i * 29 + 5);
+                }
+                hmac_sha256_key_init(&key, "key", 3);
+                for (size_t len = 0; len <= sizeof(data); ++len) {
+                        struct hmac_sha256_ctx ctx;
+                        struct sha256 expected, mac;
+                        hmac_sha256_init(&ctx, &key);
+                        hmac_sha256_update(&ctx, data, len);
+                        hmac_sha256_done(&expected, &ctx);
+                        hmac_sha256(&mac, &key, data, len);
+                        ASSERT_EQ(memcmp(&mac, &expected, 32), 0) << "len=" << len;
+                }
+        }
+
+        /* A batch under several keys, with messages long enough that inner
+         * and outer hashes share the lanes, agrees with one-at-a-time. */
+        {
+                static const size_t num_msgs = 300;
+                struct hmac_sha256_key keys[3];
+                std::vector<unsigned char> data(1024 + 64);
+                std::vector<const struct hmac_sha256_key*> key(num_msgs);
+                std::vector<const void*> msg(num_msgs);
+                std::vector<size_t> len(num_msgs);
+                std::vector<struct sha256> macs(num_msgs);
+                sha256_auto_detect();
+                for (size_t i = 0; i < data.size(); ++i) {
+                        data[i] = (unsigned char)(i * 13 + 7);
+                }
+                hmac_sha256_key_init(&keys[0], "key", 3);
+                hmac_sha256_key_init(&keys[1], data.data(), 64);
+                hmac_sha256_key_init(&keys[2], data.data(), 100);
+                for (size_t i = 0; i < num_msgs; ++i) {
+                        key[i] = &keys[i % 3];
+                        msg[i] = data.data() + i % 5;
+                        len[i] = i < 150 ? i : (i * 331) % 1024;
+                }
+                hmac_sha256_batch(macs.data(), key.data(), msg.data(), len.data(), num_msgs);
+                for (size_t i = 0; i < num_msgs; ++i) {
+                        struct sha256 expected;
+                        hmac_sha256(&expected, key[i], msg[i], len[i]);
+                        ASSERT_EQ(memcmp(&macs[i], &expected, 32), 0) << "i=" << i;
+                }
+                hmac_sha256_batch(macs.data(), key.data(), msg.data(), len.data(), 0);
+        }
+}
+
+TEST(sha2, pbkdf2_sha256)
+{
+        /* The SHA-256 counterparts of the RFC 6070 test vectors, and the
+         * PBKDF2 test vector of RFC 7914. */
+        struct testcase {
+                std::string password;
+                std::string salt;
+                size_t iterations;
+                std::string key;
+        };
+        static const testcase cases[] = {
+                {"password", "salt", 1, "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b"},
+                {"password", "salt", 2, "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43"},
+                {"password", "salt", 4096, "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"},
+                {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096,
+                 "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c4e2a1fb8dd53e1c635518c7dac47e9"},
+                {std::string("pass\0word", 9), std::string("sa\0lt", 5), 4096, "89b69d0516f829893c696226650a8687"},
+                {"passwd", "salt", 1,
+                 "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                 "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"},
+        };
+        for (const auto& c : cases) {
+                std::vector<unsigned char> key(c.key.size() / 2);
+                pbkdf2_hmac_sha256(key.data(), key.size(), c.password.data(), c.password.size(), c.salt.data(), c.salt.size(), c.iterations);
+                ASSERT_EQ(hex(key.data(), key.size()), c.key);
+        }
+
+        /* A batch with more output blocks than any kernel has lanes, and
+         * passwords on either side of the block size, agrees with deriving
+         * each key alone. */
+        {
+                static const size_t num_keys = 37, outlen = 72;
+                std::vector<std::string> passwords(num_keys), salts(num_keys);
+                std::vector<std::vector<unsigned char> > keys(num_keys, std::vector<unsigned char>(outlen));
+                std::vector<unsigned char*> out(num_keys);
+                std::vector<const void*> pw(num_keys), sa(num_keys);
+                std::vector<size_t> pwlen(num_keys), salen(num_keys);
+                for (size_t i = 0; i < num_keys; ++i) {
+                        passwords[i] = std::string(i * 3, (char)('a' + i % 26));
+                        salts[i] = "salt" + std::to_string(i);
+                        out[i] = keys[i].data();
+                        pw[i] = passwords[i].data();
+                        pwlen[i] = passwords[i].size();
+                        sa[i] = salts[i].data();
+                        salen[i] = salts[i].size();
+                }
+                pbkdf2_hmac_sha256_batch(out.data(), outlen, pw.data(), pwlen.data(), sa.data(), salen.data(), num_keys, 3);
+                for (size_t i = 0; i < num_keys; ++i) {
+                        std::vector<unsigned char> expected(outlen);
+                        pbkdf2_hmac_sha256(expected.data(), outlen, pw[i], pwlen[i], sa[i], salen[i], 3);
+                        ASSERT_EQ(keys[i], expected) << "i=" << i;
+                }
+        }
+}
+
+/* Reference BIP340 tagged hash, using the streaming API. */
+static void tagged_reference(struct sha256* out, const std::string& tag, const unsigned char* data, size_t len)
+{
+        struct sha256_ctx ctx = SHA256_INIT;
+        struct sha256 th;
+        sha256_update(&ctx, tag.data(), tag.size());
+        sha256_done(&th, &ctx);
+        sha256_init(&ctx);
+        sha256_update(&ctx, &th, 32);
+        sha256_update(&ctx, &th, 32);
+        sha256_update(&ctx, data, len);
+        sha256_done(out, &ctx);
+}
+
+TEST(sha2, tagged_sha256)
+{
+        static const struct {
+                const char* name;
+                const struct sha256_ctx* ctx;
+        } tags[] = {
+                { "BIP0340/aux", &tagged_sha256_bip340_aux },
+                { "BIP0340/nonce", &tagged_sha256_bip340_nonce },
+                { "BIP0340/challenge", &tagged_sha256_bip340_challenge },
+                { "TapLeaf", &tagged_sha256_tapleaf },
+                { "TapBranch", &tagged_sha256_tapbranch },
+                { "TapTweak", &tagged_sha256_taptweak },
+                { "TapSighash", &tagged_sha256_tapsighash },
+        };
+        static const size_t max_count = 40;
+        unsigned char data[64 * max_count];
+        struct sha256 out[max_count], expected;
+        struct sha256_ctx custom;
+
+        for (size_t i = 0; i < sizeof(data); ++i) {
+                data[i] = (unsigned char)(i * 23 + 7);
+        }
+        for (const auto& tag : tags) {
+                tagged_sha256_init(&custom, tag.name, strlen(tag.name));
+                ASSERT_EQ(memcmp(custom.s, tag.ctx->s, 32), 0) << tag.name;
+                ASSERT_EQ(custom.bytes, 64u) << tag.name;
+                for (size_t len = 0; len <= 130; ++len) {
+                        tagged_reference(&expected, tag.name, data, len);
+                        tagged_sha256(&out[0], tag.ctx, data, len);
+                        ASSERT_EQ(memcmp(&out[0], &expected, 32), 0) << tag.name << " len=" << len;
+                }
+        }
+
+        /* A tag longer than a block, which is registered at runtime. */
+        std::string name(100, 'x');
+        tagged_sha256_init(&custom, name.data(), name.size());
+        for (size_t n = 0; n <= max_count; ++n) {
+                memset(out, 0, sizeof(out));
+                tagged_sha256_batch64(out, &custom, data, n);
+                for (size_t i = 0; i < n; ++i) {
+                        tagged_reference(&expected, name, data + 64 * i, 64);
+                        ASSERT_EQ(memcmp(&out[i], &expected, 32), 0) << "n=" << n << " i=" << i;
+                }
+        }
+}
+
+TEST(sha2, multibuffer)
+{
+        /* Lengths spanning the one- and two-block padding boundaries as well
+         * as messages many blocks long, so that lanes finish out of order. */
+        static const size_t num_jobs = 300;
+        std::vector<unsigned char> data(4096 + 64);
+        std::vector<struct sha256_mb_job> jobs(num_jobs);
+        std::vector<int> done(num_jobs, 0);
+        struct sha256_mb_mgr mgr;
+        struct sha256_mb_job* job;
+
+        sha256_auto_detect();
+
+        for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = (unsigned char)(i * 17 + 3);
+        }
+        for (size_t i = 0; i < num_jobs; ++i) {
+                jobs[i].data = data.data() + i % 7;
+                jobs[i].len = i < 200 ? i : (i * 977) % 4096;
+                jobs[i].user_data = &done[i];
+        }
+        sha256_mb_init(&mgr);
+        for (size_t i = 0; i < num_jobs; ++i) {
+                if ((job = sha256_mb_submit(&mgr, &jobs[i]))) {
+                        ++*(int*)job->user_data;
+                }
+        }
+        while ((job = sha256_mb_flush(&mgr))) {
+                ++*(int*)job->user_data;
+        }
+        for (size_t i = 0; i < num_jobs; ++i) {
+                struct sha256_ctx ctx = SHA256_INIT;
+                struct sha256 expected;
+                sha256_update(&ctx, jobs[i].data, jobs[i].len);
+                sha256_done(&expected, &ctx);
+                ASSERT_EQ(done[i], 1) << "len=" << jobs[i].len;
+                ASSERT_EQ(memcmp(&jobs[i].hash, &expected, 32), 0) << "len=" << jobs[i].len;
+        }
+}
+
+TEST(sha2, backends)
+{
+        /* Every entry point of every supported backend agrees with the
+         * portable backend, at lengths which leave each multi-lane kernel
+         * with a remainder. */
+        static const size_t max_blocks = 40;
+        std::vector<unsigned char> data(64 * max_blocks + 5);
+        std::vector<unsigned char> headers(80 * max_blocks);
+        struct sha256 in[2 * max_blocks], expected[max_blocks], out[max_blocks];
+        struct sha256 targets[3];
+        unsigned char expected_bitmap[(max_blocks + 7) / 8], bitmap[(max_blocks + 7) / 8];
+        uint32_t expected_nonces[64], nonces[64];
+        struct sha256_ctx ctx = SHA256_INIT;
+        struct sha256_backend_info info;
+        struct sha256 hash;
+        size_t supported = 0;
+
+        for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = (unsigned char)(i * 19 + (i >> 8) * 5 + 2);
+        }
+        memcpy(in, data.data(), sizeof(in));
+        /* Headers whose targets are met by about half of all hashes. */
+        for (size_t i = 0; i < max_blocks; ++i) {
+                for (size_t j = 0; j < 72; ++j) {
+                        headers[80 * i + j] = (unsigned char)(i * 11 + j * 7);
+                }
+                for (size_t j = 0; j < 4; ++j) {
+                        headers[80 * i + 72 + j] = (unsigned char)(0x207fffffu >> (8 * j));
+                        headers[80 * i + 76 + j] = (unsigned char)(i >> (8 * j));
+                }
+        }
+        /* No hash, about half, and about one hash in 16. */
+        memset(targets, 0, sizeof(targets));
+        targets[1].u8[31] = 0x80;
+        memset(targets[2].u8, 0xff, 32);
+        targets[2].u8[31] = 0x0f;
+
+        const struct sha256_functions* ref = sha256_backend_functions(sha256_backend_find("noasm"));
+        ASSERT_NE(ref, nullptr);
+        ref->update(&ctx, data.data(), data.size());
+        ref->done(&hash, &ctx);
+        sha256_init(&ctx);
+        ref->update(&ctx, data.data(), 64);
+
+        ASSERT_LT(sha256_backend_selected(), sha256_backend_count());
+        ASSERT_TRUE(sha256_backend_supported(sha256_backend_selected()));
+        ASSERT_EQ(sha256_backend_find("no such backend"), sha256_backend_count());
+        for (size_t b = 0; b < sha256_backend_count(); ++b) {
+                sha256_backend_describe(b, &info);
+                ASSERT_STREQ(info.id, sha256_backend_id(b));
+                ASSERT_EQ(sha256_backend_find(info.id), b);
+                ASSERT_EQ(info.supported, sha256_backend_supported(b));
+                ASSERT_EQ(info.double64_lanes & 2u, 2u) << info.id;
+                ASSERT_EQ(info.midstate_lanes & 2u, 2u) << info.id;
+                ASSERT_GE(info.mb_lanes, 1u) << info.id;
+                ASSERT_LE(info.mb_lanes, (unsigned)SHA256_MB_MAX_LANES) << info.id;
+                if (b == sha256_backend_selected()) {
+                        ASSERT_STREQ(info.name, sha256_auto_detect());
+                }
+                const struct sha256_functions* fns = sha256_backend_functions(b);
+                if (!info.supported) {
+                        ASSERT_EQ(fns, nullptr) << info.id;
+                        continue;
+                }
+                ++supported;
+                ASSERT_NE(fns, nullptr) << info.id;
+
+                /* Split the update so that the buffered path is used too. */
+                struct sha256 h;
+                struct sha256_ctx c = SHA256_INIT;
+                fns->update(&c, data.data(), 100);
+                fns->update(&c, data.data() + 100, data.size() - 100);
+                fns->done(&h, &c);
+                ASSERT_EQ(memcmp(&h, &hash, 32), 0) << info.id;
+
+                for (size_t n = 0; n <= max_blocks; ++n) {
+                        ref->double64(expected, in, n);
+                        fns->double64(out, in, n);
+                        ASSERT_EQ(memcmp(out, expected, 32 * n), 0) << info.id << " n=" << n;
+
+                        ref->midstate(expected, ctx.s, data.data(), n);
+                        fns->midstate(out, ctx.s, data.data(), n);
+                        ASSERT_EQ(memcmp(out, expected, 32 * n), 0) << info.id << " n=" << n;
+
+                        for (size_t t = 0; t < 2; ++t) {
+                                size_t passed = ref->double64_meets_target(expected_bitmap, in, n, &targets[t]);
+                                memset(bitmap, 0xff, sizeof(bitmap));
+                                ASSERT_EQ(fns->double64_meets_target(bitmap, in, n, &targets[t]), passed) << info.id << " n=" << n;
+                                ASSERT_EQ(memcmp(bitmap, expected_bitmap, (n + 7) / 8), 0) << info.id << " n=" << n;
+                        }
+
+                        memset(expected, 0, sizeof(expected));
+                        memset(out, 0, sizeof(out));
+                        size_t passed = ref->check_headers(expected_bitmap, expected, headers.data(), n);
+                        memset(bitmap, 0xff, sizeof(bitmap));
+                        ASSERT_EQ(fns->check_headers(bitmap, out, headers.data(), n), passed) << info.id << " n=" << n;
+                        ASSERT_EQ(memcmp(bitmap, expected_bitmap, (n + 7) / 8), 0) << info.id << " n=" << n;
+                        ASSERT_EQ(memcmp(out, expected, 32 * n), 0) << info.id << " n=" << n;
+                        memset(bitmap, 0xff, sizeof(bitmap));
+                        ASSERT_EQ(fns->check_headers(bitmap, NULL, headers.data(), n), passed) << info.id << " n=" << n;
+                        ASSERT_EQ(memcmp(bitmap, expected_bitmap, (n + 7) / 8), 0) << info.id << " n=" << n;
+                }
+
+                for (size_t count = 0; count <= 2 * max_blocks; ++count) {
+                        std::vector<struct sha256> hashes(in, in + count);
+                        struct sha256 root, expected_root;
+                        ref->merkle_root(&expected_root, hashes.data(), count);
+                        hashes.assign(in, in + count);
+                        fns->merkle_root(&root, hashes.data(), count);
+                        ASSERT_EQ(memcmp(&root, &expected_root, 32), 0) << info.id << " count=" << count;
+                        /* Duplicating the trailing leaf of an odd-length
+                         * list is detected. */
+                        hashes.assign(in, in + count);
+                        if (count > 1 && count & 1) {
+                                hashes.push_back(in[count - 1]);
+                        }
+                        ASSERT_EQ(fns->merkle_root_mutated(&root, hashes.data(), hashes.size()), count > 1 && count & 1) << info.id << " count=" << count;
+                        ASSERT_EQ(memcmp(&root, &expected_root, 32), 0) << info.id << " count=" << count;
+                }
+
+                for (int twice = 0; twice < 2; ++twice) {
+                        for (size_t offset = 0; offset < 64; offset += 12) {
+                                size_t found = ref->grind(expected_nonces, 64, ctx.s, data.data() + 64, offset, 0xffffff00u, 300, &targets[2], twice);
+                                ASSERT_EQ(fns->grind(nonces, 64, ctx.s, data.data() + 64, offset, 0xffffff00u, 300, &targets[2], twice), found) << info.id << " twice=" << twice << " offset=" << offset;
+                                ASSERT_GT(found, 2u);
+                                ASSERT_EQ(memcmp(nonces, expected_nonces, 4 * found), 0) << info.id << " twice=" << twice << " offset=" << offset;
+                        }
+                }
+        }
+        ASSERT_GE(supported, 1u);
+}
+
+TEST(sha2, autotune)
+{
+        /* The choice is measured, cached and read back, and the composed
+         * table agrees with the global entry points. */
+        std::string cache = ::testing::TempDir() + "sha2_autotune_test";
+        std::vector<unsigned char> data(64 * 9);
+        struct sha256 in[18], expected[9], out[9], hash, h;
+        struct sha256_ctx ctx = SHA256_INIT, c = SHA256_INIT;
+        struct sha256_tuning tuning, cached;
+        struct sha256_functions fns;
+
+        std::remove(cache.c_str());
+        ASSERT_EQ(sha256_autotune(&tuning, cache.c_str()), 0);
+        ASSERT_TRUE(sha256_backend_supported(tuning.update));
+        ASSERT_TRUE(sha256_backend_supported(tuning.double64));
+        ASSERT_TRUE(sha256_backend_supported(tuning.midstate));
+        ASSERT_NE(sha256_autotune(&cached, cache.c_str()), 0);
+        ASSERT_EQ(cached.update, tuning.update);
+        ASSERT_EQ(cached.double64, tuning.double64);
+        ASSERT_EQ(cached.midstate, tuning.midstate);
+
+        /* A damaged cache is measured again, and replaced. */
+        FILE* f = fopen(cache.c_str(), "w");
+        ASSERT_NE(f, nullptr);
+        fputs("0123456789abcdef noasm noasm noasm\n", f);
+        fclose(f);
+        ASSERT_EQ(sha256_autotune(&cached, cache.c_str()), 0);
+        ASSERT_NE(sha256_autotune(&cached, cache.c_str()), 0);
+        std::remove(cache.c_str());
+
+        for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = (unsigned char)(i * 23 + 4);
+        }
+        memcpy(in, data.data(), sizeof(in));
+        sha256_tuned_functions(&fns, &tuning);
+        sha256_update(&ctx, data.data(), data.size());
+        sha256_done(&hash, &ctx);
+        fns.update(&c, data.data(), data.size());
+        fns.done(&h, &c);
+        ASSERT_EQ(memcmp(&h, &hash, 32), 0);
+        sha256_double64(expected, in, 9);
+        fns.double64(out, in, 9);
+        ASSERT_EQ(memcmp(out, expected, sizeof(out)), 0);
+        sha256_midstate(expected, ctx.s, data.data(), 9);
+        fns.midstate(out, ctx.s, data.data(), 9);
+        ASSERT_EQ(memcmp(out, expected, sizeof(out)), 0);
+}
+
+/** Hash concurrently from several threads, each of which also asks for the
+ * selected backend, and exit with status zero if they all agree.  This must
+ * be the first use of the library in the process, so that the threads race
+ * to detect the backend. */
+static void hash_from_threads()
+{
+        static const int num_threads = 8;
+        std::vector<unsigned char> data(1000);
+        std::vector<struct sha256> hashes(num_threads);
+        std::vector<const char*> names(num_threads);
+        std::vector<std::thread> threads;
+        struct sha256_ctx ctx = SHA256_INIT;
+        struct sha256 expected;
+
+        for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = (unsigned char)(i * 11 + 1);
+        }
+        for (int i = 0; i < num_threads; ++i) {
+                threads.emplace_back([&, i]() {
+                        struct sha256_ctx ctx = SHA256_INIT;
+                        sha256_update(&ctx, data.data(), data.size());
+                        sha256_done(&hashes[i], &ctx);
+                        names[i] = sha256_auto_detect();
+                });
+        }
+        for (auto& t : threads) {
+                t.join();
+        }
+        sha256_update(&ctx, data.data(), data.size());
+        sha256_done(&expected, &ctx);
+        for (int i = 0; i < num_threads; ++i) {
+                if (memcmp(&hashes[i], &expected, 32) || names[i] != sha256_auto_detect()) {
+                        exit(1);
+                }
+        }
+        exit(0);
+}
+
+TEST(sha2, threads)
+{
+        /* Earlier tests have already detected the backend in this process, so
+         * run the threads in a fresh one.  The threadsafe style re-executes
+         * the test binary rather than forking, and runs only this test. */
+        ::testing::GTEST_FLAG(death_test_style) = "threadsafe";
+        EXPECT_EXIT(hash_from_threads(), ::testing::ExitedWithCode(0), "");
+}
+
 int main(int argc, char **argv)
 {
         ::testing::InitGoogleTest(&argc, argv);
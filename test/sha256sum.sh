@@ -0,0 +1,279 @@
+#!/bin/sh
+# Tests of the sha256sum command-line tool: the output format, the escaping
+# of awkward file names, BSD tags, checking lists of sums, the warnings and
+# exit codes, and the mapped and read paths for input.
+#
+# The program under test is $SHA256SUM, which the makefile sets to the one in
+# the build tree.
+
+: "${SHA256SUM:=../src/sha256sum}"
+
+status=0
+work=sha256sum.dir
+rm -rf "$work"
+mkdir "$work" || exit 99
+cd "$work" || exit 99
+case $SHA256SUM in
+/*) ;;
+*) SHA256SUM=../$SHA256SUM ;;
+esac
+
+EMPTY=e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855
+ABC=ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad
+ZERO100=cd00e292c5970d3c5e2f0ffa5171e555bc46bfc4faddfb4a418b6840b86e79a3
+ZERO3M=bbd05cf6097ac9b1f89ea29d2542c1b7b67ee46848393895f5a9e43fa1f621e5
+
+fail()
+{
+        echo "FAIL: $*" >&2
+        status=1
+}
+
+# run ARGS...: run the program, leaving its output in out, its errors in err
+# and its exit code in rc.
+run()
+{
+        "$SHA256SUM" "$@" >out 2>err
+        rc=$?
+}
+
+# expect_rc NAME CODE: check the exit code of the last run.
+expect_rc()
+{
+        test "$rc" -eq "$2" || fail "$1: exit code $rc, expected $2"
+}
+
+# expect FILE NAME: compare FILE with the expected contents on stdin.
+expect()
+{
+        cat >expected
+        if ! cmp -s expected "$1"; then
+                fail "$2: unexpected $1"
+                diff expected "$1" >&2
+        fi
+}
+
+printf '' >empty
+printf 'abc' >abc
+printf 'abc' >'back\slash'
+printf 'abc' >'new
+line'
+dd if=/dev/zero of=zero100 bs=100 count=1 2>/dev/null
+dd if=/dev/zero of=zero3m bs=1024 count=3072 2>/dev/null
+
+# Output format.
+run abc empty
+expect_rc "format" 0
+expect out "format" <<EOF
+$ABC  abc
+$EMPTY  empty
+EOF
+expect err "format" </dev/null
+
+run -b abc
+expect_rc "binary" 0
+expect out "binary" <<EOF
+$ABC *abc
+EOF
+
+run --tag abc
+expect_rc "tag" 0
+expect out "tag" <<EOF
+SHA256 (abc) = $ABC
+EOF
+
+# Names with backslashes and line breaks are escaped, and the line marked
+# with a leading backslash.
+run 'back\slash' 'new
+line'
+expect_rc "escape" 0
+expect out "escape" <<EOF
+\\$ABC  back\\\\slash
+\\$ABC  new\\nline
+EOF
+
+run --tag 'back\slash'
+expect_rc "escape tag" 0
+expect out "escape tag" <<EOF
+\\SHA256 (back\\\\slash) = $ABC
+EOF
+
+# Standard input, from a pipe (read) and from a regular file (mapped).
+printf 'abc' | "$SHA256SUM" >out 2>err
+expect out "pipe" <<EOF
+$ABC  -
+EOF
+run - <abc
+expect out "redirect" <<EOF
+$ABC  -
+EOF
+
+# Files longer than the read buffer, read from a pipe and mapped.
+cat zero3m | "$SHA256SUM" >out 2>err
+expect out "large pipe" <<EOF
+$ZERO3M  -
+EOF
+run zero3m zero100
+expect out "large file" <<EOF
+$ZERO3M  zero3m
+$ZERO100  zero100
+EOF
+
+run nope abc
+expect_rc "missing" 1
+expect out "missing" <<EOF
+$ABC  abc
+EOF
+grep -q '^sha256sum: nope: ' err || fail "missing: no error for nope"
+
+# Checking: every format written above reads back.
+"$SHA256SUM" abc empty zero3m >list
+"$SHA256SUM" -b zero100 >>list
+"$SHA256SUM" 'back\slash' 'new
+line' >>list
+"$SHA256SUM" --tag abc 'back\slash' >>list
+run -c list
+expect_rc "check" 0
+expect out "check" <<EOF
+abc: OK
+empty: OK
+zero3m: OK
+zero100: OK
+\\back\\\\slash: OK
+\\new\\nline: OK
+abc: OK
+\\back\\\\slash: OK
+EOF
+expect err "check" </dev/null
+
+run -c - <list
+expect_rc "check stdin" 0
+
+run -c --quiet list
+expect_rc "quiet" 0
+expect out "quiet" </dev/null
+
+# A mismatch.
+sed "s/^$ABC  abc/$EMPTY  abc/" list >bad
+run -c --quiet bad
+expect_rc "mismatch" 1
+expect out "mismatch" <<EOF
+abc: FAILED
+EOF
+expect err "mismatch" <<EOF
+sha256sum: WARNING: 1 computed checksum did NOT match
+EOF
+
+run -c --status bad
+expect_rc "status" 1
+expect out "status" </dev/null
+expect err "status" </dev/null
+
+# The per-file results come before the summary when both go to one pipe.
+"$SHA256SUM" -c bad 2>&1 | tail -n 1 >out
+expect out "summary order" <<EOF
+sha256sum: WARNING: 1 computed checksum did NOT match
+EOF
+
+# Missing files, with and without --ignore-missing.
+{ echo "$ABC  abc"; echo "$ABC  nope"; } >missing
+run -c missing
+expect_rc "check missing" 1
+expect out "check missing" <<EOF
+abc: OK
+nope: FAILED open or read
+EOF
+grep -q '^sha256sum: nope: ' err || fail "check missing: no error for nope"
+grep -q '^sha256sum: WARNING: 1 listed file could not be read$' err || fail "check missing: no warning"
+
+run -c --ignore-missing missing
+expect_rc "ignore missing" 0
+expect out "ignore missing" <<EOF
+abc: OK
+EOF
+expect err "ignore missing" </dev/null
+
+echo "$ABC  nope" >allmissing
+run -c --ignore-missing allmissing
+expect_rc "all missing" 1
+expect out "all missing" </dev/null
+expect err "all missing" <<EOF
+sha256sum: allmissing: no file was verified
+EOF
+
+# Improperly formatted lines are skipped, warned about with --warn, and fail
+# the check only with --strict.
+{ echo "$ABC  abc"; echo "not a checksum"; echo "# a comment"; echo "$ABC"; } >malformed
+run -c malformed
+expect_rc "malformed" 0
+expect out "malformed" <<EOF
+abc: OK
+EOF
+expect err "malformed" <<EOF
+sha256sum: WARNING: 2 lines are improperly formatted
+EOF
+
+run -c -w malformed
+expect_rc "warn" 0
+expect err "warn" <<EOF
+sha256sum: malformed: 2: improperly formatted SHA256 checksum line
+sha256sum: malformed: 4: improperly formatted SHA256 checksum line
+sha256sum: WARNING: 2 lines are improperly formatted
+EOF
+
+run -c --strict malformed
+expect_rc "strict" 1
+
+echo "not a checksum" >nolines
+run -c nolines
+expect_rc "no lines" 1
+expect err "no lines" <<EOF
+sha256sum: nolines: no properly formatted SHA256 checksum lines found
+EOF
+
+run -c nope
+expect_rc "no list" 1
+
+# With --jobs the files are hashed out of order, by several threads and in
+# the lanes of the multi-buffer manager, but the results must come out just
+# as they do from one job: small files, files too large for the lanes,
+# missing files and standard input, interleaved.
+names=
+i=0
+while test $i -lt 200; do
+        printf "%0$((i * 7 + 1))d" $i >small$i
+        names="$names small$i"
+        case $i in
+        50) names="$names zero3m" ;;
+        90) names="$names nope1 -" ;;
+        120) names="$names abc nope2 empty" ;;
+        170) names="$names zero3m" ;;
+        esac
+        i=$((i + 1))
+done
+# shellcheck disable=SC2086
+printf 'abc' | "$SHA256SUM" -j 1 $names >serial 2>serial.err
+for j in 2 4 0; do
+        # shellcheck disable=SC2086
+        printf 'abc' | "$SHA256SUM" -j $j $names >out 2>err
+        rc=$?
+        expect_rc "jobs $j" 1
+        cmp -s serial out || fail "jobs $j: output differs from -j 1"
+        cmp -s serial.err err || fail "jobs $j: errors differ from -j 1"
+done
+grep -q "^$ABC  -\$" serial || fail "jobs: no hash for standard input"
+
+# Standard input was read up above, so leave it out of the list.
+grep -v '  -$' serial >list
+rm -f small77
+"$SHA256SUM" -c list >serial 2>serial.err
+for j in 1 4 0; do
+        run -c -j $j list
+        expect_rc "check jobs $j" 1
+        cmp -s serial out || fail "check jobs $j: output differs from one job"
+        cmp -s serial.err err || fail "check jobs $j: errors differ from one job"
+done
+
+cd ..
+test $status -ne 0 || rm -rf "$work"
+exit $status